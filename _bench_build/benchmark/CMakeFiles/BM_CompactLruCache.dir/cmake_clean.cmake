@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/benchmarks/BM_CompactLruCache"
+  "../bin/benchmarks/BM_CompactLruCache.pdb"
+  "CMakeFiles/BM_CompactLruCache.dir/BM_CompactLruCache.cpp.o"
+  "CMakeFiles/BM_CompactLruCache.dir/BM_CompactLruCache.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BM_CompactLruCache.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/benchmarks/BM_LruCache"
+  "../bin/benchmarks/BM_LruCache.pdb"
+  "CMakeFiles/BM_LruCache.dir/BM_LruCache.cpp.o"
+  "CMakeFiles/BM_LruCache.dir/BM_LruCache.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BM_LruCache.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/benchmarks/BM_ShardedLruCache"
+  "../bin/benchmarks/BM_ShardedLruCache.pdb"
+  "CMakeFiles/BM_ShardedLruCache.dir/BM_ShardedLruCache.cpp.o"
+  "CMakeFiles/BM_ShardedLruCache.dir/BM_ShardedLruCache.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BM_ShardedLruCache.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
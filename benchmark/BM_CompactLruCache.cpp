@@ -0,0 +1,155 @@
+/**
+ * @file BM_CompactLruCache.cpp
+ * @brief Benchmark memory footprint and lookups of CompactLruCache against LruCache
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+#include <nfx/memory/CompactLruCache.h>
+#include <nfx/memory/LruCache.h>
+
+//=====================================================================
+// Allocation tracking
+//=====================================================================
+
+namespace
+{
+	/** @brief Bytes currently allocated through the global operator new */
+	std::atomic<std::int64_t> g_liveBytes{ 0 };
+
+	/** @brief Header in front of every allocation, keeps the default new alignment */
+	constexpr std::size_t ALLOCATION_HEADER{ __STDCPP_DEFAULT_NEW_ALIGNMENT__ };
+} // namespace
+
+void* operator new( std::size_t size )
+{
+	auto* block{ static_cast<std::byte*>( std::malloc( size + ALLOCATION_HEADER ) ) };
+	if ( block == nullptr )
+	{
+		throw std::bad_alloc{};
+	}
+
+	*reinterpret_cast<std::size_t*>( block ) = size;
+	g_liveBytes.fetch_add( static_cast<std::int64_t>( size ), std::memory_order_relaxed );
+
+	return block + ALLOCATION_HEADER;
+}
+
+void operator delete( void* pointer ) noexcept
+{
+	if ( pointer == nullptr )
+	{
+		return;
+	}
+
+	auto* block{ static_cast<std::byte*>( pointer ) - ALLOCATION_HEADER };
+	g_liveBytes.fetch_sub( static_cast<std::int64_t>( *reinterpret_cast<std::size_t*>( block ) ), std::memory_order_relaxed );
+	std::free( block );
+}
+
+void operator delete( void* pointer, std::size_t ) noexcept
+{
+	::operator delete( pointer );
+}
+
+namespace nfx::memory::benchmark
+{
+	//=====================================================================
+	// CompactLruCache benchmark suite
+	//=====================================================================
+
+	using Key = std::uint64_t;
+	using Value = std::uint64_t;
+
+	using NodeCache = LruCache<Key, Value>;
+	using FlatCache = LruCache<Key, Value, std::hash<Key>, std::equal_to<Key>, FlatStorage>;
+	using CompactCache = CompactLruCache<Key, Value>;
+
+	//----------------------------------------------
+	// Memory footprint
+	//----------------------------------------------
+
+	/**
+	 * @brief Fill a cache and report the heap bytes it holds per entry
+	 * @details Counts requested bytes only, allocator bookkeeping comes on top for every
+	 *          allocation, which penalizes node-based storage further.
+	 */
+	template <typename TCache>
+	static void BM_BytesPerEntry( ::benchmark::State& state )
+	{
+		const auto entries{ static_cast<Key>( state.range( 0 ) ) };
+		double bytesPerEntry{ 0.0 };
+
+		for ( auto _ : state )
+		{
+			const auto before{ g_liveBytes.load( std::memory_order_relaxed ) };
+			{
+				TCache cache{ LruCacheOptions{ static_cast<std::size_t>( entries ) } };
+				for ( Key i = 0; i < entries; ++i )
+				{
+					cache.getOrCreate( i, [i]() { return i; } );
+				}
+
+				bytesPerEntry = static_cast<double>( g_liveBytes.load( std::memory_order_relaxed ) - before ) / static_cast<double>( entries );
+				::benchmark::DoNotOptimize( cache.size() );
+			}
+		}
+
+		state.counters["bytes_per_entry"] = bytesPerEntry;
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+
+	//----------------------------------------------
+	// Lookup
+	//----------------------------------------------
+
+	template <typename TCache>
+	static void BM_TryGet_Hit( ::benchmark::State& state )
+	{
+		const auto entries{ static_cast<Key>( state.range( 0 ) ) };
+		TCache cache{ LruCacheOptions{ static_cast<std::size_t>( entries ) } };
+
+		for ( Key i = 0; i < entries; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		Key key{ 0 };
+		for ( auto _ : state )
+		{
+			auto result = cache.tryGet( key );
+			::benchmark::DoNotOptimize( result );
+			key = ( key + 7919 ) % entries;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	//=====================================================================
+	// Benchmarks registration
+	//=====================================================================
+
+	//----------------------------------------------
+	// Memory footprint
+	//----------------------------------------------
+
+	BENCHMARK_TEMPLATE( BM_BytesPerEntry, NodeCache )->Arg( 1 << 20 )->Unit( ::benchmark::kMillisecond );
+	BENCHMARK_TEMPLATE( BM_BytesPerEntry, FlatCache )->Arg( 1 << 20 )->Unit( ::benchmark::kMillisecond );
+	BENCHMARK_TEMPLATE( BM_BytesPerEntry, CompactCache )->Arg( 1 << 20 )->Unit( ::benchmark::kMillisecond );
+
+	//----------------------------------------------
+	// Lookup
+	//----------------------------------------------
+
+	BENCHMARK_TEMPLATE( BM_TryGet_Hit, NodeCache )->Arg( 1 << 10 )->Arg( 1 << 20 );
+	BENCHMARK_TEMPLATE( BM_TryGet_Hit, CompactCache )->Arg( 1 << 10 )->Arg( 1 << 20 );
+} // namespace nfx::memory::benchmark
+
+BENCHMARK_MAIN();
@@ -5,10 +5,17 @@
 
 #include <benchmark/benchmark.h>
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <nfx/memory/LruCache.h>
+#include <nfx/memory/SlabAllocator.h>
 
 namespace nfx::memory::benchmark
 {
@@ -71,6 +78,42 @@ namespace nfx::memory::benchmark
 		state.SetItemsProcessed( state.iterations() );
 	}
 
+	static void BM_LruCache_GetOrCreate_ExistingEntry_Capturing( ::benchmark::State& state )
+	{
+		LruCache<int, std::string> cache;
+		cache.getOrCreate( 42, []() { return std::string{ "cached_value" }; } );
+
+		// Captures larger than the std::function small buffer
+		const std::string prefix{ "value_prefix" };
+		const std::string suffix{ "value_suffix" };
+
+		for ( auto _ : state )
+		{
+			auto& value = cache.getOrCreate( 42, [prefix, suffix]() { return prefix + suffix; } );
+			::benchmark::DoNotOptimize( value );
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	static void BM_LruCache_GetOrCreate_ExistingEntry_StdFunction( ::benchmark::State& state )
+	{
+		LruCache<int, std::string> cache;
+		cache.getOrCreate( 42, []() { return std::string{ "cached_value" }; } );
+
+		const std::string prefix{ "value_prefix" };
+		const std::string suffix{ "value_suffix" };
+
+		for ( auto _ : state )
+		{
+			// Type-erased factory as accepted by previous releases
+			auto& value = cache.getOrCreate( 42, LruCache<int, std::string>::FactoryFunction{ [prefix, suffix]() { return prefix + suffix; } } );
+			::benchmark::DoNotOptimize( value );
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+	}
+
 	static void BM_LruCache_GetOrCreate_WithConfig( ::benchmark::State& state )
 	{
 		LruCache<int, std::string> cache;
@@ -116,6 +159,181 @@ namespace nfx::memory::benchmark
 		state.SetItemsProcessed( state.iterations() );
 	}
 
+	template <typename TStorage>
+	static void BM_LruCache_TryGet_Hit_Storage( ::benchmark::State& state )
+	{
+		using Cache = LruCache<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>, TStorage>;
+
+		const auto entries{ static_cast<std::uint64_t>( state.range( 0 ) ) };
+		Cache cache{ LruCacheOptions{ static_cast<std::size_t>( entries ) } };
+
+		for ( std::uint64_t i = 0; i < entries; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		// Stride through the key space so consecutive lookups miss the CPU caches
+		std::uint64_t key{ 0 };
+		for ( auto _ : state )
+		{
+			auto result = cache.tryGet( key );
+			::benchmark::DoNotOptimize( result );
+			key = ( key + 7919 ) % entries;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	static void BM_LruCache_TryGet_Hit_ClockResolution( ::benchmark::State& state )
+	{
+		// Arg 0 reads the steady clock on every lookup, otherwise a shared coarse clock
+		LruCache<int, int> cache{ LruCacheOptions{}.withClockResolution( std::chrono::milliseconds{ state.range( 0 ) } ) };
+
+		for ( int i = 0; i < 1000; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		int key{ 0 };
+		for ( auto _ : state )
+		{
+			auto result = cache.tryGet( key % 1000 );
+			::benchmark::DoNotOptimize( result );
+			key++;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	static void BM_LruCache_TryGet_Hit_ReadBuffered( ::benchmark::State& state )
+	{
+		static LruCache<int, std::string>* cache{ nullptr };
+
+		if ( state.thread_index() == 0 )
+		{
+			cache = new LruCache<int, std::string>{ LruCacheOptions{}.withReadBuffering( true ) };
+			for ( int i = 0; i < 1000; ++i )
+			{
+				cache->getOrCreate( i, [i]() { return std::string{ "value_" + std::to_string( i ) }; } );
+			}
+		}
+
+		int key{ state.thread_index() * 97 };
+		for ( auto _ : state )
+		{
+			auto result = cache->tryGet( key % 1000 );
+			::benchmark::DoNotOptimize( result );
+			key++;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+
+		if ( state.thread_index() == 0 )
+		{
+			delete cache;
+			cache = nullptr;
+		}
+	}
+
+	static void BM_LruCache_TryGet_Hit_Clock( ::benchmark::State& state )
+	{
+		using ClockCache = LruCache<int, std::string, std::hash<int>, std::equal_to<int>, NodeStorage,
+			std::allocator<std::pair<const int, std::string>>, ClockPolicy>;
+
+		static ClockCache* cache{ nullptr };
+
+		// Hits set a reference bit under the shared lock, no read buffer involved
+		if ( state.thread_index() == 0 )
+		{
+			cache = new ClockCache{ LruCacheOptions{} };
+			for ( int i = 0; i < 1000; ++i )
+			{
+				cache->getOrCreate( i, [i]() { return std::string{ "value_" + std::to_string( i ) }; } );
+			}
+		}
+
+		int key{ state.thread_index() * 97 };
+		for ( auto _ : state )
+		{
+			auto result = cache->tryGet( key % 1000 );
+			::benchmark::DoNotOptimize( result );
+			key++;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+
+		if ( state.thread_index() == 0 )
+		{
+			delete cache;
+			cache = nullptr;
+		}
+	}
+
+	static void BM_LruCache_TryGetMany( ::benchmark::State& state )
+	{
+		LruCache<int, int> cache;
+		for ( int i = 0; i < 1000; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		// Fan-out request: one lock hold and one clock read for the whole batch
+		const auto batchSize{ static_cast<std::size_t>( state.range( 0 ) ) };
+		std::vector<int> keys( batchSize );
+		std::vector<std::optional<std::reference_wrapper<int>>> values( batchSize );
+
+		int next{ 0 };
+		for ( auto _ : state )
+		{
+			for ( auto& key : keys )
+			{
+				key = next++ % 1000;
+			}
+
+			auto hits = cache.tryGetMany( keys, values );
+			::benchmark::DoNotOptimize( hits );
+		}
+
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+
+	static void BM_LruCache_TryGetMany_BeyondLlc( ::benchmark::State& state )
+	{
+		using FlatCache = LruCache<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>, FlatStorage>;
+
+		// Built once for every batch size: about a gigabyte, far beyond the last level cache
+		constexpr std::uint64_t entries{ std::uint64_t{ 1 } << 23 };
+		static const auto cache{ [] {
+			auto populated{ std::make_unique<FlatCache>( LruCacheOptions{ static_cast<std::size_t>( entries ) } ) };
+			for ( std::uint64_t i = 0; i < entries; ++i )
+			{
+				populated->getOrCreate( i, [i]() { return i; } );
+			}
+
+			return populated;
+		}() };
+
+		const auto batchSize{ static_cast<std::size_t>( state.range( 0 ) ) };
+		std::vector<std::uint64_t> keys( batchSize );
+		std::vector<std::optional<std::reference_wrapper<std::uint64_t>>> values( batchSize );
+
+		// Large stride through the key space, so every probe misses the CPU caches
+		std::uint64_t next{ 0 };
+		for ( auto _ : state )
+		{
+			for ( auto& key : keys )
+			{
+				key = next;
+				next = ( next + 2654435761ULL ) % entries;
+			}
+
+			auto hits = cache->tryGetMany( keys, values );
+			::benchmark::DoNotOptimize( hits );
+		}
+
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+
 	static void BM_LruCache_TryGet_Miss( ::benchmark::State& state )
 	{
 		LruCache<int, std::string> cache;
@@ -241,6 +459,52 @@ namespace nfx::memory::benchmark
 		state.SetItemsProcessed( state.iterations() );
 	}
 
+	/**
+	 * @brief Steady-state churn: every insertion into a full cache evicts one entry
+	 * @tparam TCache Cache type, differing only by allocator
+	 */
+	template <typename TCache>
+	static void BM_LruCache_Eviction_Churn( ::benchmark::State& state, TCache& cache )
+	{
+		const std::uint64_t cacheSize{ 10000 };
+		for ( std::uint64_t i = 0; i < cacheSize; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		std::uint64_t key{ cacheSize };
+		for ( auto _ : state )
+		{
+			auto& value = cache.getOrCreate( key, [key]() { return key; } );
+			::benchmark::DoNotOptimize( value );
+			++key;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	static void BM_LruCache_Eviction_Churn_StdAllocator( ::benchmark::State& state )
+	{
+		LruCache<std::uint64_t, std::uint64_t> cache{ LruCacheOptions{ 10000 } };
+		BM_LruCache_Eviction_Churn( state, cache );
+	}
+
+	static void BM_LruCache_Eviction_Churn_SlabAllocator( ::benchmark::State& state )
+	{
+		using Allocator = SlabAllocator<std::pair<const std::uint64_t, std::uint64_t>>;
+
+		LruCache<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>, NodeStorage, Allocator> cache{ LruCacheOptions{ 10000 } };
+		BM_LruCache_Eviction_Churn( state, cache );
+	}
+
+	static void BM_LruCache_Eviction_Churn_PmrPool( ::benchmark::State& state )
+	{
+		std::pmr::unsynchronized_pool_resource resource;
+
+		pmr::LruCache<std::uint64_t, std::uint64_t> cache{ LruCacheOptions{ 10000 }, &resource };
+		BM_LruCache_Eviction_Churn( state, cache );
+	}
+
 	static void BM_LruCache_LRU_Access_Pattern( ::benchmark::State& state )
 	{
 		const int cacheSize = 100;
@@ -265,6 +529,99 @@ namespace nfx::memory::benchmark
 		state.SetItemsProcessed( state.iterations() * accessCount );
 	}
 
+	/**
+	 * @brief Hit ratio on a skewed workload where a quarter of the requests come from a scan
+	 * @tparam TPolicy Eviction policy of the cache
+	 */
+	template <template <typename> typename TPolicy>
+	static void BM_LruCache_HitRatio_ScanMix( ::benchmark::State& state )
+	{
+		LruCache<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>, NodeStorage,
+			std::allocator<std::pair<const std::uint64_t, std::uint64_t>>, TPolicy>
+			cache{ LruCacheOptions{ 1000 } };
+
+		std::uint64_t random{ 88172645463325252ULL };
+		std::uint64_t scanKey{ 1ULL << 32 };
+		std::uint64_t hits{ 0 };
+		std::uint64_t lookups{ 0 };
+
+		for ( auto _ : state )
+		{
+			for ( int i = 0; i < 1000; ++i )
+			{
+				std::uint64_t key{ scanKey };
+				if ( i % 4 == 3 )
+				{
+					// Keys seen once, like a batch job crawling the whole catalog
+					++scanKey;
+				}
+				else
+				{
+					random ^= random << 13;
+					random ^= random >> 7;
+					random ^= random << 17;
+
+					// Squares of uniform values favour the low keys
+					const auto uniform{ random % 2048 };
+					key = ( uniform * uniform ) >> 11;
+				}
+
+				bool hit{ true };
+				auto& value = cache.getOrCreate( key, [&hit, key]() {
+					hit = false;
+					return key;
+				} );
+				::benchmark::DoNotOptimize( value );
+
+				hits += hit ? 1 : 0;
+				++lookups;
+			}
+		}
+
+		state.counters["hitRatio"] = static_cast<double>( hits ) / static_cast<double>( lookups );
+		state.SetItemsProcessed( static_cast<std::int64_t>( lookups ) );
+	}
+
+	static void BM_LruCache_HitRatio_ScanMix_Lru( ::benchmark::State& state )
+	{
+		BM_LruCache_HitRatio_ScanMix<LruPolicy>( state );
+	}
+
+	static void BM_LruCache_HitRatio_ScanMix_Slru( ::benchmark::State& state )
+	{
+		BM_LruCache_HitRatio_ScanMix<SlruPolicy>( state );
+	}
+
+	static void BM_LruCache_HitRatio_ScanMix_TwoQueue( ::benchmark::State& state )
+	{
+		BM_LruCache_HitRatio_ScanMix<TwoQueuePolicy>( state );
+	}
+
+	static void BM_LruCache_HitRatio_ScanMix_Arc( ::benchmark::State& state )
+	{
+		BM_LruCache_HitRatio_ScanMix<ArcPolicy>( state );
+	}
+
+	static void BM_LruCache_HitRatio_ScanMix_WTinyLfu( ::benchmark::State& state )
+	{
+		BM_LruCache_HitRatio_ScanMix<WTinyLfuPolicy>( state );
+	}
+
+	static void BM_LruCache_HitRatio_ScanMix_Clock( ::benchmark::State& state )
+	{
+		BM_LruCache_HitRatio_ScanMix<ClockPolicy>( state );
+	}
+
+	static void BM_LruCache_HitRatio_ScanMix_ClockPro( ::benchmark::State& state )
+	{
+		BM_LruCache_HitRatio_ScanMix<ClockProPolicy>( state );
+	}
+
+	static void BM_LruCache_HitRatio_ScanMix_S3Fifo( ::benchmark::State& state )
+	{
+		BM_LruCache_HitRatio_ScanMix<S3FifoPolicy>( state );
+	}
+
 	//----------------------------------------------
 	// Expiration
 	//----------------------------------------------
@@ -294,6 +651,59 @@ namespace nfx::memory::benchmark
 		state.SetItemsProcessed( state.iterations() * numExpiredEntries );
 	}
 
+	static void BM_LruCache_CleanupExpired_FewDue( ::benchmark::State& state )
+	{
+		// Many live entries, a handful with short per-entry expirations
+		const auto liveEntries{ static_cast<int>( state.range( 0 ) ) };
+		constexpr int dueEntries{ 100 };
+
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::hours( 1 ) } };
+		for ( int i = 0; i < liveEntries; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		for ( auto _ : state )
+		{
+			state.PauseTiming();
+			for ( int i = 0; i < dueEntries; ++i )
+			{
+				cache.getOrCreate( -1 - i, [i]() { return i; }, []( CacheEntry& entry ) { entry.slidingExpiration = std::chrono::milliseconds( -1 ); } );
+			}
+			state.ResumeTiming();
+
+			cache.cleanupExpired();
+		}
+
+		state.SetItemsProcessed( state.iterations() * dueEntries );
+	}
+
+	static void BM_LruCache_TryGet_Hit_BackgroundCleanup( ::benchmark::State& state )
+	{
+		// Every operation is past the 1 ms cleanup interval, nothing ever expires
+		const auto entries{ static_cast<int>( state.range( 0 ) ) };
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::hours( 1 ), std::chrono::milliseconds( 1 ) } };
+
+		for ( int i = 0; i < entries; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		int key{ 0 };
+		for ( auto _ : state )
+		{
+			state.PauseTiming();
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+			state.ResumeTiming();
+
+			auto result = cache.tryGet( key % entries );
+			::benchmark::DoNotOptimize( result );
+			key++;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+	}
+
 	//----------------------------------------------
 	// Complex value types
 	//----------------------------------------------
@@ -409,6 +819,8 @@ namespace nfx::memory::benchmark
 
 	BENCHMARK( BM_LruCache_GetOrCreate_NewEntry );
 	BENCHMARK( BM_LruCache_GetOrCreate_ExistingEntry );
+	BENCHMARK( BM_LruCache_GetOrCreate_ExistingEntry_Capturing );
+	BENCHMARK( BM_LruCache_GetOrCreate_ExistingEntry_StdFunction );
 	BENCHMARK( BM_LruCache_GetOrCreate_WithConfig );
 
 	//----------------------------------------------
@@ -416,6 +828,13 @@ namespace nfx::memory::benchmark
 	//----------------------------------------------
 
 	BENCHMARK( BM_LruCache_TryGet_Hit );
+	BENCHMARK_TEMPLATE( BM_LruCache_TryGet_Hit_Storage, NodeStorage )->Arg( 1 << 10 )->Arg( 1 << 20 );
+	BENCHMARK_TEMPLATE( BM_LruCache_TryGet_Hit_Storage, FlatStorage )->Arg( 1 << 10 )->Arg( 1 << 20 );
+	BENCHMARK( BM_LruCache_TryGet_Hit_ClockResolution )->Arg( 0 )->Arg( 5 );
+	BENCHMARK( BM_LruCache_TryGet_Hit_ReadBuffered )->ThreadRange( 1, 16 )->UseRealTime();
+	BENCHMARK( BM_LruCache_TryGet_Hit_Clock )->ThreadRange( 1, 16 )->UseRealTime();
+	BENCHMARK( BM_LruCache_TryGetMany )->Arg( 50 )->Arg( 200 );
+	BENCHMARK( BM_LruCache_TryGetMany_BeyondLlc )->Arg( 1 )->Arg( 8 )->Arg( 64 );
 	BENCHMARK( BM_LruCache_TryGet_Miss );
 
 	//----------------------------------------------
@@ -442,6 +861,17 @@ namespace nfx::memory::benchmark
 
 	BENCHMARK( BM_LruCache_LRU_Eviction );
 	BENCHMARK( BM_LruCache_LRU_Access_Pattern );
+	BENCHMARK( BM_LruCache_Eviction_Churn_StdAllocator );
+	BENCHMARK( BM_LruCache_Eviction_Churn_SlabAllocator );
+	BENCHMARK( BM_LruCache_Eviction_Churn_PmrPool );
+	BENCHMARK( BM_LruCache_HitRatio_ScanMix_Lru );
+	BENCHMARK( BM_LruCache_HitRatio_ScanMix_Slru );
+	BENCHMARK( BM_LruCache_HitRatio_ScanMix_TwoQueue );
+	BENCHMARK( BM_LruCache_HitRatio_ScanMix_Arc );
+	BENCHMARK( BM_LruCache_HitRatio_ScanMix_WTinyLfu );
+	BENCHMARK( BM_LruCache_HitRatio_ScanMix_Clock );
+	BENCHMARK( BM_LruCache_HitRatio_ScanMix_ClockPro );
+	BENCHMARK( BM_LruCache_HitRatio_ScanMix_S3Fifo );
 
 	//----------------------------------------------
 	// Expiration
@@ -451,6 +881,13 @@ namespace nfx::memory::benchmark
 		->Arg( 10 )
 		->Arg( 100 )
 		->Arg( 1000 );
+	BENCHMARK( BM_LruCache_CleanupExpired_FewDue )
+		->Arg( 1 << 12 )
+		->Arg( 1 << 20 );
+	BENCHMARK( BM_LruCache_TryGet_Hit_BackgroundCleanup )
+		->Arg( 1 << 12 )
+		->Arg( 1 << 20 )
+		->Iterations( 500 );
 
 	//----------------------------------------------
 	// Complex value types
@@ -0,0 +1,134 @@
+/**
+ * @file BM_ShardedLruCache.cpp
+ * @brief Benchmark ShardedLruCache scalability against a single-lock LruCache
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <nfx/memory/LruCache.h>
+#include <nfx/memory/ShardedLruCache.h>
+
+namespace nfx::memory::benchmark
+{
+	//=====================================================================
+	// ShardedLruCache benchmark suite
+	//=====================================================================
+
+	static constexpr int NUM_KEYS = 10000;
+
+	//----------------------------------------------
+	// Multi-threaded hits
+	//----------------------------------------------
+
+	static void BM_LruCache_TryGet_Hit_Threaded( ::benchmark::State& state )
+	{
+		static LruCache<int, std::string>* cache{ nullptr };
+
+		if ( state.thread_index() == 0 )
+		{
+			cache = new LruCache<int, std::string>{};
+			for ( int i = 0; i < NUM_KEYS; ++i )
+			{
+				cache->getOrCreate( i, [i]() { return std::string{ "value_" + std::to_string( i ) }; } );
+			}
+		}
+
+		int key{ state.thread_index() * 7919 };
+		for ( auto _ : state )
+		{
+			auto result = cache->tryGet( key % NUM_KEYS );
+			::benchmark::DoNotOptimize( result );
+			key++;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+
+		if ( state.thread_index() == 0 )
+		{
+			delete cache;
+			cache = nullptr;
+		}
+	}
+
+	static void BM_ShardedLruCache_TryGet_Hit_Threaded( ::benchmark::State& state )
+	{
+		static ShardedLruCache<int, std::string>* cache{ nullptr };
+
+		if ( state.thread_index() == 0 )
+		{
+			cache = new ShardedLruCache<int, std::string>{};
+			for ( int i = 0; i < NUM_KEYS; ++i )
+			{
+				cache->getOrCreate( i, [i]() { return std::string{ "value_" + std::to_string( i ) }; } );
+			}
+		}
+
+		int key{ state.thread_index() * 7919 };
+		for ( auto _ : state )
+		{
+			auto result = cache->tryGet( key % NUM_KEYS );
+			::benchmark::DoNotOptimize( result );
+			key++;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+
+		if ( state.thread_index() == 0 )
+		{
+			delete cache;
+			cache = nullptr;
+		}
+	}
+
+	//----------------------------------------------
+	// Multi-threaded mixed workload
+	//----------------------------------------------
+
+	static void BM_ShardedLruCache_GetOrCreate_Bounded_Threaded( ::benchmark::State& state )
+	{
+		static ShardedLruCache<int, std::string>* cache{ nullptr };
+
+		if ( state.thread_index() == 0 )
+		{
+			cache = new ShardedLruCache<int, std::string>{ LruCacheOptions{ NUM_KEYS / 2 } };
+		}
+
+		int key{ state.thread_index() * 7919 };
+		for ( auto _ : state )
+		{
+			int k{ key % NUM_KEYS };
+			auto& value = cache->getOrCreate( k, [k]() { return std::string{ "value_" + std::to_string( k ) }; } );
+			::benchmark::DoNotOptimize( value );
+			key++;
+		}
+
+		state.SetItemsProcessed( state.iterations() );
+
+		if ( state.thread_index() == 0 )
+		{
+			delete cache;
+			cache = nullptr;
+		}
+	}
+
+	//=====================================================================
+	// Benchmarks registration
+	//=====================================================================
+
+	//----------------------------------------------
+	// Multi-threaded hits
+	//----------------------------------------------
+
+	BENCHMARK( BM_LruCache_TryGet_Hit_Threaded )->ThreadRange( 1, 16 )->UseRealTime();
+	BENCHMARK( BM_ShardedLruCache_TryGet_Hit_Threaded )->ThreadRange( 1, 16 )->UseRealTime();
+
+	//----------------------------------------------
+	// Multi-threaded mixed workload
+	//----------------------------------------------
+
+	BENCHMARK( BM_ShardedLruCache_GetOrCreate_Bounded_Threaded )->ThreadRange( 1, 16 )->UseRealTime();
+} // namespace nfx::memory::benchmark
+
+BENCHMARK_MAIN();
@@ -9,9 +9,33 @@
 set(PUBLIC_HEADERS)
 
 list(APPEND PUBLIC_HEADERS
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/AsyncLruCache.h
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/CacheTask.h
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/CoarseClock.h
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/CompactLruCache.h
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/EvictionPolicy.h
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/FlatHashMap.h
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/FrequencySketch.h
 	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/LruCache.h
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/LruCacheStatistics.h
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/MaintenanceThread.h
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/ShardedLruCache.h
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/SlabAllocator.h
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/memory/TimerWheel.h
 
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/AsyncLruCache.inl
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/CacheTask.inl
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/CoarseClock.inl
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/CompactLruCache.inl
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/EvictionPolicy.inl
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/FlatHashMap.inl
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/FrequencySketch.inl
 	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/LruCache.inl
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/LruCacheStatistics.inl
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/MaintenanceThread.inl
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/ShardedLruCache.inl
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/SlabAllocator.inl
+	${NFX_LRUCACHE_INCLUDE_DIR}/nfx/detail/memory/TimerWheel.inl
 )
 
 #----------------------------------------------
@@ -0,0 +1,184 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file AsyncLruCache.inl
+ * @brief Implementation of AsyncLruCache
+ * @details Futures cached on a miss, factories submitted to the executor after insertion
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// AsyncLruCache
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline AsyncLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::AsyncLruCache( const LruCacheOptions& options, Executor executor )
+		: m_cache{ std::make_shared<Cache>( checkOptions( options ) ) },
+		  m_executor{ std::move( executor ) }
+	{
+		if ( !m_executor )
+		{
+			throw std::invalid_argument{ "AsyncLruCache: executor is empty" };
+		}
+	}
+
+	//----------------------------------------------
+	// Cache operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure>
+		requires std::copy_constructible<std::decay_t<TFactory>>
+	inline typename AsyncLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::Future AsyncLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::getOrCreateAsync(
+		const TKey& key, TFactory&& factory, TConfigure&& configure )
+	{
+		std::shared_ptr<std::promise<TValue>> promise;
+
+		// Only caches the future, concurrent misses wait for this call instead of the factory
+		auto makeFuture{ [&promise]() {
+			promise = std::make_shared<std::promise<TValue>>();
+			return promise->get_future().share();
+		} };
+
+		// Copied under the cache lock, the cached future may be evicted as soon as it is released
+		auto future{ m_cache->getOrCreateValue( key, makeFuture, configure ) };
+
+		if ( !promise )
+		{
+			return future;
+		}
+
+		// Submitted once the future is cached, so a failing task always finds its entry to remove
+		try
+		{
+			m_executor( [cache = std::weak_ptr<Cache>{ m_cache }, key, promise, task = std::decay_t<TFactory>( std::forward<TFactory>( factory ) )]() mutable {
+				try
+				{
+					promise->set_value( std::invoke( task ) );
+				}
+				catch ( ... )
+				{
+					promise->set_exception( std::current_exception() );
+
+					if ( auto owner{ cache.lock() } )
+					{
+						owner->removeIf( key, isFailed );
+					}
+				}
+			} );
+		}
+		catch ( ... )
+		{
+			promise->set_exception( std::current_exception() );
+			m_cache->removeIf( key, isFailed );
+			throw;
+		}
+
+		return future;
+	}
+
+	//----------------------------------------------
+	// Lookup operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::optional<typename AsyncLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::Future> AsyncLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::tryGet( const TKey& key )
+	{
+		return m_cache->tryGetValue( key );
+	}
+
+	//----------------------------------------------
+	// Modification operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool AsyncLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::remove( const TKey& key )
+	{
+		return m_cache->remove( key );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void AsyncLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::clear()
+	{
+		m_cache->clear();
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::size_t AsyncLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::size() const
+	{
+		return m_cache->size();
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline LruCacheStatisticsSnapshot AsyncLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::stats() const noexcept
+	{
+		return m_cache->stats();
+	}
+
+	//----------------------------------------------
+	// Helpers
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool AsyncLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::isFailed( const Future& future )
+	{
+		if ( future.wait_for( std::chrono::seconds{ 0 } ) != std::future_status::ready )
+		{
+			return false;
+		}
+
+		try
+		{
+			static_cast<void>( future.get() );
+		}
+		catch ( ... )
+		{
+			return true;
+		}
+
+		return false;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline const LruCacheOptions& AsyncLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::checkOptions( const LruCacheOptions& options )
+	{
+		if ( options.refreshAfterWrite().count() > 0 )
+		{
+			throw std::invalid_argument{ "AsyncLruCache: refresh after write is not supported" };
+		}
+
+		return options;
+	}
+} // namespace nfx::memory
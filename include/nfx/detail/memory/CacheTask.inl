@@ -0,0 +1,182 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file CacheTask.inl
+ * @brief Implementation of CacheTask
+ * @details Lazy start, symmetric transfer back to the awaiter, result or exception storage
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// CacheTask::promise_type
+	//=====================================================================
+
+	//----------------------------------------------
+	// Final suspension
+	//----------------------------------------------
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline bool CacheTask<T>::promise_type::FinalAwaiter::await_ready() const noexcept
+	{
+		return false;
+	}
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline std::coroutine_handle<> CacheTask<T>::promise_type::FinalAwaiter::await_suspend( std::coroutine_handle<promise_type> finished ) const noexcept
+	{
+		if ( auto continuation{ finished.promise().m_continuation } )
+		{
+			return continuation;
+		}
+
+		return std::noop_coroutine();
+	}
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline void CacheTask<T>::promise_type::FinalAwaiter::await_resume() const noexcept
+	{
+	}
+
+	//----------------------------------------------
+	// Coroutine interface
+	//----------------------------------------------
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline CacheTask<T> CacheTask<T>::promise_type::get_return_object() noexcept
+	{
+		return CacheTask{ std::coroutine_handle<promise_type>::from_promise( *this ) };
+	}
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline std::suspend_always CacheTask<T>::promise_type::initial_suspend() const noexcept
+	{
+		return {};
+	}
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline typename CacheTask<T>::promise_type::FinalAwaiter CacheTask<T>::promise_type::final_suspend() const noexcept
+	{
+		return {};
+	}
+
+	template <typename T>
+		requires std::is_object_v<T>
+	template <typename U>
+		requires std::convertible_to<U, T>
+	inline void CacheTask<T>::promise_type::return_value( U&& value )
+	{
+		m_result.template emplace<1>( std::forward<U>( value ) );
+	}
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline void CacheTask<T>::promise_type::unhandled_exception() noexcept
+	{
+		m_result.template emplace<2>( std::current_exception() );
+	}
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline T CacheTask<T>::promise_type::result()
+	{
+		if ( m_result.index() == 2 )
+		{
+			std::rethrow_exception( std::get<2>( m_result ) );
+		}
+
+		return std::move( std::get<1>( m_result ) );
+	}
+
+	//=====================================================================
+	// CacheTask
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline CacheTask<T>::CacheTask( std::coroutine_handle<promise_type> handle ) noexcept
+		: m_handle{ handle }
+	{
+	}
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline CacheTask<T>::CacheTask( CacheTask&& other ) noexcept
+		: m_handle{ std::exchange( other.m_handle, nullptr ) }
+	{
+	}
+
+	//----------------------------------------------
+	// Destruction
+	//----------------------------------------------
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline CacheTask<T>::~CacheTask()
+	{
+		if ( m_handle )
+		{
+			m_handle.destroy();
+		}
+	}
+
+	//----------------------------------------------
+	// Awaiting
+	//----------------------------------------------
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline bool CacheTask<T>::await_ready() const noexcept
+	{
+		return false;
+	}
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline std::coroutine_handle<> CacheTask<T>::await_suspend( std::coroutine_handle<> awaiting ) noexcept
+	{
+		m_handle.promise().m_continuation = awaiting;
+
+		return m_handle;
+	}
+
+	template <typename T>
+		requires std::is_object_v<T>
+	inline T CacheTask<T>::await_resume()
+	{
+		return m_handle.promise().result();
+	}
+} // namespace nfx::memory
@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file CoarseClock.inl
+ * @brief Implementation of CoarseClock
+ * @details Background refresh thread and per-resolution shared instances
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// CoarseClock
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline CoarseClock::CoarseClock( std::chrono::milliseconds resolution )
+		: m_resolution{ resolution },
+		  m_now{ std::chrono::steady_clock::now().time_since_epoch().count() }
+	{
+		m_thread = std::jthread{ [this]( std::stop_token stopToken ) {
+			std::mutex mutex;
+			std::condition_variable_any wakeUp;
+			std::unique_lock<std::mutex> lock{ mutex };
+
+			// Wakes early only when stop is requested
+			while ( !wakeUp.wait_for( lock, stopToken, m_resolution, []() { return false; } ) && !stopToken.stop_requested() )
+			{
+				update();
+			}
+		} };
+	}
+
+	inline std::shared_ptr<CoarseClock> CoarseClock::shared( std::chrono::milliseconds resolution )
+	{
+		static std::mutex registryMutex;
+		static std::vector<std::weak_ptr<CoarseClock>> registry;
+
+		std::lock_guard<std::mutex> lock{ registryMutex };
+
+		std::erase_if( registry, []( const std::weak_ptr<CoarseClock>& clock ) { return clock.expired(); } );
+
+		for ( const auto& entry : registry )
+		{
+			if ( auto clock{ entry.lock() }; clock && clock->resolution() == resolution )
+			{
+				return clock;
+			}
+		}
+
+		auto clock{ std::make_shared<CoarseClock>( resolution ) };
+		registry.push_back( clock );
+
+		return clock;
+	}
+
+	//----------------------------------------------
+	// Time
+	//----------------------------------------------
+
+	inline std::chrono::steady_clock::time_point CoarseClock::now() const noexcept
+	{
+		return std::chrono::steady_clock::time_point{ std::chrono::steady_clock::duration{ m_now.load( std::memory_order_relaxed ) } };
+	}
+
+	inline void CoarseClock::update() noexcept
+	{
+		m_now.store( std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed );
+	}
+
+	inline std::chrono::milliseconds CoarseClock::resolution() const noexcept
+	{
+		return m_resolution;
+	}
+} // namespace nfx::memory
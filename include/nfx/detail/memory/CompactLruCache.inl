@@ -0,0 +1,631 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file CompactLruCache.inl
+ * @brief Implementation of CompactLruCache template methods
+ * @details Chunked slot storage, linear-probing index table with backward-shift deletion,
+ *          index-linked LRU list and tick-based sliding expiration
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// CompactLruCache
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline CompactLruCache<TKey, TValue, THash, TKeyEqual>::CompactLruCache( const LruCacheOptions& options )
+		: m_options{ options },
+		  m_epoch{ std::chrono::steady_clock::now() },
+		  m_defaultExpiration{ toTicks( options.slidingExpiration() ) }
+	{
+		// Settings changing which entries are kept cannot be ignored
+		if ( m_options.maxWeight() > 0 )
+		{
+			throw std::invalid_argument{ "CompactLruCache: weight limits are not supported" };
+		}
+
+		if ( m_options.absoluteExpiration().count() > 0 )
+		{
+			throw std::invalid_argument{ "CompactLruCache: absolute expiration is not supported" };
+		}
+
+		if ( m_options.refreshAfterWrite().count() > 0 )
+		{
+			throw std::invalid_argument{ "CompactLruCache: refresh after write is not supported" };
+		}
+
+		// Size the table for the limit up front, so a full cache never rehashes
+		std::size_t capacity{ MIN_INDEX_CAPACITY };
+		if ( m_options.sizeLimit() > 0 )
+		{
+			capacity = std::max( capacity, std::bit_ceil( m_options.sizeLimit() + m_options.sizeLimit() / 3 + 1 ) );
+		}
+
+		rehash( capacity );
+
+		if ( m_options.clockResolution().count() > 0 )
+		{
+			// Ticks count from the clock's own reading, which may lag the steady clock
+			m_clock = CoarseClock::shared( m_options.clockResolution() );
+			m_epoch = m_clock->now();
+		}
+	}
+
+	//----------------------------------------------
+	// Destruction
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline CompactLruCache<TKey, TValue, THash, TKeyEqual>::~CompactLruCache()
+	{
+		destroySlots();
+	}
+
+	//----------------------------------------------
+	// Cache operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	template <CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure>
+	inline TValue& CompactLruCache<TKey, TValue, THash, TKeyEqual>::getOrCreate( const TKey& key, TFactory&& factory, TConfigure&& configure )
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		const auto now{ currentTick() };
+
+		// Check for background cleanup opportunity
+		checkAndPerformBackgroundCleanup( now );
+
+		const auto position{ findPosition( key ) };
+		if ( position != NO_POSITION )
+		{
+			const auto index{ m_index[position] };
+			if ( !isExpired( index, now ) )
+			{
+				touch( index, now );
+
+				return slotAt( index ).value;
+			}
+
+			eraseSlot( position );
+		}
+
+		TValue value{ std::invoke( factory ) };
+
+		std::uint32_t expiration{ m_defaultExpiration };
+
+		if constexpr ( std::is_null_pointer_v<std::remove_cvref_t<TConfigure>> )
+		{
+			// No configuration requested
+		}
+		else
+		{
+			bool configured{ true };
+			if constexpr ( std::is_constructible_v<bool, TConfigure&> )
+			{
+				// Null pointers and empty std::function objects mean no configuration
+				configured = static_cast<bool>( configure );
+			}
+
+			if ( configured )
+			{
+				CacheEntry metadata{ m_options.slidingExpiration() };
+				std::invoke( configure, metadata );
+				expiration = toTicks( metadata.slidingExpiration );
+			}
+		}
+
+		if ( m_options.sizeLimit() > 0 )
+		{
+			while ( m_size >= m_options.sizeLimit() && m_lruTail != NIL )
+			{
+				eraseSlot( findPosition( slotAt( m_lruTail ).key ) );
+			}
+		}
+
+		const auto index{ allocateSlot() };
+		bool constructed{ false };
+
+		try
+		{
+			if ( expiration != m_defaultExpiration )
+			{
+				m_expirations.insert_or_assign( index, expiration );
+			}
+
+			::new ( static_cast<void*>( &slotAt( index ) ) ) Slot{ key, std::move( value ), NIL, NIL, now };
+			constructed = true;
+
+			insertIndex( index );
+		}
+		catch ( ... )
+		{
+			if ( constructed )
+			{
+				slotAt( index ).~Slot();
+			}
+
+			m_expirations.erase( index );
+
+			// Hand the index back without allocating
+			if ( index + 1 == m_nextSlot )
+			{
+				--m_nextSlot;
+			}
+			else
+			{
+				m_freeSlots.push_back( index );
+			}
+
+			throw;
+		}
+
+		addToLruHead( index );
+		++m_size;
+
+		return slotAt( index ).value;
+	}
+
+	//----------------------------------------------
+	// Lookup operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline std::optional<std::reference_wrapper<TValue>> CompactLruCache<TKey, TValue, THash, TKeyEqual>::tryGet( const TKey& key )
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		const auto now{ currentTick() };
+
+		// Read-mostly workloads must keep expired entries from piling up too
+		checkAndPerformBackgroundCleanup( now );
+
+		const auto position{ findPosition( key ) };
+		if ( position == NO_POSITION )
+		{
+			return std::nullopt;
+		}
+
+		const auto index{ m_index[position] };
+		if ( isExpired( index, now ) )
+		{
+			eraseSlot( position );
+
+			return std::nullopt;
+		}
+
+		touch( index, now );
+
+		return std::ref( slotAt( index ).value );
+	}
+
+	//----------------------------------------------
+	// Modification operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline bool CompactLruCache<TKey, TValue, THash, TKeyEqual>::remove( const TKey& key )
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		const auto position{ findPosition( key ) };
+		if ( position == NO_POSITION )
+		{
+			return false;
+		}
+
+		eraseSlot( position );
+
+		return true;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline void CompactLruCache<TKey, TValue, THash, TKeyEqual>::clear()
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		destroySlots();
+
+		// Keep the chunks and the table, a cleared cache is usually refilled
+		std::fill_n( m_index.get(), m_indexMask + 1, NIL );
+		m_expirations.clear();
+		m_freeSlots.clear();
+		m_nextSlot = 0;
+		m_size = 0;
+		m_lruHead = NIL;
+		m_lruTail = NIL;
+		m_cleanupCursor = NIL;
+		m_cleanupPending = false;
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline std::size_t CompactLruCache<TKey, TValue, THash, TKeyEqual>::size() const
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		return m_size;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline bool CompactLruCache<TKey, TValue, THash, TKeyEqual>::isEmpty() const
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		return m_size == 0;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline void CompactLruCache<TKey, TValue, THash, TKeyEqual>::cleanupExpired()
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		removeExpired( currentTick(), std::numeric_limits<std::size_t>::max() );
+		m_cleanupPending = false;
+	}
+
+	//----------------------------------------------
+	// Time
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline std::uint32_t CompactLruCache<TKey, TValue, THash, TKeyEqual>::currentTick() const noexcept
+	{
+		const auto now{ m_clock ? m_clock->now() : std::chrono::steady_clock::now() };
+
+		return static_cast<std::uint32_t>( ( now - m_epoch ) / TICK );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline std::uint32_t CompactLruCache<TKey, TValue, THash, TKeyEqual>::toTicks( std::chrono::milliseconds duration ) noexcept
+	{
+		if ( duration.count() <= 0 )
+		{
+			return 0;
+		}
+
+		const auto ticks{ ( duration.count() + TICK.count() - 1 ) / TICK.count() };
+
+		return static_cast<std::uint32_t>( std::min<std::chrono::milliseconds::rep>( ticks, NIL ) );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline bool CompactLruCache<TKey, TValue, THash, TKeyEqual>::isExpired( std::uint32_t index, std::uint32_t now ) const
+	{
+		auto expiration{ m_defaultExpiration };
+		if ( !m_expirations.empty() )
+		{
+			const auto it{ m_expirations.find( index ) };
+			if ( it != m_expirations.end() )
+			{
+				expiration = it->second;
+			}
+		}
+
+		// Access times are truncated to ticks, so a strict comparison never expires early
+		return static_cast<std::uint32_t>( now - slotAt( index ).lastAccessed ) > expiration;
+	}
+
+	//----------------------------------------------
+	// Index table
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline std::size_t CompactLruCache<TKey, TValue, THash, TKeyEqual>::findPosition( const TKey& key ) const
+	{
+		for ( auto position{ homePosition( key ) };; position = ( position + 1 ) & m_indexMask )
+		{
+			const auto index{ m_index[position] };
+			if ( index == NIL )
+			{
+				return NO_POSITION;
+			}
+
+			if ( m_equal( slotAt( index ).key, key ) )
+			{
+				return position;
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline std::size_t CompactLruCache<TKey, TValue, THash, TKeyEqual>::homePosition( const TKey& key ) const
+	{
+		// MurmurHash3 64-bit finalizer, identity hashes would cluster consecutive keys
+		auto hash{ static_cast<std::uint64_t>( m_hasher( key ) ) };
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb3f99f2c1b53ULL;
+		hash ^= hash >> 33;
+
+		return static_cast<std::size_t>( hash ) & m_indexMask;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline void CompactLruCache<TKey, TValue, THash, TKeyEqual>::insertIndex( std::uint32_t index )
+	{
+		// Linear probing degrades quickly past 3/4 load
+		if ( ( m_size + 1 ) * 4 > ( m_indexMask + 1 ) * 3 )
+		{
+			rehash( ( m_indexMask + 1 ) * 2 );
+		}
+
+		auto position{ homePosition( slotAt( index ).key ) };
+		while ( m_index[position] != NIL )
+		{
+			position = ( position + 1 ) & m_indexMask;
+		}
+
+		m_index[position] = index;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline void CompactLruCache<TKey, TValue, THash, TKeyEqual>::erasePosition( std::size_t position )
+	{
+		auto hole{ position };
+		for ( auto next{ ( hole + 1 ) & m_indexMask }; m_index[next] != NIL; next = ( next + 1 ) & m_indexMask )
+		{
+			// Move the entry into the hole unless its home lies cyclically after the hole
+			const auto home{ homePosition( slotAt( m_index[next] ).key ) };
+			if ( ( ( next - home ) & m_indexMask ) >= ( ( next - hole ) & m_indexMask ) )
+			{
+				m_index[hole] = m_index[next];
+				hole = next;
+			}
+		}
+
+		m_index[hole] = NIL;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline void CompactLruCache<TKey, TValue, THash, TKeyEqual>::rehash( std::size_t capacity )
+	{
+		auto table{ std::make_unique_for_overwrite<std::uint32_t[]>( capacity ) };
+		std::fill_n( table.get(), capacity, NIL );
+
+		m_index = std::move( table );
+		m_indexMask = capacity - 1;
+
+		for ( auto index{ m_lruHead }; index != NIL; index = slotAt( index ).lruNext )
+		{
+			auto position{ homePosition( slotAt( index ).key ) };
+			while ( m_index[position] != NIL )
+			{
+				position = ( position + 1 ) & m_indexMask;
+			}
+
+			m_index[position] = index;
+		}
+	}
+
+	//----------------------------------------------
+	// Slot management
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline typename CompactLruCache<TKey, TValue, THash, TKeyEqual>::Slot& CompactLruCache<TKey, TValue, THash, TKeyEqual>::slotAt( std::uint32_t index ) const noexcept
+	{
+		auto* storage{ m_chunks[index >> CHUNK_SHIFT]->storage + ( index & ( CHUNK_SIZE - 1 ) ) * sizeof( Slot ) };
+
+		return *std::launder( reinterpret_cast<Slot*>( storage ) );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline std::uint32_t CompactLruCache<TKey, TValue, THash, TKeyEqual>::allocateSlot()
+	{
+		if ( !m_freeSlots.empty() )
+		{
+			const auto index{ m_freeSlots.back() };
+			m_freeSlots.pop_back();
+
+			return index;
+		}
+
+		if ( m_nextSlot == NIL )
+		{
+			throw std::length_error{ "CompactLruCache: too many entries for 32-bit slot indices" };
+		}
+
+		if ( m_nextSlot == m_chunks.size() * CHUNK_SIZE )
+		{
+			m_chunks.push_back( std::make_unique_for_overwrite<Chunk>() );
+		}
+
+		return m_nextSlot++;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline void CompactLruCache<TKey, TValue, THash, TKeyEqual>::eraseSlot( std::size_t position )
+	{
+		const auto index{ m_index[position] };
+
+		// Only this step allocates, do it before anything changes
+		m_freeSlots.push_back( index );
+
+		erasePosition( position );
+		removeFromLru( index );
+
+		if ( !m_expirations.empty() )
+		{
+			m_expirations.erase( index );
+		}
+
+		slotAt( index ).~Slot();
+		--m_size;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline void CompactLruCache<TKey, TValue, THash, TKeyEqual>::destroySlots() noexcept
+	{
+		auto index{ m_lruHead };
+		while ( index != NIL )
+		{
+			auto& slot{ slotAt( index ) };
+			index = slot.lruNext;
+			slot.~Slot();
+		}
+	}
+
+	//----------------------------------------------
+	// LRU list management
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline void CompactLruCache<TKey, TValue, THash, TKeyEqual>::addToLruHead( std::uint32_t index ) noexcept
+	{
+		auto& slot{ slotAt( index ) };
+		slot.lruPrev = NIL;
+		slot.lruNext = m_lruHead;
+
+		if ( m_lruHead != NIL )
+		{
+			slotAt( m_lruHead ).lruPrev = index;
+		}
+
+		m_lruHead = index;
+
+		if ( m_lruTail == NIL )
+		{
+			m_lruTail = index;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline void CompactLruCache<TKey, TValue, THash, TKeyEqual>::removeFromLru( std::uint32_t index ) noexcept
+	{
+		auto& slot{ slotAt( index ) };
+
+		// Keep the cleanup cursor on the list, moving it toward the head
+		if ( index == m_cleanupCursor )
+		{
+			m_cleanupCursor = slot.lruPrev;
+		}
+
+		if ( slot.lruPrev != NIL )
+		{
+			slotAt( slot.lruPrev ).lruNext = slot.lruNext;
+		}
+		else
+		{
+			m_lruHead = slot.lruNext;
+		}
+
+		if ( slot.lruNext != NIL )
+		{
+			slotAt( slot.lruNext ).lruPrev = slot.lruPrev;
+		}
+		else
+		{
+			m_lruTail = slot.lruPrev;
+		}
+
+		slot.lruPrev = NIL;
+		slot.lruNext = NIL;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline void CompactLruCache<TKey, TValue, THash, TKeyEqual>::touch( std::uint32_t index, std::uint32_t now ) noexcept
+	{
+		slotAt( index ).lastAccessed = now;
+
+		if ( index != m_lruHead )
+		{
+			removeFromLru( index );
+			addToLruHead( index );
+		}
+	}
+
+	//----------------------------------------------
+	// Expiration
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline void CompactLruCache<TKey, TValue, THash, TKeyEqual>::checkAndPerformBackgroundCleanup( std::uint32_t now )
+	{
+		// Skip if background cleanup is disabled or not yet due
+		if ( !isBackgroundCleanupDue( now ) )
+		{
+			return;
+		}
+
+		m_lastCleanup = now;
+		m_cleanupPending = !removeExpired( now, MAX_CLEANUP_PER_CYCLE );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline bool CompactLruCache<TKey, TValue, THash, TKeyEqual>::isBackgroundCleanupDue( std::uint32_t now ) const noexcept
+	{
+		if ( m_options.backgroundCleanupInterval().count() <= 0 )
+		{
+			return false;
+		}
+
+		return m_cleanupPending || static_cast<std::uint32_t>( now - m_lastCleanup ) >= toTicks( m_options.backgroundCleanupInterval() );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+	inline bool CompactLruCache<TKey, TValue, THash, TKeyEqual>::removeExpired( std::uint32_t now, std::size_t limit )
+	{
+		// Resume where the previous bounded pass stopped
+		auto index{ m_cleanupCursor != NIL ? m_cleanupCursor : m_lruTail };
+		m_cleanupCursor = NIL;
+
+		std::size_t visited{ 0 };
+		while ( index != NIL )
+		{
+			if ( visited == limit )
+			{
+				m_cleanupCursor = index;
+				return false;
+			}
+			++visited;
+
+			const auto previous{ slotAt( index ).lruPrev };
+
+			if ( isExpired( index, now ) )
+			{
+				eraseSlot( findPosition( slotAt( index ).key ) );
+			}
+			else if ( m_expirations.empty() )
+			{
+				// With a single expiration, every more recently used slot is still live
+				break;
+			}
+
+			index = previous;
+		}
+
+		return true;
+	}
+} // namespace nfx::memory
@@ -0,0 +1,1154 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file EvictionPolicy.inl
+ * @brief Implementation of the eviction policies
+ * @details Segment bookkeeping, ghost lists, clock rings and the LRU, SLRU, 2Q, ARC, W-TinyLFU,
+ *          CLOCK, CLOCK-Pro and S3-FIFO decisions
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// SegmentedList
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename TEntry, std::size_t SEGMENTS>
+	inline SegmentedList<TEntry, SEGMENTS>::SegmentedList( bool weighted ) noexcept
+		: m_weighted{ weighted }
+	{
+	}
+
+	//----------------------------------------------
+	// Modifiers
+	//----------------------------------------------
+
+	template <typename TEntry, std::size_t SEGMENTS>
+	inline void SegmentedList<TEntry, SEGMENTS>::pushFront( TEntry* entry, std::uint8_t segment ) noexcept
+	{
+		auto& list{ m_lists[segment] };
+
+		entry->segment = segment;
+		entry->lruNext = list.head;
+		entry->lruPrev = nullptr;
+
+		if ( list.head != nullptr )
+		{
+			list.head->lruPrev = entry;
+		}
+		else
+		{
+			list.tail = entry;
+		}
+
+		list.head = entry;
+		++list.count;
+		list.weight += entry->size;
+	}
+
+	template <typename TEntry, std::size_t SEGMENTS>
+	inline void SegmentedList<TEntry, SEGMENTS>::remove( TEntry* entry ) noexcept
+	{
+		auto& list{ m_lists[entry->segment] };
+
+		if ( entry->lruPrev != nullptr )
+		{
+			entry->lruPrev->lruNext = entry->lruNext;
+		}
+		else
+		{
+			list.head = entry->lruNext;
+		}
+
+		if ( entry->lruNext != nullptr )
+		{
+			entry->lruNext->lruPrev = entry->lruPrev;
+		}
+		else
+		{
+			list.tail = entry->lruPrev;
+		}
+
+		entry->lruNext = nullptr;
+		entry->lruPrev = nullptr;
+		--list.count;
+		list.weight -= entry->size;
+	}
+
+	template <typename TEntry, std::size_t SEGMENTS>
+	inline void SegmentedList<TEntry, SEGMENTS>::moveToFront( TEntry* entry, std::uint8_t segment ) noexcept
+	{
+		if ( entry == m_lists[segment].head )
+		{
+			return;
+		}
+
+		remove( entry );
+		pushFront( entry, segment );
+	}
+
+	template <typename TEntry, std::size_t SEGMENTS>
+	inline void SegmentedList<TEntry, SEGMENTS>::clear() noexcept
+	{
+		m_lists = {};
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	template <typename TEntry, std::size_t SEGMENTS>
+	inline TEntry* SegmentedList<TEntry, SEGMENTS>::back( std::uint8_t segment ) const noexcept
+	{
+		return m_lists[segment].tail;
+	}
+
+	template <typename TEntry, std::size_t SEGMENTS>
+	inline std::size_t SegmentedList<TEntry, SEGMENTS>::load( std::uint8_t segment ) const noexcept
+	{
+		return m_weighted ? m_lists[segment].weight : m_lists[segment].count;
+	}
+
+	template <typename TEntry, std::size_t SEGMENTS>
+	inline std::size_t SegmentedList<TEntry, SEGMENTS>::count( std::uint8_t segment ) const noexcept
+	{
+		return m_lists[segment].count;
+	}
+
+	template <typename TEntry, std::size_t SEGMENTS>
+	inline std::size_t SegmentedList<TEntry, SEGMENTS>::unit( const TEntry* entry ) const noexcept
+	{
+		return m_weighted ? entry->size : 1;
+	}
+
+	//=====================================================================
+	// GhostList
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline GhostList::GhostList( std::size_t capacity )
+		: m_growable{ capacity == 0 }
+	{
+		// Twice the ghosts kept, so that compaction always frees at least half of the ring
+		if ( capacity > 0 )
+		{
+			allocate( std::min( 2 * ( capacity + 1 ), MAX_RING_SIZE ) );
+		}
+	}
+
+	//----------------------------------------------
+	// Operations
+	//----------------------------------------------
+
+	inline void GhostList::push( std::uint64_t hash )
+	{
+		erase( hash );
+
+		if ( m_used == m_ring.size() )
+		{
+			makeRoom();
+		}
+
+		const auto position{ ( m_head + m_used ) % m_ring.size() };
+		m_ring[position] = hash;
+		insertSlot( position );
+		++m_used;
+		++m_size;
+	}
+
+	inline bool GhostList::erase( std::uint64_t hash ) noexcept
+	{
+		if ( m_size == 0 )
+		{
+			return false;
+		}
+
+		const auto slot{ findSlot( hash ) };
+		if ( m_index[slot] == EMPTY )
+		{
+			return false;
+		}
+
+		// The ring slot stays behind, dead, until it is popped or compacted away
+		removeSlot( slot );
+		--m_size;
+
+		return true;
+	}
+
+	inline std::size_t GhostList::trim( std::size_t maxCount ) noexcept
+	{
+		std::size_t forgotten{ 0 };
+		while ( m_size > maxCount )
+		{
+			popOldest();
+			++forgotten;
+		}
+
+		return forgotten;
+	}
+
+	inline std::size_t GhostList::size() const noexcept
+	{
+		return m_size;
+	}
+
+	//----------------------------------------------
+	// Helpers
+	//----------------------------------------------
+
+	inline void GhostList::allocate( std::size_t ringSize )
+	{
+		// Twice the ring, so probes end on a free slot even if every ring slot is live
+		const auto indexSize{ std::bit_ceil( ringSize ) * 2 };
+
+		m_ring.assign( ringSize, 0 );
+		m_index.assign( indexSize, EMPTY );
+		m_indexShift = 64 - std::countr_zero( indexSize );
+		m_head = 0;
+		m_used = 0;
+		m_size = 0;
+	}
+
+	inline void GhostList::makeRoom()
+	{
+		if ( m_size * 2 > m_ring.size() || m_ring.empty() )
+		{
+			if ( !m_growable || m_ring.size() >= MAX_RING_SIZE )
+			{
+				popOldest();
+
+				return;
+			}
+
+			// Reinserted oldest first, so the doubled ring keeps the push order
+			std::vector<std::uint64_t> ghosts;
+			ghosts.reserve( m_size );
+			for ( std::size_t i{ 0 }; i < m_used; ++i )
+			{
+				const auto position{ ( m_head + i ) % m_ring.size() };
+				if ( m_index[findSlot( m_ring[position] )] == position )
+				{
+					ghosts.push_back( m_ring[position] );
+				}
+			}
+
+			allocate( std::max( m_ring.size() * 2, MIN_RING_SIZE ) );
+			for ( const auto hash : ghosts )
+			{
+				m_ring[m_used] = hash;
+				insertSlot( m_used );
+				++m_used;
+			}
+			m_size = ghosts.size();
+
+			return;
+		}
+
+		// Half the slots are dead, compaction pays for the erasures that left them
+		compact();
+	}
+
+	inline void GhostList::compact() noexcept
+	{
+		// Live slots are identified through the index before it is rebuilt
+		std::size_t kept{ 0 };
+		for ( std::size_t i{ 0 }; i < m_used; ++i )
+		{
+			const auto position{ ( m_head + i ) % m_ring.size() };
+			if ( m_index[findSlot( m_ring[position] )] == position )
+			{
+				m_ring[( m_head + kept ) % m_ring.size()] = m_ring[position];
+				++kept;
+			}
+		}
+
+		std::fill( m_index.begin(), m_index.end(), EMPTY );
+		for ( std::size_t i{ 0 }; i < kept; ++i )
+		{
+			insertSlot( ( m_head + i ) % m_ring.size() );
+		}
+		m_used = kept;
+	}
+
+	inline void GhostList::popOldest() noexcept
+	{
+		while ( m_used > 0 )
+		{
+			const auto position{ m_head };
+			const auto slot{ findSlot( m_ring[position] ) };
+
+			m_head = ( m_head + 1 ) % m_ring.size();
+			--m_used;
+
+			if ( m_index[slot] == position )
+			{
+				removeSlot( slot );
+				--m_size;
+
+				return;
+			}
+		}
+	}
+
+	inline std::size_t GhostList::findSlot( std::uint64_t hash ) const noexcept
+	{
+		// Fibonacci hashing, key hashes of integers are often the identity
+		const auto mask{ m_index.size() - 1 };
+		auto slot{ static_cast<std::size_t>( ( hash * 0x9E3779B97F4A7C15ULL ) >> m_indexShift ) };
+
+		while ( m_index[slot] != EMPTY && m_ring[m_index[slot]] != hash )
+		{
+			slot = ( slot + 1 ) & mask;
+		}
+
+		return slot;
+	}
+
+	inline void GhostList::insertSlot( std::size_t position ) noexcept
+	{
+		m_index[findSlot( m_ring[position] )] = static_cast<std::uint32_t>( position );
+	}
+
+	inline void GhostList::removeSlot( std::size_t slot ) noexcept
+	{
+		const auto mask{ m_index.size() - 1 };
+
+		// Backward shift deletion: no tombstones, probes still stop at the first free slot
+		auto hole{ slot };
+		for ( auto next{ ( hole + 1 ) & mask }; m_index[next] != EMPTY; next = ( next + 1 ) & mask )
+		{
+			const auto home{ static_cast<std::size_t>( ( m_ring[m_index[next]] * 0x9E3779B97F4A7C15ULL ) >> m_indexShift ) };
+			if ( ( ( next - home ) & mask ) >= ( ( next - hole ) & mask ) )
+			{
+				m_index[hole] = m_index[next];
+				hole = next;
+			}
+		}
+
+		m_index[hole] = EMPTY;
+	}
+
+	//=====================================================================
+	// ClockRing
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename TEntry>
+	inline ClockRing<TEntry>::ClockRing( bool weighted ) noexcept
+		: m_weighted{ weighted }
+	{
+	}
+
+	//----------------------------------------------
+	// Modifiers
+	//----------------------------------------------
+
+	template <typename TEntry>
+	inline void ClockRing<TEntry>::insert( TEntry* entry, std::uint8_t segment ) noexcept
+	{
+		entry->segment = segment;
+		std::atomic_ref<std::uint8_t>{ entry->referenced }.store( 0, std::memory_order_relaxed );
+
+		if ( m_hand == nullptr )
+		{
+			entry->lruNext = entry;
+			entry->lruPrev = entry;
+			m_hand = entry;
+		}
+		else
+		{
+			entry->lruNext = m_hand;
+			entry->lruPrev = m_hand->lruPrev;
+			m_hand->lruPrev->lruNext = entry;
+			m_hand->lruPrev = entry;
+		}
+
+		++m_count;
+		m_weight += entry->size;
+	}
+
+	template <typename TEntry>
+	inline void ClockRing<TEntry>::remove( TEntry* entry ) noexcept
+	{
+		if ( entry->lruNext == entry )
+		{
+			m_hand = nullptr;
+		}
+		else
+		{
+			if ( m_hand == entry )
+			{
+				m_hand = entry->lruNext;
+			}
+
+			entry->lruPrev->lruNext = entry->lruNext;
+			entry->lruNext->lruPrev = entry->lruPrev;
+		}
+
+		entry->lruNext = nullptr;
+		entry->lruPrev = nullptr;
+		--m_count;
+		m_weight -= entry->size;
+	}
+
+	template <typename TEntry>
+	inline void ClockRing<TEntry>::advance() noexcept
+	{
+		if ( m_hand != nullptr )
+		{
+			m_hand = m_hand->lruNext;
+		}
+	}
+
+	template <typename TEntry>
+	inline void ClockRing<TEntry>::clear() noexcept
+	{
+		m_hand = nullptr;
+		m_count = 0;
+		m_weight = 0;
+	}
+
+	//----------------------------------------------
+	// Reference bits
+	//----------------------------------------------
+
+	template <typename TEntry>
+	inline void ClockRing<TEntry>::reference( TEntry* entry ) noexcept
+	{
+		std::atomic_ref<std::uint8_t>{ entry->referenced }.store( 1, std::memory_order_relaxed );
+	}
+
+	template <typename TEntry>
+	inline bool ClockRing<TEntry>::clearReference( TEntry* entry ) noexcept
+	{
+		std::atomic_ref<std::uint8_t> referenced{ entry->referenced };
+		if ( referenced.load( std::memory_order_relaxed ) == 0 )
+		{
+			return false;
+		}
+
+		referenced.store( 0, std::memory_order_relaxed );
+
+		return true;
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	template <typename TEntry>
+	inline TEntry* ClockRing<TEntry>::hand() const noexcept
+	{
+		return m_hand;
+	}
+
+	template <typename TEntry>
+	inline std::size_t ClockRing<TEntry>::load() const noexcept
+	{
+		return m_weighted ? m_weight : m_count;
+	}
+
+	template <typename TEntry>
+	inline std::size_t ClockRing<TEntry>::count() const noexcept
+	{
+		return m_count;
+	}
+
+	template <typename TEntry>
+	inline std::size_t ClockRing<TEntry>::unit( const TEntry* entry ) const noexcept
+	{
+		return m_weighted ? entry->size : 1;
+	}
+
+	//=====================================================================
+	// LruPolicy
+	//=====================================================================
+
+	template <typename TEntry>
+	inline LruPolicy<TEntry>::LruPolicy( std::size_t, bool weighted ) noexcept
+		: m_lists{ weighted }
+	{
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void LruPolicy<TEntry>::onInsert( TEntry* entry, const THashFn& ) noexcept
+	{
+		m_lists.pushFront( entry, 0 );
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void LruPolicy<TEntry>::onAccess( TEntry* entry, const THashFn& ) noexcept
+	{
+		m_lists.moveToFront( entry, 0 );
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void LruPolicy<TEntry>::onMiss( const THashFn& ) noexcept
+	{
+	}
+
+	template <typename TEntry>
+	inline void LruPolicy<TEntry>::onRemove( TEntry* entry ) noexcept
+	{
+		m_lists.remove( entry );
+	}
+
+	template <typename TEntry>
+	template <typename THashOf>
+	inline TEntry* LruPolicy<TEntry>::victim( const THashOf& ) noexcept
+	{
+		return m_lists.back( 0 );
+	}
+
+	template <typename TEntry>
+	inline TEntry* LruPolicy<TEntry>::oldest() const noexcept
+	{
+		return m_lists.back( 0 );
+	}
+
+	template <typename TEntry>
+	inline void LruPolicy<TEntry>::clear() noexcept
+	{
+		m_lists.clear();
+	}
+
+	//=====================================================================
+	// SlruPolicy
+	//=====================================================================
+
+	template <typename TEntry>
+	inline SlruPolicy<TEntry>::SlruPolicy( std::size_t capacity, bool weighted ) noexcept
+		: m_lists{ weighted },
+		  m_protectedCapacity{ capacity > 0 ? capacity * 4 / 5 : SIZE_MAX }
+	{
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void SlruPolicy<TEntry>::onInsert( TEntry* entry, const THashFn& ) noexcept
+	{
+		m_lists.pushFront( entry, PROBATION );
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void SlruPolicy<TEntry>::onAccess( TEntry* entry, const THashFn& ) noexcept
+	{
+		m_lists.moveToFront( entry, PROTECTED );
+
+		while ( m_lists.load( PROTECTED ) > m_protectedCapacity && m_lists.count( PROTECTED ) > 1 )
+		{
+			m_lists.moveToFront( m_lists.back( PROTECTED ), PROBATION );
+		}
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void SlruPolicy<TEntry>::onMiss( const THashFn& ) noexcept
+	{
+	}
+
+	template <typename TEntry>
+	inline void SlruPolicy<TEntry>::onRemove( TEntry* entry ) noexcept
+	{
+		m_lists.remove( entry );
+	}
+
+	template <typename TEntry>
+	template <typename THashOf>
+	inline TEntry* SlruPolicy<TEntry>::victim( const THashOf& ) noexcept
+	{
+		return m_lists.back( PROBATION ) != nullptr ? m_lists.back( PROBATION ) : m_lists.back( PROTECTED );
+	}
+
+	template <typename TEntry>
+	inline void SlruPolicy<TEntry>::clear() noexcept
+	{
+		m_lists.clear();
+	}
+
+	//=====================================================================
+	// TwoQueuePolicy
+	//=====================================================================
+
+	template <typename TEntry>
+	inline TwoQueuePolicy<TEntry>::TwoQueuePolicy( std::size_t capacity, bool weighted )
+		: m_lists{ weighted },
+		  m_a1out{ weighted ? 0 : std::max<std::size_t>( capacity / 2, 1 ) },
+		  m_a1inCapacity{ capacity > 0 ? std::max<std::size_t>( capacity / 4, 1 ) : SIZE_MAX }
+	{
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void TwoQueuePolicy<TEntry>::onInsert( TEntry* entry, const THashFn& hash )
+	{
+		// Seen again shortly after leaving A1in: more than a one-off reference
+		m_lists.pushFront( entry, m_a1out.erase( hash() ) ? AM : A1IN );
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void TwoQueuePolicy<TEntry>::onAccess( TEntry* entry, const THashFn& ) noexcept
+	{
+		if ( entry->segment == AM )
+		{
+			m_lists.moveToFront( entry, AM );
+		}
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void TwoQueuePolicy<TEntry>::onMiss( const THashFn& ) noexcept
+	{
+	}
+
+	template <typename TEntry>
+	inline void TwoQueuePolicy<TEntry>::onRemove( TEntry* entry ) noexcept
+	{
+		m_lists.remove( entry );
+	}
+
+	template <typename TEntry>
+	template <typename THashOf>
+	inline TEntry* TwoQueuePolicy<TEntry>::victim( const THashOf& hashOf )
+	{
+		if ( m_lists.back( A1IN ) == nullptr || ( m_lists.load( A1IN ) <= m_a1inCapacity && m_lists.back( AM ) != nullptr ) )
+		{
+			return m_lists.back( AM );
+		}
+
+		auto* victim{ m_lists.back( A1IN ) };
+		m_a1out.push( hashOf( victim ) );
+		m_a1out.trim( std::max<std::size_t>( ( m_lists.count( A1IN ) + m_lists.count( AM ) ) / 2, 1 ) );
+
+		return victim;
+	}
+
+	template <typename TEntry>
+	inline void TwoQueuePolicy<TEntry>::clear() noexcept
+	{
+		m_lists.clear();
+	}
+
+	//=====================================================================
+	// ArcPolicy
+	//=====================================================================
+
+	template <typename TEntry>
+	inline ArcPolicy<TEntry>::ArcPolicy( std::size_t capacity, bool weighted )
+		: m_lists{ weighted },
+		  m_b1{ weighted ? 0 : capacity },
+		  m_b2{ weighted ? 0 : capacity },
+		  m_capacity{ capacity > 0 ? capacity : SIZE_MAX }
+	{
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void ArcPolicy<TEntry>::onInsert( TEntry* entry, const THashFn& hash )
+	{
+		const auto keyHash{ hash() };
+		const auto unit{ m_lists.unit( entry ) };
+
+		if ( m_b1.erase( keyHash ) )
+		{
+			// Evicted from T1 too early: give recency more room
+			const auto delta{ std::max<std::size_t>( m_b2.size() / ( m_b1.size() + 1 ), 1 ) * unit };
+			m_target = std::min( m_capacity, m_target + std::min( delta, m_capacity - m_target ) );
+			m_lists.pushFront( entry, T2 );
+		}
+		else if ( m_b2.erase( keyHash ) )
+		{
+			// Evicted from T2 too early: give frequency more room
+			const auto delta{ std::max<std::size_t>( m_b1.size() / ( m_b2.size() + 1 ), 1 ) * unit };
+			m_target -= std::min( delta, m_target );
+			m_lists.pushFront( entry, T2 );
+		}
+		else
+		{
+			m_lists.pushFront( entry, T1 );
+		}
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void ArcPolicy<TEntry>::onAccess( TEntry* entry, const THashFn& ) noexcept
+	{
+		m_lists.moveToFront( entry, T2 );
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void ArcPolicy<TEntry>::onMiss( const THashFn& ) noexcept
+	{
+	}
+
+	template <typename TEntry>
+	inline void ArcPolicy<TEntry>::onRemove( TEntry* entry ) noexcept
+	{
+		m_lists.remove( entry );
+	}
+
+	template <typename TEntry>
+	template <typename THashOf>
+	inline TEntry* ArcPolicy<TEntry>::victim( const THashOf& hashOf )
+	{
+		const bool fromT1{ m_lists.back( T1 ) != nullptr && ( m_lists.load( T1 ) > m_target || m_lists.back( T2 ) == nullptr ) };
+		auto* victim{ m_lists.back( fromT1 ? T1 : T2 ) };
+		if ( victim == nullptr )
+		{
+			return nullptr;
+		}
+
+		auto& ghosts{ fromT1 ? m_b1 : m_b2 };
+		ghosts.push( hashOf( victim ) );
+
+		// Each ghost list remembers at most as many keys as are cached
+		ghosts.trim( std::max<std::size_t>( m_lists.count( T1 ) + m_lists.count( T2 ), 1 ) );
+
+		return victim;
+	}
+
+	template <typename TEntry>
+	inline void ArcPolicy<TEntry>::clear() noexcept
+	{
+		m_lists.clear();
+	}
+
+	template <typename TEntry>
+	inline std::size_t ArcPolicy<TEntry>::recencyTarget() const noexcept
+	{
+		return m_target;
+	}
+
+	//=====================================================================
+	// WTinyLfuPolicy
+	//=====================================================================
+
+	template <typename TEntry>
+	inline WTinyLfuPolicy<TEntry>::WTinyLfuPolicy( std::size_t capacity, bool weighted )
+		: m_lists{ weighted },
+		  m_sketch{ weighted ? 0 : capacity },
+		  m_windowCapacity{ capacity > 0 ? std::max<std::size_t>( capacity / 100, 1 ) : SIZE_MAX },
+		  m_protectedCapacity{ capacity > m_windowCapacity ? ( capacity - m_windowCapacity ) * 4 / 5 : 0 }
+	{
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void WTinyLfuPolicy<TEntry>::onInsert( TEntry* entry, const THashFn& hash )
+	{
+		m_sketch.ensureCapacity( m_lists.count( WINDOW ) + m_lists.count( PROBATION ) + m_lists.count( PROTECTED ) + 1 );
+		m_sketch.increment( hash() );
+		m_lists.pushFront( entry, WINDOW );
+
+		// Entries leaving a full window wait on probation, eviction decides their fate once the cache is full
+		while ( m_lists.load( WINDOW ) > m_windowCapacity && m_lists.count( WINDOW ) > 1 )
+		{
+			m_lists.moveToFront( m_lists.back( WINDOW ), PROBATION );
+		}
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void WTinyLfuPolicy<TEntry>::onAccess( TEntry* entry, const THashFn& hash )
+	{
+		m_sketch.increment( hash() );
+
+		if ( entry->segment == WINDOW )
+		{
+			m_lists.moveToFront( entry, WINDOW );
+
+			return;
+		}
+
+		m_lists.moveToFront( entry, PROTECTED );
+
+		// A promotion can overflow the protected segment, its least recent entries go back on probation
+		while ( m_lists.load( PROTECTED ) > m_protectedCapacity && m_lists.count( PROTECTED ) > 1 )
+		{
+			m_lists.moveToFront( m_lists.back( PROTECTED ), PROBATION );
+		}
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void WTinyLfuPolicy<TEntry>::onMiss( const THashFn& hash )
+	{
+		m_sketch.increment( hash() );
+	}
+
+	template <typename TEntry>
+	inline void WTinyLfuPolicy<TEntry>::onRemove( TEntry* entry ) noexcept
+	{
+		m_lists.remove( entry );
+	}
+
+	template <typename TEntry>
+	template <typename THashOf>
+	inline TEntry* WTinyLfuPolicy<TEntry>::victim( const THashOf& hashOf )
+	{
+		auto* mainVictim{ m_lists.back( PROBATION ) != nullptr ? m_lists.back( PROBATION ) : m_lists.back( PROTECTED ) };
+		auto* candidate{ m_lists.load( WINDOW ) >= m_windowCapacity ? m_lists.back( WINDOW ) : nullptr };
+
+		if ( mainVictim == nullptr )
+		{
+			return m_lists.back( WINDOW );
+		}
+
+		if ( candidate == nullptr )
+		{
+			return mainVictim;
+		}
+
+		if ( m_sketch.frequency( hashOf( candidate ) ) > m_sketch.frequency( hashOf( mainVictim ) ) )
+		{
+			// The candidate was used more often recently, it takes the victim's place
+			m_lists.moveToFront( candidate, PROBATION );
+
+			return mainVictim;
+		}
+
+		return candidate;
+	}
+
+	template <typename TEntry>
+	inline void WTinyLfuPolicy<TEntry>::clear() noexcept
+	{
+		m_lists.clear();
+	}
+
+	//=====================================================================
+	// ClockPolicy
+	//=====================================================================
+
+	template <typename TEntry>
+	inline ClockPolicy<TEntry>::ClockPolicy( std::size_t, bool weighted ) noexcept
+		: m_ring{ weighted }
+	{
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void ClockPolicy<TEntry>::onInsert( TEntry* entry, const THashFn& ) noexcept
+	{
+		m_ring.insert( entry, 0 );
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void ClockPolicy<TEntry>::onAccess( TEntry* entry, const THashFn& ) noexcept
+	{
+		ClockRing<TEntry>::reference( entry );
+	}
+
+	template <typename TEntry>
+	inline void ClockPolicy<TEntry>::onSharedAccess( TEntry* entry ) noexcept
+	{
+		ClockRing<TEntry>::reference( entry );
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void ClockPolicy<TEntry>::onMiss( const THashFn& ) noexcept
+	{
+	}
+
+	template <typename TEntry>
+	inline void ClockPolicy<TEntry>::onRemove( TEntry* entry ) noexcept
+	{
+		m_ring.remove( entry );
+	}
+
+	template <typename TEntry>
+	template <typename THashOf>
+	inline TEntry* ClockPolicy<TEntry>::victim( const THashOf& ) noexcept
+	{
+		// No hit can set a bit while the cache lock is held exclusively, so one lap clears them all
+		while ( m_ring.hand() != nullptr && ClockRing<TEntry>::clearReference( m_ring.hand() ) )
+		{
+			m_ring.advance();
+		}
+
+		return m_ring.hand();
+	}
+
+	template <typename TEntry>
+	inline void ClockPolicy<TEntry>::clear() noexcept
+	{
+		m_ring.clear();
+	}
+
+	//=====================================================================
+	// ClockProPolicy
+	//=====================================================================
+
+	template <typename TEntry>
+	inline ClockProPolicy<TEntry>::ClockProPolicy( std::size_t capacity, bool weighted )
+		: m_cold{ weighted },
+		  m_hot{ weighted },
+		  m_test{ weighted ? 0 : capacity },
+		  m_capacity{ capacity > 0 ? capacity : SIZE_MAX },
+		  m_coldTarget{ capacity > 0 ? std::max<std::size_t>( capacity / 4, 1 ) : SIZE_MAX }
+	{
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void ClockProPolicy<TEntry>::onInsert( TEntry* entry, const THashFn& hash )
+	{
+		if ( m_test.size() > 0 && m_test.erase( hash() ) )
+		{
+			// Reused within its test period: its reuse distance is short enough to be hot
+			m_coldTarget = std::min( m_coldTarget + m_cold.unit( entry ), std::max<std::size_t>( m_capacity - 1, 1 ) );
+			m_hot.insert( entry, HOT );
+
+			return;
+		}
+
+		m_cold.insert( entry, COLD_TEST );
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void ClockProPolicy<TEntry>::onAccess( TEntry* entry, const THashFn& ) noexcept
+	{
+		ClockRing<TEntry>::reference( entry );
+	}
+
+	template <typename TEntry>
+	inline void ClockProPolicy<TEntry>::onSharedAccess( TEntry* entry ) noexcept
+	{
+		ClockRing<TEntry>::reference( entry );
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void ClockProPolicy<TEntry>::onMiss( const THashFn& ) noexcept
+	{
+	}
+
+	template <typename TEntry>
+	inline void ClockProPolicy<TEntry>::onRemove( TEntry* entry ) noexcept
+	{
+		( entry->segment == HOT ? m_hot : m_cold ).remove( entry );
+	}
+
+	template <typename TEntry>
+	template <typename THashOf>
+	inline TEntry* ClockProPolicy<TEntry>::victim( const THashOf& hashOf )
+	{
+		while ( true )
+		{
+			// Hot entries get the capacity left by the cold target, which promotions below may raise
+			const auto hotCapacity{ m_capacity > m_coldTarget ? m_capacity - m_coldTarget : 0 };
+			while ( m_hot.hand() != nullptr && ( m_hot.load() > hotCapacity || m_cold.hand() == nullptr ) )
+			{
+				runHotHand();
+			}
+
+			auto* candidate{ m_cold.hand() };
+			if ( candidate == nullptr )
+			{
+				return nullptr;
+			}
+
+			if ( ClockRing<TEntry>::clearReference( candidate ) )
+			{
+				if ( candidate->segment == COLD_TEST )
+				{
+					// Reused within its test period
+					m_cold.remove( candidate );
+					m_hot.insert( candidate, HOT );
+				}
+				else
+				{
+					candidate->segment = COLD_TEST;
+					m_cold.advance();
+				}
+
+				continue;
+			}
+
+			if ( candidate->segment == COLD_TEST )
+			{
+				m_test.push( hashOf( candidate ) );
+
+				// Test periods last as long as the cache holds as many entries; each one that ends unused favours hot entries
+				const auto expired{ m_test.trim( std::max<std::size_t>( m_cold.count() + m_hot.count(), 1 ) ) * m_cold.unit( candidate ) };
+				m_coldTarget = std::max<std::size_t>( m_coldTarget - std::min( expired, m_coldTarget ), 1 );
+			}
+
+			return candidate;
+		}
+	}
+
+	template <typename TEntry>
+	inline void ClockProPolicy<TEntry>::clear() noexcept
+	{
+		m_cold.clear();
+		m_hot.clear();
+	}
+
+	template <typename TEntry>
+	inline std::size_t ClockProPolicy<TEntry>::coldTarget() const noexcept
+	{
+		return m_coldTarget;
+	}
+
+	template <typename TEntry>
+	inline void ClockProPolicy<TEntry>::runHotHand() noexcept
+	{
+		auto* entry{ m_hot.hand() };
+		if ( ClockRing<TEntry>::clearReference( entry ) )
+		{
+			m_hot.advance();
+
+			return;
+		}
+
+		m_hot.remove( entry );
+		m_cold.insert( entry, COLD );
+	}
+
+	//=====================================================================
+	// S3FifoPolicy
+	//=====================================================================
+
+	template <typename TEntry>
+	inline S3FifoPolicy<TEntry>::S3FifoPolicy( std::size_t capacity, bool weighted )
+		: m_lists{ weighted },
+		  m_ghosts{ weighted ? 0 : capacity },
+		  m_smallCapacity{ capacity > 0 ? std::max<std::size_t>( capacity / 10, 1 ) : SIZE_MAX }
+	{
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void S3FifoPolicy<TEntry>::onInsert( TEntry* entry, const THashFn& hash )
+	{
+		std::atomic_ref<std::uint8_t>{ entry->referenced }.store( 0, std::memory_order_relaxed );
+
+		// Evicted from the small FIFO recently: skip probation
+		m_lists.pushFront( entry, m_ghosts.size() > 0 && m_ghosts.erase( hash() ) ? MAIN : SMALL );
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void S3FifoPolicy<TEntry>::onAccess( TEntry* entry, const THashFn& ) noexcept
+	{
+		onSharedAccess( entry );
+	}
+
+	template <typename TEntry>
+	inline void S3FifoPolicy<TEntry>::onSharedAccess( TEntry* entry ) noexcept
+	{
+		// Concurrent hits may lose a bump, the counter is only a coarse frequency
+		std::atomic_ref<std::uint8_t> frequency{ entry->referenced };
+		if ( const auto current{ frequency.load( std::memory_order_relaxed ) }; current < MAX_FREQUENCY )
+		{
+			frequency.store( static_cast<std::uint8_t>( current + 1 ), std::memory_order_relaxed );
+		}
+	}
+
+	template <typename TEntry>
+	template <typename THashFn>
+	inline void S3FifoPolicy<TEntry>::onMiss( const THashFn& ) noexcept
+	{
+	}
+
+	template <typename TEntry>
+	inline void S3FifoPolicy<TEntry>::onRemove( TEntry* entry ) noexcept
+	{
+		m_lists.remove( entry );
+	}
+
+	template <typename TEntry>
+	template <typename THashOf>
+	inline TEntry* S3FifoPolicy<TEntry>::victim( const THashOf& hashOf )
+	{
+		while ( true )
+		{
+			const bool fromSmall{ m_lists.back( SMALL ) != nullptr && ( m_lists.load( SMALL ) >= m_smallCapacity || m_lists.back( MAIN ) == nullptr ) };
+			auto* candidate{ m_lists.back( fromSmall ? SMALL : MAIN ) };
+			if ( candidate == nullptr )
+			{
+				return nullptr;
+			}
+
+			// No hit can bump a counter while the cache lock is held exclusively
+			std::atomic_ref<std::uint8_t> frequency{ candidate->referenced };
+			const auto current{ frequency.load( std::memory_order_relaxed ) };
+
+			if ( fromSmall )
+			{
+				if ( current > 0 )
+				{
+					frequency.store( 0, std::memory_order_relaxed );
+					m_lists.moveToFront( candidate, MAIN );
+
+					continue;
+				}
+
+				m_ghosts.push( hashOf( candidate ) );
+				m_ghosts.trim( std::max<std::size_t>( m_lists.count( MAIN ), 1 ) );
+
+				return candidate;
+			}
+
+			if ( current > 0 )
+			{
+				frequency.store( static_cast<std::uint8_t>( current - 1 ), std::memory_order_relaxed );
+				m_lists.moveToFront( candidate, MAIN );
+
+				continue;
+			}
+
+			return candidate;
+		}
+	}
+
+	template <typename TEntry>
+	inline void S3FifoPolicy<TEntry>::clear() noexcept
+	{
+		m_lists.clear();
+	}
+} // namespace nfx::memory
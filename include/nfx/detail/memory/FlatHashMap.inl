@@ -0,0 +1,711 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file FlatHashMap.inl
+ * @brief Implementation of FlatHashMap template methods
+ * @details Group probing, tombstone management, probe table rebuilding and entry storage
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// FlatHashMap
+	//=====================================================================
+
+	//----------------------------------------------
+	// Iterator
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator::iterator( FlatHashMap* map, std::size_t position ) noexcept
+		: m_map{ map },
+		  m_position{ position }
+	{
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::reference FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator::operator*() const noexcept
+	{
+		auto& entry{ m_map->entryAtPosition( m_position ) };
+
+		return reference{ entry.key, entry.mapped };
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator::pointer FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator::operator->() const noexcept
+	{
+		return pointer{ **this };
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator& FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator::operator++() noexcept
+	{
+		m_position = m_map->nextOccupied( m_position + 1 );
+
+		return *this;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator::operator++( int ) noexcept
+	{
+		auto previous{ *this };
+		++*this;
+
+		return previous;
+	}
+
+	//----------------------------------------------
+	// Node handle
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::node_type::node_type( TKey&& key, TMapped&& mapped )
+		: m_key{ std::move( key ) },
+		  m_mapped{ std::move( mapped ) }
+	{
+	}
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::FlatHashMap( const TAllocator& allocator )
+		: m_chunks{ ChunkPointerAllocator{ allocator } },
+		  m_allocator{ allocator }
+	{
+	}
+
+	//----------------------------------------------
+	// Destruction
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::~FlatHashMap()
+	{
+		destroyEntries();
+
+		ChunkAllocator chunkAllocator{ m_allocator };
+		for ( auto* chunk : m_chunks )
+		{
+			std::allocator_traits<ChunkAllocator>::deallocate( chunkAllocator, chunk, 1 );
+		}
+
+		if ( m_block )
+		{
+			EntrySlotAllocator blockAllocator{ m_allocator };
+			std::allocator_traits<EntrySlotAllocator>::deallocate( blockAllocator, m_block, m_blockSize );
+		}
+
+		if ( m_groups )
+		{
+			GroupAllocator groupAllocator{ m_allocator };
+			std::allocator_traits<GroupAllocator>::deallocate( groupAllocator, m_groups, m_groupMask + 1 );
+		}
+	}
+
+	//----------------------------------------------
+	// Iterators
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::begin() noexcept
+	{
+		return iterator{ this, nextOccupied( 0 ) };
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::end() noexcept
+	{
+		return iterator{ this, slotCount() };
+	}
+
+	//----------------------------------------------
+	// Capacity
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline bool FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::size_type FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::size() const noexcept
+	{
+		return m_size;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline void FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::reserve( size_type count )
+	{
+		if ( count >= NO_ENTRY )
+		{
+			throw std::length_error{ "FlatHashMap: entry count exceeds the 32-bit index range" };
+		}
+
+		std::size_t groupCount{ std::max<std::size_t>( 1, m_groupMask + 1 ) };
+		while ( maxLiveSlots( groupCount ) < count )
+		{
+			groupCount *= 2;
+		}
+
+		if ( !m_groups || groupCount > m_groupMask + 1 )
+		{
+			rehash( groupCount );
+		}
+
+		// Later entries would be split between the block and the chunks they already use
+		if ( m_nextEntry == 0 && count > m_blockSize )
+		{
+			EntrySlotAllocator blockAllocator{ m_allocator };
+			auto* block{ std::allocator_traits<EntrySlotAllocator>::allocate( blockAllocator, count ) };
+
+			if ( m_block )
+			{
+				std::allocator_traits<EntrySlotAllocator>::deallocate( blockAllocator, m_block, m_blockSize );
+			}
+
+			m_block = block;
+			m_blockSize = count;
+		}
+		else if ( count > m_blockSize )
+		{
+			m_chunks.reserve( ( count - m_blockSize + CHUNK_SIZE - 1 ) / CHUNK_SIZE );
+		}
+	}
+
+	//----------------------------------------------
+	// Observers
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline THash FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::hash_function() const
+	{
+		return m_hasher;
+	}
+
+	//----------------------------------------------
+	// Lookup
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	template <typename TLookup>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::find( const TLookup& key )
+	{
+		if ( m_size == 0 )
+		{
+			return end();
+		}
+
+		return iterator{ this, findPosition( key, hashOf( key ) ) };
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	template <typename TLookup>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::find( const TLookup& key, std::size_t hash )
+	{
+		if ( m_size == 0 )
+		{
+			return end();
+		}
+
+		return iterator{ this, findPosition( key, hash ) };
+	}
+
+	//----------------------------------------------
+	// Prefetching
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	template <typename TLookup>
+	inline std::size_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::hash( const TLookup& key ) const
+	{
+		return hashOf( key );
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline void FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::prefetchGroup( std::size_t hash ) const noexcept
+	{
+		if ( m_size == 0 )
+		{
+			return;
+		}
+
+		// Control bytes and entry indices share one cache line
+		prefetch( &m_groups[( hash >> 7 ) & m_groupMask] );
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline void FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::prefetchEntries( std::size_t hash ) const noexcept
+	{
+		if ( m_size == 0 )
+		{
+			return;
+		}
+
+		const auto& group{ m_groups[( hash >> 7 ) & m_groupMask] };
+
+		// Fragments only match occupied slots, usually just the entry being looked up
+		for ( auto matches{ matchByte( group.ctrl, static_cast<std::uint8_t>( hash & 0x7F ) ) }; matches != 0; matches &= matches - 1 )
+		{
+			prefetch( &slotAt( group.entries[static_cast<std::size_t>( std::countr_zero( matches ) )] ) );
+		}
+	}
+
+	//----------------------------------------------
+	// Modifiers
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	template <typename... TArgs>
+	inline std::pair<typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator, bool> FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::try_emplace( TKey&& key, TArgs&&... args )
+	{
+		const auto hash{ hashOf( key ) };
+		if ( m_size > 0 )
+		{
+			if ( const auto position{ findPosition( key, hash ) }; position != slotCount() )
+			{
+				return { iterator{ this, position }, false };
+			}
+		}
+
+		return { iterator{ this, insertNew( hash, std::move( key ), std::forward<TArgs>( args )... ) }, true };
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	template <typename... TArgs>
+	inline std::pair<typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator, bool> FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::try_emplace( const TKey& key, TArgs&&... args )
+	{
+		const auto hash{ hashOf( key ) };
+		if ( m_size > 0 )
+		{
+			if ( const auto position{ findPosition( key, hash ) }; position != slotCount() )
+			{
+				return { iterator{ this, position }, false };
+			}
+		}
+
+		return { iterator{ this, insertNew( hash, key, std::forward<TArgs>( args )... ) }, true };
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::iterator FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::erase( iterator it )
+	{
+		const auto position{ it.m_position };
+		auto& group{ m_groups[position / GROUP_WIDTH] };
+		const auto lane{ position % GROUP_WIDTH };
+		const auto index{ group.entries[lane] };
+
+		entryAt( index ).~Entry();
+		freeEntry( index );
+		--m_size;
+
+		// A group that still has an empty slot never overflowed, so no probe sequence
+		// continues past it and the slot can become empty again instead of a tombstone
+		if ( matchByte( group.ctrl, CTRL_EMPTY ) != 0 )
+		{
+			group.ctrl[lane] = CTRL_EMPTY;
+		}
+		else
+		{
+			group.ctrl[lane] = CTRL_DELETED;
+			++m_tombstones;
+		}
+
+		return iterator{ this, nextOccupied( position + 1 ) };
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::node_type FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::extract( iterator it )
+	{
+		auto& entry{ entryAtPosition( it.m_position ) };
+		node_type node{ std::move( entry.key ), std::move( entry.mapped ) };
+		erase( it );
+
+		return node;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline void FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::clear() noexcept
+	{
+		destroyEntries();
+
+		for ( std::size_t g{ 0 }; m_groups && g <= m_groupMask; ++g )
+		{
+			std::fill_n( m_groups[g].ctrl.begin(), GROUP_SLOTS, CTRL_EMPTY );
+		}
+
+		m_size = 0;
+		m_tombstones = 0;
+		m_nextEntry = 0;
+		m_freeEntry = NO_ENTRY;
+	}
+
+	//----------------------------------------------
+	// Group matching
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline std::uint32_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::matchByte( const std::array<std::uint8_t, GROUP_WIDTH>& ctrl, std::uint8_t value ) noexcept
+	{
+#if defined( NFX_LRUCACHE_FLAT_HASH_MAP_SSE2 )
+		const auto bytes{ _mm_load_si128( reinterpret_cast<const __m128i*>( ctrl.data() ) ) };
+
+		return static_cast<std::uint32_t>( _mm_movemask_epi8( _mm_cmpeq_epi8( bytes, _mm_set1_epi8( static_cast<char>( value ) ) ) ) );
+#else
+		return matchBytePortable( ctrl, value );
+#endif
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	constexpr std::uint32_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::matchBytePortable( const std::array<std::uint8_t, GROUP_WIDTH>& ctrl, std::uint8_t value ) noexcept
+	{
+		constexpr std::uint64_t lowBits{ 0x0101010101010101ULL };
+		constexpr std::uint64_t highBits{ 0x8080808080808080ULL };
+
+		std::uint32_t mask{ 0 };
+		for ( std::size_t half{ 0 }; half < 2; ++half )
+		{
+			// Assemble little-endian so that byte i is slot i on every platform
+			std::uint64_t word{ 0 };
+			for ( std::size_t i{ 0 }; i < 8; ++i )
+			{
+				word |= std::uint64_t{ ctrl[half * 8 + i] } << ( i * 8 );
+			}
+
+			// Exact zero-byte detection: the high bit is set only in bytes equal to value
+			const std::uint64_t x{ word ^ ( lowBits * value ) };
+			const std::uint64_t zeroBytes{ ~( ( ( x & ~highBits ) + ~highBits ) | x | ~highBits ) };
+
+			// Gather the eight high bits into the top byte
+			const auto bits{ static_cast<std::uint32_t>( ( ( zeroBytes >> 7 ) * 0x0102040810204080ULL ) >> 56 ) };
+			mask |= bits << ( half * 8 );
+		}
+
+		return mask;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline std::uint32_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::matchFree( const std::array<std::uint8_t, GROUP_WIDTH>& ctrl ) noexcept
+	{
+#if defined( NFX_LRUCACHE_FLAT_HASH_MAP_SSE2 )
+		// Empty and deleted are the only slot control bytes with the high bit set
+		return static_cast<std::uint32_t>( _mm_movemask_epi8( _mm_load_si128( reinterpret_cast<const __m128i*>( ctrl.data() ) ) ) );
+#else
+		return matchBytePortable( ctrl, CTRL_EMPTY ) | matchBytePortable( ctrl, CTRL_DELETED );
+#endif
+	}
+
+	//----------------------------------------------
+	// Internal data structures
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	template <typename TKeyArg, typename... TArgs>
+	FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::Entry::Entry( TKeyArg&& entryKey, TArgs&&... args )
+		: key( std::forward<TKeyArg>( entryKey ) ),
+		  mapped( std::forward<TArgs>( args )... )
+	{
+	}
+
+	//----------------------------------------------
+	// Helpers
+	//----------------------------------------------
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	template <typename TLookup>
+	inline std::size_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::hashOf( const TLookup& key ) const
+	{
+		// MurmurHash3 64-bit finalizer, identity hashes would leave the control bits constant
+		auto hash{ static_cast<std::uint64_t>( m_hasher( key ) ) };
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb3f99f2c1b53ULL;
+		hash ^= hash >> 33;
+
+		return static_cast<std::size_t>( hash );
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline void FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::prefetch( const void* address ) noexcept
+	{
+#if defined( __GNUC__ ) || defined( __clang__ )
+		__builtin_prefetch( address );
+#elif defined( NFX_LRUCACHE_FLAT_HASH_MAP_SSE2 )
+		_mm_prefetch( static_cast<const char*>( address ), _MM_HINT_T0 );
+#else
+		static_cast<void>( address );
+#endif
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	template <typename TLookup>
+	inline std::size_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::findPosition( const TLookup& key, std::size_t hash ) const
+	{
+		const auto fragment{ static_cast<std::uint8_t>( hash & 0x7F ) };
+		auto group{ ( hash >> 7 ) & m_groupMask };
+
+		// Triangular probing visits every group once when the group count is a power of two
+		for ( std::size_t probe{ 0 }; probe <= m_groupMask; ++probe )
+		{
+			const auto& candidate{ m_groups[group] };
+
+			for ( auto matches{ matchByte( candidate.ctrl, fragment ) }; matches != 0; matches &= matches - 1 )
+			{
+				const auto lane{ static_cast<std::size_t>( std::countr_zero( matches ) ) };
+				if ( m_equal( entryAt( candidate.entries[lane] ).key, key ) )
+				{
+					return group * GROUP_WIDTH + lane;
+				}
+			}
+
+			if ( matchByte( candidate.ctrl, CTRL_EMPTY ) != 0 )
+			{
+				break;
+			}
+
+			group = ( group + probe + 1 ) & m_groupMask;
+		}
+
+		return slotCount();
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	template <typename TKeyArg, typename... TArgs>
+	inline std::size_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::insertNew( std::size_t hash, TKeyArg&& key, TArgs&&... args )
+	{
+		const std::size_t groupCount{ m_groups ? m_groupMask + 1 : 0 };
+		if ( groupCount == 0 )
+		{
+			rehash( 1 );
+		}
+		else if ( m_size + m_tombstones + 1 > maxUsedSlots( groupCount ) )
+		{
+			// Reclaim tombstones in place unless the live entries need more room
+			rehash( m_size + 1 > maxLiveSlots( groupCount ) ? groupCount * 2 : groupCount );
+		}
+
+		const auto index{ allocateEntry() };
+		try
+		{
+			::new ( slotAt( index ).storage ) Entry( std::forward<TKeyArg>( key ), std::forward<TArgs>( args )... );
+		}
+		catch ( ... )
+		{
+			freeEntry( index );
+			throw;
+		}
+
+		const auto position{ findFreePosition( m_groups, m_groupMask, hash ) };
+		auto& group{ m_groups[position / GROUP_WIDTH] };
+		const auto lane{ position % GROUP_WIDTH };
+
+		if ( group.ctrl[lane] == CTRL_DELETED )
+		{
+			--m_tombstones;
+		}
+
+		group.ctrl[lane] = static_cast<std::uint8_t>( hash & 0x7F );
+		group.entries[lane] = index;
+		++m_size;
+
+		return position;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline std::size_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::findFreePosition( const Group* groups, std::size_t groupMask, std::size_t hash ) noexcept
+	{
+		auto group{ ( hash >> 7 ) & groupMask };
+
+		for ( std::size_t probe{ 0 };; ++probe )
+		{
+			if ( const auto free{ matchFree( groups[group].ctrl ) & SLOT_MASK }; free != 0 )
+			{
+				return group * GROUP_WIDTH + static_cast<std::size_t>( std::countr_zero( free ) );
+			}
+
+			group = ( group + probe + 1 ) & groupMask;
+		}
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline void FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::rehash( std::size_t groupCount )
+	{
+		GroupAllocator groupAllocator{ m_allocator };
+		const std::size_t oldGroupCount{ m_groups ? m_groupMask + 1 : 0 };
+
+		auto* groups{ std::allocator_traits<GroupAllocator>::allocate( groupAllocator, groupCount ) };
+		for ( std::size_t g{ 0 }; g < groupCount; ++g )
+		{
+			groups[g].ctrl.fill( CTRL_PADDING );
+			std::fill_n( groups[g].ctrl.begin(), GROUP_SLOTS, CTRL_EMPTY );
+		}
+
+		// Entries stay where they are, only their indices are redistributed. Hashes are not
+		// stored, so the new table is filled before the old one is released in case one throws
+		try
+		{
+			for ( std::size_t g{ 0 }; g < oldGroupCount; ++g )
+			{
+				for ( std::size_t lane{ 0 }; lane < GROUP_SLOTS; ++lane )
+				{
+					if ( ( m_groups[g].ctrl[lane] & 0x80 ) != 0 )
+					{
+						continue;
+					}
+
+					const auto index{ m_groups[g].entries[lane] };
+					const auto hash{ hashOf( entryAt( index ).key ) };
+					const auto position{ findFreePosition( groups, groupCount - 1, hash ) };
+
+					groups[position / GROUP_WIDTH].ctrl[position % GROUP_WIDTH] = static_cast<std::uint8_t>( hash & 0x7F );
+					groups[position / GROUP_WIDTH].entries[position % GROUP_WIDTH] = index;
+				}
+			}
+		}
+		catch ( ... )
+		{
+			std::allocator_traits<GroupAllocator>::deallocate( groupAllocator, groups, groupCount );
+			throw;
+		}
+
+		if ( m_groups )
+		{
+			std::allocator_traits<GroupAllocator>::deallocate( groupAllocator, m_groups, oldGroupCount );
+		}
+
+		m_groups = groups;
+		m_groupMask = groupCount - 1;
+		m_tombstones = 0;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline std::size_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::slotCount() const noexcept
+	{
+		return m_groups ? ( m_groupMask + 1 ) * GROUP_WIDTH : 0;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	constexpr std::size_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::maxUsedSlots( std::size_t groupCount ) noexcept
+	{
+		return groupCount * GROUP_SLOTS * 7 / 8;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	constexpr std::size_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::maxLiveSlots( std::size_t groupCount ) noexcept
+	{
+		return maxUsedSlots( groupCount ) * 3 / 4;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline std::size_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::nextOccupied( std::size_t position ) const noexcept
+	{
+		const auto end{ slotCount() };
+		while ( position < end && ( m_groups[position / GROUP_WIDTH].ctrl[position % GROUP_WIDTH] & 0x80 ) != 0 )
+		{
+			++position;
+		}
+
+		return position;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::Entry& FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::entryAtPosition( std::size_t position ) const noexcept
+	{
+		return entryAt( m_groups[position / GROUP_WIDTH].entries[position % GROUP_WIDTH] );
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::EntrySlot& FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::slotAt( std::uint32_t index ) const noexcept
+	{
+		if ( index < m_blockSize )
+		{
+			return m_block[index];
+		}
+
+		const auto offset{ index - m_blockSize };
+
+		return m_chunks[offset >> CHUNK_SHIFT]->slots[offset & ( CHUNK_SIZE - 1 )];
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline typename FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::Entry& FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::entryAt( std::uint32_t index ) const noexcept
+	{
+		return *std::launder( reinterpret_cast<Entry*>( slotAt( index ).storage ) );
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline std::uint32_t FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::allocateEntry()
+	{
+		if ( m_freeEntry != NO_ENTRY )
+		{
+			const auto index{ m_freeEntry };
+			m_freeEntry = *std::launder( reinterpret_cast<std::uint32_t*>( slotAt( index ).storage ) );
+
+			return index;
+		}
+
+		if ( m_nextEntry == NO_ENTRY )
+		{
+			throw std::length_error{ "FlatHashMap: entry count exceeds the 32-bit index range" };
+		}
+
+		if ( m_nextEntry >= m_blockSize && m_nextEntry - m_blockSize == m_chunks.size() * CHUNK_SIZE )
+		{
+			ChunkAllocator chunkAllocator{ m_allocator };
+			auto* chunk{ std::allocator_traits<ChunkAllocator>::allocate( chunkAllocator, 1 ) };
+
+			try
+			{
+				m_chunks.push_back( chunk );
+			}
+			catch ( ... )
+			{
+				std::allocator_traits<ChunkAllocator>::deallocate( chunkAllocator, chunk, 1 );
+				throw;
+			}
+		}
+
+		return static_cast<std::uint32_t>( m_nextEntry++ );
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline void FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::freeEntry( std::uint32_t index ) noexcept
+	{
+		::new ( slotAt( index ).storage ) std::uint32_t{ m_freeEntry };
+		m_freeEntry = index;
+	}
+
+	template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+	inline void FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>::destroyEntries() noexcept
+	{
+		for ( auto position{ nextOccupied( 0 ) }; position < slotCount(); position = nextOccupied( position + 1 ) )
+		{
+			entryAtPosition( position ).~Entry();
+		}
+	}
+} // namespace nfx::memory
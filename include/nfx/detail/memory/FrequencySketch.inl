@@ -0,0 +1,145 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file FrequencySketch.inl
+ * @brief Implementation of FrequencySketch
+ * @details Four-row count-min sketch packed in 64-bit words, aged by halving
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// FrequencySketch
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline FrequencySketch::FrequencySketch( std::size_t capacity )
+	{
+		ensureCapacity( capacity );
+	}
+
+	//----------------------------------------------
+	// Capacity
+	//----------------------------------------------
+
+	inline void FrequencySketch::ensureCapacity( std::size_t capacity )
+	{
+		// One word of 16 counters per entry keeps collisions rare with 4 counters per key
+		const auto words{ std::bit_ceil( std::max<std::size_t>( capacity, 16 ) ) };
+		if ( words <= m_table.size() )
+		{
+			return;
+		}
+
+		m_table.assign( words, 0 );
+		m_mask = words - 1;
+		m_sampleSize = SAMPLE_FACTOR * std::max<std::size_t>( capacity, 16 );
+		m_additions = 0;
+	}
+
+	//----------------------------------------------
+	// Counting
+	//----------------------------------------------
+
+	inline void FrequencySketch::increment( std::uint64_t hash ) noexcept
+	{
+		const auto spreadHash{ spread( hash ) };
+		bool added{ false };
+
+		for ( unsigned row{ 0 }; row < 4; ++row )
+		{
+			const auto [word, shift]{ counter( spreadHash, row ) };
+			if ( ( ( m_table[word] >> shift ) & 0xF ) < MAX_FREQUENCY )
+			{
+				m_table[word] += std::uint64_t{ 1 } << shift;
+				added = true;
+			}
+		}
+
+		if ( added && ++m_additions >= m_sampleSize )
+		{
+			age();
+		}
+	}
+
+	inline std::uint32_t FrequencySketch::frequency( std::uint64_t hash ) const noexcept
+	{
+		const auto spreadHash{ spread( hash ) };
+		std::uint32_t result{ MAX_FREQUENCY };
+
+		for ( unsigned row{ 0 }; row < 4; ++row )
+		{
+			const auto [word, shift]{ counter( spreadHash, row ) };
+			result = std::min( result, static_cast<std::uint32_t>( ( m_table[word] >> shift ) & 0xF ) );
+		}
+
+		return result;
+	}
+
+	inline void FrequencySketch::age() noexcept
+	{
+		for ( auto& word : m_table )
+		{
+			// Shift every counter right by one, dropping the bit that crosses into its neighbour
+			word = ( word >> 1 ) & 0x7777'7777'7777'7777ULL;
+		}
+
+		m_additions /= 2;
+	}
+
+	inline void FrequencySketch::clear() noexcept
+	{
+		std::fill( m_table.begin(), m_table.end(), 0 );
+		m_additions = 0;
+	}
+
+	//----------------------------------------------
+	// Hashing
+	//----------------------------------------------
+
+	constexpr std::uint64_t FrequencySketch::spread( std::uint64_t hash ) noexcept
+	{
+		// splitmix64 finalizer
+		hash = ( hash ^ ( hash >> 30 ) ) * 0xBF58'476D'1CE4'E5B9ULL;
+		hash = ( hash ^ ( hash >> 27 ) ) * 0x94D0'49BB'1331'11EBULL;
+
+		return hash ^ ( hash >> 31 );
+	}
+
+	inline std::pair<std::size_t, unsigned> FrequencySketch::counter( std::uint64_t spreadHash, unsigned row ) const noexcept
+	{
+		static constexpr std::uint64_t SEEDS[]{ 0xC3A5'C85C'97CB'3127ULL, 0xB492'B66F'BE98'F273ULL, 0x9AE1'6A3B'2F90'404FULL, 0xCBF2'9CE4'8422'2325ULL };
+
+		auto h{ ( spreadHash + SEEDS[row] ) * SEEDS[row] };
+		h ^= h >> 32;
+
+		// Low bits pick the word, the top 4 bits one of its 16 counters
+		return { static_cast<std::size_t>( h ) & m_mask, static_cast<unsigned>( h >> 60 ) * 4 };
+	}
+} // namespace nfx::memory
@@ -63,11 +63,118 @@ namespace nfx::memory
 		return m_slidingExpiration;
 	}
 
+	inline std::chrono::milliseconds LruCacheOptions::absoluteExpiration() const
+	{
+		return m_absoluteExpiration;
+	}
+
 	inline std::chrono::milliseconds LruCacheOptions::backgroundCleanupInterval() const
 	{
 		return m_backgroundCleanupInterval;
 	}
 
+	inline bool LruCacheOptions::readBuffering() const
+	{
+		return m_readBuffering;
+	}
+
+	inline std::size_t LruCacheOptions::maxWeight() const
+	{
+		return m_maxWeight;
+	}
+
+	inline bool LruCacheOptions::statisticsEnabled() const
+	{
+		return m_statisticsEnabled;
+	}
+
+	inline std::chrono::milliseconds LruCacheOptions::clockResolution() const
+	{
+		return m_clockResolution;
+	}
+
+	inline std::chrono::milliseconds LruCacheOptions::maintenanceInterval() const
+	{
+		return m_maintenanceInterval;
+	}
+
+	inline const std::shared_ptr<MaintenanceThread>& LruCacheOptions::maintenanceThread() const
+	{
+		return m_maintenanceThread;
+	}
+
+	inline std::chrono::milliseconds LruCacheOptions::refreshAfterWrite() const
+	{
+		return m_refreshAfterWrite;
+	}
+
+	inline const CacheExecutor& LruCacheOptions::refreshExecutor() const
+	{
+		return m_refreshExecutor;
+	}
+
+	//----------------------------------------------
+	// Modifiers
+	//----------------------------------------------
+
+	inline LruCacheOptions& LruCacheOptions::withSizeLimit( std::size_t sizeLimit ) noexcept
+	{
+		m_sizeLimit = sizeLimit;
+
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::withAbsoluteExpiration( std::chrono::milliseconds absoluteExpiration ) noexcept
+	{
+		m_absoluteExpiration = absoluteExpiration;
+
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::withMaxWeight( std::size_t maxWeight ) noexcept
+	{
+		m_maxWeight = maxWeight;
+
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::withReadBuffering( bool enabled ) noexcept
+	{
+		m_readBuffering = enabled;
+
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::withStatistics( bool enabled ) noexcept
+	{
+		m_statisticsEnabled = enabled;
+
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::withClockResolution( std::chrono::milliseconds resolution ) noexcept
+	{
+		m_clockResolution = resolution;
+
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::withMaintenance( std::chrono::milliseconds interval, std::shared_ptr<MaintenanceThread> thread ) noexcept
+	{
+		m_maintenanceInterval = interval;
+		m_maintenanceThread = std::move( thread );
+
+		return *this;
+	}
+
+	inline LruCacheOptions& LruCacheOptions::withRefreshAfterWrite( std::chrono::milliseconds refreshAfter, CacheExecutor executor ) noexcept
+	{
+		m_refreshAfterWrite = refreshAfter;
+		m_refreshExecutor = std::move( executor );
+
+		return *this;
+	}
+
 	//=====================================================================
 	// CacheEntry
 	//=====================================================================
@@ -77,7 +184,13 @@ namespace nfx::memory
 	//----------------------------------------------
 
 	inline CacheEntry::CacheEntry( std::chrono::milliseconds expiration )
-		: lastAccessed{ std::chrono::steady_clock::now() },
+		: CacheEntry{ expiration, std::chrono::steady_clock::now() }
+	{
+	}
+
+	inline CacheEntry::CacheEntry( std::chrono::milliseconds expiration, std::chrono::steady_clock::time_point now )
+		: lastAccessed{ now },
+		  writtenAt{ now },
 		  slidingExpiration{ expiration }
 	{
 	}
@@ -88,8 +201,51 @@ namespace nfx::memory
 
 	inline bool CacheEntry::isExpired() const noexcept
 	{
-		auto now{ std::chrono::steady_clock::now() };
-		return ( now - lastAccessed ) > slidingExpiration;
+		return isExpired( std::chrono::steady_clock::now() );
+	}
+
+	inline bool CacheEntry::isExpired( std::chrono::steady_clock::time_point now ) const noexcept
+	{
+		if ( absoluteExpiration.count() > 0 && hasElapsed( writtenAt, now, absoluteExpiration ) )
+		{
+			return true;
+		}
+
+		return hasElapsed( lastAccessed, now, slidingExpiration );
+	}
+
+	inline std::chrono::steady_clock::time_point CacheEntry::expiresAt() const noexcept
+	{
+		// Compare in milliseconds, converting a huge expiration to nanoseconds would overflow
+		const auto deadline{ []( std::chrono::steady_clock::time_point start, std::chrono::milliseconds expiration ) {
+			const auto remaining{ std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::time_point::max() - start ) };
+			if ( expiration >= remaining )
+			{
+				return std::chrono::steady_clock::time_point::max();
+			}
+
+			return start + expiration;
+		} };
+
+		const auto slidingDeadline{ deadline( lastAccessed, slidingExpiration ) };
+		if ( absoluteExpiration.count() <= 0 )
+		{
+			return slidingDeadline;
+		}
+
+		return std::min( slidingDeadline, deadline( writtenAt, absoluteExpiration ) );
+	}
+
+	inline bool CacheEntry::hasElapsed( std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point now,
+		std::chrono::milliseconds expiration ) noexcept
+	{
+		// Compare in milliseconds first, converting a huge expiration to nanoseconds would overflow
+		if ( expiration >= std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::duration::max() ) )
+		{
+			return false;
+		}
+
+		return ( now - start ) > expiration;
 	}
 
 	//----------------------------------------------
@@ -98,7 +254,12 @@ namespace nfx::memory
 
 	void inline CacheEntry::updateAccess() noexcept
 	{
-		lastAccessed = std::chrono::steady_clock::now();
+		updateAccess( std::chrono::steady_clock::now() );
+	}
+
+	void inline CacheEntry::updateAccess( std::chrono::steady_clock::time_point now ) noexcept
+	{
+		lastAccessed = now;
 	}
 
 	//=====================================================================
@@ -109,133 +270,295 @@ namespace nfx::memory
 	// Construction
 	//----------------------------------------------
 
-	template <typename TKey, typename TValue>
-	inline LruCache<TKey, TValue>::LruCache( const LruCacheOptions& options )
-		: m_options{ options },
-		  m_lruHead{ nullptr },
-		  m_lruTail{ nullptr },
-		  m_lastCleanupTime{ std::chrono::steady_clock::now() }
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::LruCache( const LruCacheOptions& options, const TAllocator& allocator )
+		: LruCache{ options, WeigherFunction{}, ReloadFunction{}, allocator }
 	{
-		if ( m_options.sizeLimit() > 0 )
-		{
-			m_cache.reserve( m_options.sizeLimit() );
-		}
 	}
 
-	//----------------------------------------------
-	// Cache operations
-	//----------------------------------------------
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::LruCache( const LruCacheOptions& options, WeigherFunction weigher, const TAllocator& allocator )
+		: LruCache{ options, std::move( weigher ), ReloadFunction{}, allocator }
+	{
+	}
 
-	template <typename TKey, typename TValue>
-	inline TValue& LruCache<TKey, TValue>::getOrCreate( const TKey& key, FactoryFunction factory, ConfigFunction configure )
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::LruCache( const LruCacheOptions& options, ReloadFunction reload, const TAllocator& allocator )
+		requires RefreshableValue<TValue>
+		: LruCache{ options, WeigherFunction{}, std::move( reload ), allocator }
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+	}
 
-		// Check for background cleanup opportunity
-		checkAndPerformBackgroundCleanup();
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::LruCache( const LruCacheOptions& options, WeigherFunction weigher, ReloadFunction reload,
+		const TAllocator& allocator )
+		: m_cache{ CacheAllocator{ allocator } },
+		  m_options{ options },
+		  m_policy{ options.maxWeight() > 0 ? options.maxWeight() : options.sizeLimit(), options.maxWeight() > 0 },
+		  m_lastCleanupTime{ std::chrono::steady_clock::now() }
+	{
+		m_weigher = std::move( weigher );
+		m_reload = std::move( reload );
 
-		auto it = m_cache.find( key );
-		if ( it != m_cache.end() )
+		if ( m_options.refreshAfterWrite().count() > 0 )
 		{
-			if ( !it->second.metadata.isExpired() )
+			if ( !RefreshableValue<TValue> )
 			{
-				it->second.metadata.updateAccess();	   // Reset expiration
-				moveToLruHead( &it->second.metadata ); // Mark as recent
-
-				return it->second.value;
+				throw std::invalid_argument{ "LruCache: refresh after write requires std::shared_ptr values" };
 			}
-			else
+
+			if ( !m_options.refreshExecutor() )
 			{
-				removeFromLru( &it->second.metadata ); // Clean expired
+				throw std::invalid_argument{ "LruCache: refresh after write requires an executor" };
+			}
 
-				m_cache.erase( it );
+			if ( !m_reload )
+			{
+				throw std::invalid_argument{ "LruCache: refresh after write requires a reload function" };
 			}
+
+			m_refreshGuard = std::make_shared<RefreshGuard>();
+			m_refreshGuard->cache = this;
+		}
+		else if ( m_reload )
+		{
+			throw std::invalid_argument{ "LruCache: a reload function requires refresh after write" };
 		}
 
-		TValue value{ factory() };
-		CacheEntry metadata{ m_options.slidingExpiration() };
+		if ( m_options.sizeLimit() > 0 )
+		{
+			m_cache.reserve( m_options.sizeLimit() );
+		}
 
-		if ( configure )
+		// Policies recording hits with atomic stores have nothing to buffer
+		if ( m_options.readBuffering() && !TPolicy<CacheEntry>::CONCURRENT_ACCESS )
 		{
-			configure( metadata );
+			m_readBuffers = std::make_unique<ReadBuffer[]>( READ_BUFFER_STRIPES );
 		}
 
-		if ( m_options.sizeLimit() > 0 && m_cache.size() >= m_options.sizeLimit() )
+		if ( m_options.statisticsEnabled() )
 		{
-			evictLeastRecentlyUsed();
+			m_statistics = std::make_unique<LruCacheStatistics>();
 		}
 
-		auto [insert_it, inserted]{ m_cache.try_emplace( key, std::move( value ), std::move( metadata ) ) };
-		insert_it->second.metadata.keyPtr = &insert_it->first;
-		addToLruHead( &insert_it->second.metadata );
+		if ( m_options.clockResolution().count() > 0 )
+		{
+			m_clock = CoarseClock::shared( m_options.clockResolution() );
+			m_lastCleanupTime = m_clock->now();
+			m_timerWheel = TimerWheel<CacheEntry>{ m_lastCleanupTime };
+		}
 
-		return insert_it->second.value;
+		if ( m_options.maintenanceInterval().count() > 0 )
+		{
+			m_maintenanceThread = m_options.maintenanceThread() ? m_options.maintenanceThread() : std::make_shared<MaintenanceThread>();
+			m_maintenanceTask = m_maintenanceThread->add( [this]() { performMaintenance(); }, m_options.maintenanceInterval() );
+		}
 	}
 
 	//----------------------------------------------
-	// Lookup operations
+	// Destruction
 	//----------------------------------------------
 
-	template <typename TKey, typename TValue>
-	inline std::optional<std::reference_wrapper<TValue>> LruCache<TKey, TValue>::tryGet( const TKey& key )
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::~LruCache()
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		if ( m_refreshGuard )
+		{
+			// Waits for running refreshes, queued ones find no cache
+			std::unique_lock<std::shared_mutex> lock{ m_refreshGuard->mutex };
+			m_refreshGuard->cache = nullptr;
+		}
 
-		// Check for background cleanup opportunity
-		checkAndPerformBackgroundCleanup();
+		if ( m_maintenanceThread )
+		{
+			m_maintenanceThread->remove( m_maintenanceTask );
+		}
+	}
+
+	//----------------------------------------------
+	// Cache operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure>
+	inline TValue& LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::getOrCreate( const TKey& key, TFactory&& factory, TConfigure&& configure )
+	{
+		return getOrCreateImpl( key, factory, configure );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup, CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure>
+		requires TransparentLookup<TLookup, TKey, THash, TKeyEqual> && std::constructible_from<TKey, const TLookup&>
+	inline TValue& LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::getOrCreate( const TLookup& key, TFactory&& factory, TConfigure&& configure )
+	{
+		return getOrCreateImpl( key, factory, configure );
+	}
 
-		auto it{ m_cache.find( key ) };
-		if ( it != m_cache.end() && !it->second.metadata.isExpired() )
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline TValue LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::get( const TKey& key )
+		requires RefreshableValue<TValue>
+	{
+		if ( !m_refreshGuard )
 		{
-			it->second.metadata.updateAccess();
-			moveToLruHead( &it->second.metadata );
+			throw std::logic_error{ "LruCache::get: refresh after write is not enabled" };
+		}
+
+		auto reload{ [this, &key]() { return m_reload( key ); } };
+		std::nullptr_t configure{};
+
+		return getOrCreateValue( key, reload, configure );
+	}
+
+	//----------------------------------------------
+	// Coroutine operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLoader, CacheEntryConfigurator TConfigure>
+		requires std::invocable<std::decay_t<TLoader>&> && std::move_constructible<std::decay_t<TLoader>>
+	inline typename LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::template LoadAwaiter<std::decay_t<TLoader>, std::decay_t<TConfigure>> LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::getOrLoad( const TKey& key, TLoader&& loader, TConfigure&& configure )
+	{
+		requireReferenceLookups();
+
+		return LoadAwaiter<std::decay_t<TLoader>, std::decay_t<TConfigure>>{ *this, key, std::forward<TLoader>( loader ), std::forward<TConfigure>( configure ) };
+	}
+
+	//----------------------------------------------
+	// Lookup operations
+	//----------------------------------------------
 
-			return std::ref( it->second.value );
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::optional<std::reference_wrapper<TValue>> LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::tryGet( const TKey& key )
+	{
+		requireReferenceLookups();
+
+		return tryGetImpl<std::optional<std::reference_wrapper<TValue>>>( key );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup>
+		requires TransparentLookup<TLookup, TKey, THash, TKeyEqual>
+	inline std::optional<std::reference_wrapper<TValue>> LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::tryGet( const TLookup& key )
+	{
+		requireReferenceLookups();
+
+		return tryGetImpl<std::optional<std::reference_wrapper<TValue>>>( key );
+	}
+
+	//----------------------------------------------
+	// Batch operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::vector<bool> LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::tryGetMany( std::span<const TKey> keys,
+		std::span<std::optional<std::reference_wrapper<TValue>>> values )
+	{
+		if ( values.size() < keys.size() )
+		{
+			throw std::invalid_argument{ "LruCache::tryGetMany: fewer values than keys" };
 		}
 
-		if ( it != m_cache.end() )
+		requireReferenceLookups();
+
+		std::vector<bool> hits( keys.size(), false );
+		if ( !keys.empty() )
 		{
-			removeFromLru( &it->second.metadata );
+			tryGetBatch( keys, std::views::iota( std::size_t{ 0 }, keys.size() ), values, hits );
+		}
 
-			m_cache.erase( it );
+		return hits;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <CacheEntryConfigurator TConfigure>
+	inline std::vector<bool> LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::insertMany( std::span<std::pair<TKey, TValue>> entries, TConfigure&& configure )
+	{
+		std::vector<bool> inserted( entries.size(), false );
+		if ( !entries.empty() )
+		{
+			insertBatch( entries, std::views::iota( std::size_t{ 0 }, entries.size() ), configure, inserted );
 		}
 
-		return std::nullopt;
+		return inserted;
 	}
 
 	//----------------------------------------------
 	// Modification operations
 	//----------------------------------------------
 
-	template <typename TKey, typename TValue>
-	inline bool LruCache<TKey, TValue>::remove( const TKey& key )
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::remove( const TKey& key )
+	{
+		return removeImpl( key );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup>
+		requires TransparentLookup<TLookup, TKey, THash, TKeyEqual>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::remove( const TLookup& key )
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		return removeImpl( key );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TPredicate>
+		requires std::predicate<TPredicate&, const TValue&>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::removeIf( const TKey& key, TPredicate&& predicate )
+	{
+		ExclusiveLock lock{ *this };
+
+		drainReadBuffers();
 
 		auto it = m_cache.find( key );
-		if ( it != m_cache.end() )
+		if ( it != m_cache.end() && std::invoke( predicate, std::as_const( it->second.value ) ) )
 		{
-			removeFromLru( &it->second.metadata );
-			m_cache.erase( it );
+			eraseItem( it, RemovalCause::Explicit );
 			return true;
 		}
 
 		return false;
 	}
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::clear()
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::clear()
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		ExclusiveLock lock{ *this };
+
+		// Pending promotions would point at destroyed entries
+		if ( m_readBuffers )
+		{
+			for ( std::size_t i{ 0 }; i < READ_BUFFER_STRIPES; ++i )
+			{
+				m_readBuffers[i].writeCount.store( 0, std::memory_order_relaxed );
+			}
+		}
+
+		if ( m_removalListener )
+		{
+			m_pendingRemovals.reserve( m_pendingRemovals.size() + m_cache.size() );
+
+			// One pass: begin() of flat storage scans the control bytes from the first slot
+			for ( auto it{ m_cache.begin() }; it != m_cache.end(); )
+			{
+				auto next{ std::next( it ) };
+				auto node{ m_cache.extract( it ) };
+				m_pendingRemovals.push_back( { std::move( node.key() ), std::move( node.mapped().value ), RemovalCause::Cleared } );
+				it = next;
+			}
+		}
+
 		m_cache.clear();
-		m_lruHead = nullptr;
-		m_lruTail = nullptr;
+		m_timerWheel.clear();
+		m_policy.clear();
+		subtractWeight( m_totalWeight );
+		m_customExpirationCount = 0;
+		m_cleanupPending = false;
 	}
 
-	template <typename TKey, typename TValue>
-	inline std::size_t LruCache<TKey, TValue>::size() const
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::size_t LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::size() const
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		std::shared_lock<std::shared_mutex> lock{ m_mutex };
 
 		return m_cache.size();
 	}
@@ -244,161 +567,1336 @@ namespace nfx::memory
 	// State inspection
 	//----------------------------------------------
 
-	template <typename TKey, typename TValue>
-	inline bool LruCache<TKey, TValue>::isEmpty() const
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::size_t LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::totalWeight() const
+	{
+		std::shared_lock<std::shared_mutex> lock{ m_mutex };
+
+		return m_totalWeight;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::isEmpty() const
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		std::shared_lock<std::shared_mutex> lock{ m_mutex };
 
 		return m_cache.empty();
 	}
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::cleanupExpired()
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::cleanupExpired()
 	{
-		std::lock_guard<std::mutex> lock{ m_mutex };
+		ExclusiveLock lock{ *this };
 
-		auto it = m_cache.begin();
-		while ( it != m_cache.end() )
-		{
-			if ( it->second.metadata.isExpired() )
-			{
-				removeFromLru( &it->second.metadata );
-				it = m_cache.erase( it );
-			}
-			else
-			{
-				++it;
-			}
-		}
+		drainReadBuffers();
+
+		expireDue( currentTime() );
+		m_cleanupPending = false;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline LruCacheStatisticsSnapshot LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::stats() const noexcept
+	{
+		return m_statistics ? m_statistics->snapshot() : LruCacheStatisticsSnapshot{};
+	}
+
+	//----------------------------------------------
+	// Removal notification
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::setRemovalListener( RemovalListener listener )
+	{
+		ExclusiveLock lock{ *this };
+
+		m_removalListener = listener ? std::make_shared<const RemovalListener>( std::move( listener ) ) : nullptr;
 	}
 
 	//----------------------------------------------
 	// Internal data structures
 	//----------------------------------------------
 
-	template <typename TKey, typename TValue>
-	LruCache<TKey, TValue>::CachedItem::CachedItem( TValue val, CacheEntry meta )
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::CachedItem::CachedItem( TValue val, CacheEntry meta )
 		: value{ std::move( val ) },
 		  metadata{ std::move( meta ) }
 	{
 	}
 
 	//----------------------------------------------
-	// LRU list management
+	// Eviction policy
 	//----------------------------------------------
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::addToLruHead( CacheEntry* entry ) noexcept
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::recordAccess( CacheEntry* entry )
 	{
-		entry->lruNext = m_lruHead;
-		entry->lruPrev = nullptr;
+		m_policy.onAccess( entry, [this, entry]() { return keyHash( entry ); } );
+	}
 
-		if ( m_lruHead != nullptr )
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::evictVictim()
+	{
+		auto* victim{ m_policy.victim( [this]( const CacheEntry* entry ) { return keyHash( entry ); } ) };
+		if ( victim == nullptr )
 		{
-			m_lruHead->lruPrev = entry;
+			return;
 		}
-		else
+
+		const TKey* keyPtr{ static_cast<const TKey*>( victim->keyPtr ) };
+		if ( keyPtr != nullptr )
 		{
-			m_lruTail = entry;
+			eraseItem( m_cache.find( *keyPtr ), RemovalCause::Size );
 		}
+	}
 
-		m_lruHead = entry;
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::uint64_t LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::keyHash( const CacheEntry* entry ) const
+	{
+		return static_cast<std::uint64_t>( m_cache.hash_function()( *static_cast<const TKey*>( entry->keyPtr ) ) );
 	}
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::removeFromLru( CacheEntry* entry ) noexcept
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::evictForInsertion( std::size_t weight )
 	{
-		if ( entry->lruPrev != nullptr )
-		{
-			entry->lruPrev->lruNext = entry->lruNext;
-		}
-		else
+		if ( m_options.sizeLimit() > 0 && m_cache.size() >= m_options.sizeLimit() )
 		{
-			m_lruHead = entry->lruNext;
+			evictVictim();
 		}
 
-		if ( entry->lruNext != nullptr )
+		if ( m_options.maxWeight() > 0 )
 		{
-			entry->lruNext->lruPrev = entry->lruPrev;
-		}
-		else
-		{
-			m_lruTail = entry->lruPrev;
+			while ( !m_cache.empty() && m_totalWeight + weight > m_options.maxWeight() )
+			{
+				evictVictim();
+			}
 		}
-
-		entry->lruNext = nullptr;
-		entry->lruPrev = nullptr;
 	}
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::moveToLruHead( CacheEntry* entry ) noexcept
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::evictForSharedWeight()
 	{
-		if ( entry == m_lruHead )
+		ExclusiveLock lock{ *this };
+
+		drainReadBuffers();
+
+		const auto size{ m_cache.size() };
+		if ( size > 0 )
 		{
-			return;
+			evictVictim();
 		}
 
-		removeFromLru( entry );
-		addToLruHead( entry );
+		return m_cache.size() < size;
 	}
 
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::evictLeastRecentlyUsed()
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::addWeight( std::size_t weight ) noexcept
 	{
-		if ( m_lruTail == nullptr )
-		{
-			return;
-		}
+		m_totalWeight += weight;
 
-		const TKey* keyPtr{ static_cast<const TKey*>( m_lruTail->keyPtr ) };
-		if ( keyPtr != nullptr )
+		if ( m_sharedWeight )
 		{
-			removeFromLru( m_lruTail );
-			m_cache.erase( *keyPtr );
+			m_sharedWeight->fetch_add( weight, std::memory_order_relaxed );
 		}
 	}
 
-	//----------------------------------------------
-	// Background cleanup implementation
-	//----------------------------------------------
-
-	template <typename TKey, typename TValue>
-	inline void LruCache<TKey, TValue>::checkAndPerformBackgroundCleanup() const
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::subtractWeight( std::size_t weight ) noexcept
 	{
-		// Skip if background cleanup is disabled
-		if ( m_options.backgroundCleanupInterval().count() <= 0 )
+		m_totalWeight -= weight;
+
+		if ( m_sharedWeight )
 		{
-			return;
+			m_sharedWeight->fetch_sub( weight, std::memory_order_relaxed );
 		}
+	}
 
-		auto now = std::chrono::steady_clock::now();
-		auto timeSinceLastCleanup = now - m_lastCleanupTime;
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline typename LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::CacheMap::iterator LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::eraseItem( typename CacheMap::iterator it, RemovalCause cause )
+	{
+		m_policy.onRemove( &it->second.metadata );
+		m_timerWheel.deschedule( &it->second.metadata );
+		subtractWeight( it->second.metadata.size );
+
+		if ( hasCustomExpiration( it->second.metadata ) )
+		{
+			--m_customExpirationCount;
+		}
+
+		if ( m_statistics )
+		{
+			if ( cause == RemovalCause::Size )
+			{
+				m_statistics->recordEvictions();
+			}
+			else if ( cause == RemovalCause::Expired )
+			{
+				m_statistics->recordExpirations();
+			}
+		}
+
+		if ( !m_removalListener && !m_maintenanceThread )
+		{
+			return m_cache.erase( it );
+		}
+
+		if ( !m_removalListener )
+		{
+			// Destroyed by the next maintenance run, outside the lock, unless too many are waiting
+			auto next{ std::next( it ) };
+			if ( m_deferred.size() >= MAX_DEFERRED_ENTRIES )
+			{
+				m_cache.erase( it );
+			}
+			else if constexpr ( DEFER_NODES )
+			{
+				m_deferred.push_back( m_cache.extract( it ) );
+			}
+			else
+			{
+				m_deferred.push_back( std::move( it->second.value ) );
+				m_cache.erase( it );
+			}
+
+			return next;
+		}
+
+		// Move key and value out of the node, they are handed to the listener after unlock
+		auto next{ std::next( it ) };
+		auto node{ m_cache.extract( it ) };
+		m_pendingRemovals.push_back( { std::move( node.key() ), std::move( node.mapped().value ), cause } );
+
+		return next;
+	}
+
+	//----------------------------------------------
+	// Expiration
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::hasCustomExpiration( const CacheEntry& entry ) const noexcept
+	{
+		return entry.slidingExpiration != m_options.slidingExpiration() || entry.absoluteExpiration.count() > 0;
+	}
 
-		if ( timeSinceLastCleanup >= m_options.backgroundCleanupInterval() )
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::expireDue( std::chrono::steady_clock::time_point now, std::size_t budget )
+	{
+		if constexpr ( TPolicy<CacheEntry>::RECENCY_ORDERED )
 		{
-			m_lastCleanupTime = now;
+			if ( m_customExpirationCount == 0 )
+			{
+				// Every entry expires the same time after its last access and only then, so the oldest expires first
+				for ( auto* oldest{ m_policy.oldest() }; oldest != nullptr && oldest->isExpired( now ); oldest = m_policy.oldest() )
+				{
+					if ( budget == 0 )
+					{
+						return false;
+					}
+					--budget;
+
+					eraseItem( m_cache.find( *static_cast<const TKey*>( oldest->keyPtr ) ), RemovalCause::Expired );
+				}
+
+				return true;
+			}
+		}
+
+		return m_timerWheel.advance( now, [this, now]( CacheEntry* entry ) {
+			if ( !entry->isExpired( now ) )
+			{
+				// Accessed since it was filed: accesses only push the deadline back, so entries
+				// are moved to their new bucket here rather than on every hit
+				m_timerWheel.schedule( entry, entry->expiresAt() );
+
+				return;
+			}
 
-			// Perform incremental cleanup of expired entries
-			// Note: We need to cast away const since we're modifying the cache
-			// This is safe because the method is called from within locked operations
-			auto* self = const_cast<LruCache<TKey, TValue>*>( this );
+			eraseItem( m_cache.find( *static_cast<const TKey*>( entry->keyPtr ) ), RemovalCause::Expired );
+		}, budget );
+	}
+
+	//----------------------------------------------
+	// Lookup implementation
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup, typename TFactory, typename TConfigure>
+	inline TValue& LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::getOrCreateImpl( const TLookup& key, TFactory& factory, TConfigure& configure )
+	{
+		requireReferenceLookups();
+
+		if ( auto* value{ sharedHit( key, nullptr ) } )
+		{
+			return *value;
+		}
 
-			size_t cleanedCount = 0;
+		while ( true )
+		{
+			auto start{ startLoad( key, nullptr ) };
+			if ( start.hit )
+			{
+				return *start.hit;
+			}
 
-			auto it = self->m_cache.begin();
-			while ( it != self->m_cache.end() && cleanedCount < MAX_CLEANUP_PER_CYCLE )
+			if ( !start.ownedKey )
 			{
-				if ( it->second.metadata.isExpired() )
+				start.flight->done.wait( false, std::memory_order_acquire );
+
+				if ( start.flight->error )
 				{
-					self->removeFromLru( &it->second.metadata );
-					it = self->m_cache.erase( it );
-					++cleanedCount;
+					std::rethrow_exception( start.flight->error );
 				}
-				else
+
+				// Look the value up again, it may already have been evicted
+				continue;
+			}
+
+			TValue* result{ nullptr };
+			try
+			{
+				result = &insertLoaded( start, loadValue( factory ), configure );
+			}
+			catch ( ... )
+			{
+				abandonFlight( *start.ownedKey, start.flight, std::current_exception() );
+				throw;
+			}
+
+			completeFlight( *start.flight, nullptr );
+
+			return *result;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TFactory, typename TConfigure>
+		requires std::copy_constructible<TValue>
+	inline TValue LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::getOrCreateValue( const TKey& key, TFactory& factory, TConfigure& configure )
+	{
+		std::optional<TValue> value;
+		if ( sharedHit( key, &value ) )
+		{
+			return std::move( *value );
+		}
+
+		while ( true )
+		{
+			auto start{ startLoad( key, &value ) };
+			if ( start.hit )
+			{
+				if ( start.ownedKey )
+				{
+					startRefresh( start );
+				}
+
+				return std::move( *value );
+			}
+
+			if ( !start.ownedKey )
+			{
+				start.flight->done.wait( false, std::memory_order_acquire );
+
+				if ( start.flight->error )
+				{
+					std::rethrow_exception( start.flight->error );
+				}
+
+				// Look the value up again, it may already have been evicted
+				continue;
+			}
+
+			try
+			{
+				// Copied before it is cached, it may be replaced or evicted as soon as the lock is released
+				value.emplace( loadValue( factory ) );
+				insertLoaded( start, TValue{ *value }, configure );
+			}
+			catch ( ... )
+			{
+				abandonFlight( *start.ownedKey, start.flight, std::current_exception() );
+				throw;
+			}
+
+			completeFlight( *start.flight, nullptr );
+
+			return std::move( *value );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::optional<TValue> LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::tryGetValue( const TKey& key )
+		requires std::copy_constructible<TValue>
+	{
+		return tryGetImpl<std::optional<TValue>>( key );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup>
+	inline TValue* LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::sharedHit( const TLookup& key, std::optional<TValue>* copy )
+	{
+		if ( !sharedHits() )
+		{
+			return nullptr;
+		}
+
+		std::shared_lock<std::shared_mutex> sharedLock{ m_mutex };
+
+		const auto now{ currentTime() };
+		auto* item{ tryGetShared( m_cache.find( key ), now ) };
+		if ( !item )
+		{
+			return nullptr;
+		}
+
+		if ( copy )
+		{
+			// A stale value not being refreshed yet registers its refresh on the exclusive path
+			if ( refreshDue( item->metadata, now ) && m_inFlight.find( key ) == m_inFlight.end() )
+			{
+				return nullptr;
+			}
+
+			if constexpr ( std::copy_constructible<TValue> )
+			{
+				copy->emplace( item->value );
+			}
+		}
+
+		if ( m_statistics )
+		{
+			m_statistics->recordHits();
+		}
+
+		return &item->value;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup>
+	inline typename LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::LoadStart LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::startLoad( const TLookup& key, std::optional<TValue>* copy )
+	{
+		LoadStart start;
+
+		ExclusiveLock lock{ *this };
+
+		// Replay buffered hits before the LRU list or the map is modified
+		drainReadBuffers();
+
+		const auto now{ currentTime() };
+
+		// Check for background cleanup opportunity
+		checkAndPerformBackgroundCleanup( now );
+
+		auto it = m_cache.find( key );
+		if ( it != m_cache.end() )
+		{
+			if ( !it->second.metadata.isExpired( now ) )
+			{
+				it->second.metadata.updateAccess( now ); // Reset expiration
+				recordAccess( &it->second.metadata );    // Mark as recent
+
+				if ( m_statistics )
+				{
+					m_statistics->recordHits();
+				}
+
+				start.hit = &it->second.value;
+
+				if ( copy )
+				{
+					if constexpr ( std::copy_constructible<TValue> )
+					{
+						copy->emplace( it->second.value );
+					}
+
+					// Serve the stale value and become its single refresher
+					if ( refreshDue( it->second.metadata, now ) && m_inFlight.find( key ) == m_inFlight.end() )
+					{
+						start.ownedKey.emplace( key );
+						start.flight = m_inFlight.emplace( *start.ownedKey, std::make_shared<InFlight>() ).first->second;
+					}
+				}
+
+				return start;
+			}
+			else
+			{
+				eraseItem( it, RemovalCause::Expired ); // Clean expired
+			}
+		}
+
+		// Join the call already loading this key, or become the loader
+		auto flightIt{ m_inFlight.find( key ) };
+		if ( flightIt != m_inFlight.end() )
+		{
+			start.flight = flightIt->second;
+		}
+		else
+		{
+			// The only place a heterogeneous key is converted
+			start.ownedKey.emplace( key );
+			start.flight = m_inFlight.emplace( *start.ownedKey, std::make_shared<InFlight>() ).first->second;
+
+			if ( m_statistics )
+			{
+				m_statistics->recordMisses();
+			}
+		}
+
+		return start;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TConfigure>
+	inline TValue& LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::insertLoaded( LoadStart& start, TValue&& value, TConfigure& configure )
+	{
+		ExclusiveLock lock{ *this };
+
+		drainReadBuffers();
+		m_inFlight.erase( *start.ownedKey );
+
+		// A moved-from key cannot match another registration in abandonFlight()
+		return insertItem( std::move( *start.ownedKey ), std::move( value ), configure );
+	}
+
+	//----------------------------------------------
+	// Refresh implementation
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::startRefresh( LoadStart& start )
+	{
+		try
+		{
+			m_options.refreshExecutor()( [guard{ m_refreshGuard }, key{ *start.ownedKey }, flight{ start.flight }]() {
+				std::shared_lock<std::shared_mutex> lock{ guard->mutex };
+
+				if ( guard->cache )
+				{
+					guard->cache->refreshValue( key, flight );
+				}
+			} );
+		}
+		catch ( ... )
+		{
+			abandonFlight( *start.ownedKey, start.flight, std::current_exception() );
+			throw;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::refreshValue( const TKey& key, const std::shared_ptr<InFlight>& flight ) noexcept
+	{
+		try
+		{
+			auto reload{ [this, &key]() { return m_reload( key ); } };
+			TValue value{ loadValue( reload ) };
+
+			ExclusiveLock lock{ *this };
+
+			drainReadBuffers();
+			m_inFlight.erase( key );
+
+			// An entry removed meanwhile stays removed
+			auto it{ m_cache.find( key ) };
+			if ( it != m_cache.end() )
+			{
+				replaceValue( it, std::move( value ) );
+			}
+		}
+		catch ( ... )
+		{
+			abandonFlight( key, flight, std::current_exception() );
+
+			return;
+		}
+
+		completeFlight( *flight, nullptr );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::replaceValue( typename CacheMap::iterator it, TValue&& value )
+	{
+		auto& item{ it->second };
+
+		// Weighed first, a throwing weigher leaves the entry untouched
+		const auto weight{ m_weigher ? m_weigher( it->first, value ) : item.metadata.size };
+
+		if ( m_removalListener )
+		{
+			m_pendingRemovals.push_back( { it->first, std::move( item.value ), RemovalCause::Replaced } );
+		}
+
+		// Only the handle is swapped, readers keep the value they copied
+		item.value = std::move( value );
+		item.metadata.writtenAt = currentTime();
+
+		if ( weight == item.metadata.size )
+		{
+			return;
+		}
+
+		// Policies account the weight of their entries, so the entry is reinserted at its new weight
+		m_policy.onRemove( &item.metadata );
+		const auto oldWeight{ item.metadata.size };
+		item.metadata.size = weight;
+		try
+		{
+			m_policy.onInsert( &item.metadata, [this, &item]() { return keyHash( &item.metadata ); } );
+		}
+		catch ( ... )
+		{
+			// A policy that throws never linked the entry, so it is dropped
+			m_timerWheel.deschedule( &item.metadata );
+			subtractWeight( oldWeight );
+			if ( hasCustomExpiration( item.metadata ) )
+			{
+				--m_customExpirationCount;
+			}
+			m_cache.erase( it );
+			throw;
+		}
+		subtractWeight( oldWeight );
+		addWeight( weight );
+
+		while ( m_options.maxWeight() > 0 && m_cache.size() > 1 && m_totalWeight > m_options.maxWeight() )
+		{
+			evictVictim();
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::refreshDue( const CacheEntry& entry, std::chrono::steady_clock::time_point now ) const noexcept
+	{
+		return m_refreshGuard != nullptr && now - entry.writtenAt >= m_options.refreshAfterWrite();
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::requireReferenceLookups() const
+	{
+		if ( m_refreshGuard )
+		{
+			throw std::logic_error{ "LruCache: a refreshing cache hands out values by copy, use get()" };
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLoader, typename TConfigure>
+	inline CacheTask<TValue*> LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::loadAsync( TKey key, LoadStart start, TLoader loader, TConfigure configure )
+	{
+		while ( !start.hit )
+		{
+			if ( !start.ownedKey )
+			{
+				co_await FlightAwaiter{ *start.flight };
+
+				if ( start.flight->error )
+				{
+					std::rethrow_exception( start.flight->error );
+				}
+
+				// Look the value up again, it may already have been evicted
+				start = startLoad( key, nullptr );
+
+				continue;
+			}
+
+			std::optional<TValue> value;
+			const auto loadStart{ std::chrono::steady_clock::now() };
+			try
+			{
+				value.emplace( co_await std::invoke( loader ) );
+			}
+			catch ( ... )
+			{
+				if ( m_statistics )
 				{
-					++it;
+					m_statistics->recordLoadFailure( std::chrono::steady_clock::now() - loadStart );
 				}
+
+				abandonFlight( *start.ownedKey, start.flight, std::current_exception() );
+				throw;
+			}
+
+			if ( m_statistics )
+			{
+				m_statistics->recordLoadSuccess( std::chrono::steady_clock::now() - loadStart );
+			}
+
+			TValue* result{ nullptr };
+			try
+			{
+				result = &insertLoaded( start, std::move( *value ), configure );
+			}
+			catch ( ... )
+			{
+				abandonFlight( *start.ownedKey, start.flight, std::current_exception() );
+				throw;
 			}
+
+			completeFlight( *start.flight, nullptr );
+
+			co_return result;
 		}
+
+		co_return start.hit;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TResult, typename TLookup>
+	inline TResult LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::tryGetImpl( const TLookup& key )
+	{
+		if ( sharedHits() )
+		{
+			std::shared_lock<std::shared_mutex> sharedLock{ m_mutex };
+
+			const auto now{ currentTime() };
+			const auto it{ m_cache.find( key ) };
+			if ( auto* item{ tryGetShared( it, now ) } )
+			{
+				if ( m_statistics )
+				{
+					m_statistics->recordHits();
+				}
+
+				return TResult{ std::in_place, item->value };
+			}
+
+			// A plain miss needs no exclusive work unless cleanup is due or the policy records it
+			if ( !TPolicy<CacheEntry>::RECORDS_MISSES && it == m_cache.end() && !isBackgroundCleanupDue( now ) )
+			{
+				if ( m_statistics )
+				{
+					m_statistics->recordMisses();
+				}
+
+				return std::nullopt;
+			}
+		}
+
+		ExclusiveLock lock{ *this };
+
+		drainReadBuffers();
+
+		const auto now{ currentTime() };
+
+		// Check for background cleanup opportunity
+		checkAndPerformBackgroundCleanup( now );
+
+		auto* item{ lookupExclusive( key, m_cache.find( key ), now ) };
+
+		if ( m_statistics )
+		{
+			item != nullptr ? m_statistics->recordHits() : m_statistics->recordMisses();
+		}
+
+		return item != nullptr ? TResult{ std::in_place, item->value } : std::nullopt;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup>
+	inline typename LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::CachedItem* LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::lookupExclusive( const TLookup& key, typename CacheMap::iterator it, std::chrono::steady_clock::time_point now )
+	{
+		if ( it != m_cache.end() && !it->second.metadata.isExpired( now ) )
+		{
+			it->second.metadata.updateAccess( now );
+			recordAccess( &it->second.metadata );
+
+			return &it->second;
+		}
+
+		if ( it != m_cache.end() )
+		{
+			eraseItem( it, RemovalCause::Expired );
+		}
+
+		m_policy.onMiss( [this, &key]() { return static_cast<std::uint64_t>( m_cache.hash_function()( key ) ); } );
+
+		return nullptr;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TIndices>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::tryGetBatch( std::span<const TKey> keys, const TIndices& indices,
+		std::span<std::optional<std::reference_wrapper<TValue>>> values, std::vector<bool>& hits )
+	{
+		std::uint64_t hitCount{ 0 };
+		std::uint64_t missCount{ 0 };
+
+		// Positions the shared pass could not settle, every position when there is no shared pass
+		std::vector<std::size_t> pending;
+
+		if ( sharedHits() )
+		{
+			std::shared_lock<std::shared_mutex> sharedLock{ m_mutex };
+
+			const auto now{ currentTime() };
+			const bool settleMisses{ !TPolicy<CacheEntry>::RECORDS_MISSES && !isBackgroundCleanupDue( now ) };
+
+			findBatch( keys, indices, [&]( std::size_t index, typename CacheMap::iterator it ) {
+				if ( auto* item{ tryGetShared( it, now ) } )
+				{
+					values[index] = std::ref( item->value );
+					hits[index] = true;
+					++hitCount;
+				}
+				else if ( settleMisses && it == m_cache.end() )
+				{
+					values[index] = std::nullopt;
+					++missCount;
+				}
+				else
+				{
+					pending.push_back( index );
+				}
+			} );
+		}
+		else
+		{
+			pending.reserve( std::ranges::size( indices ) );
+			std::ranges::copy( indices, std::back_inserter( pending ) );
+		}
+
+		if ( !pending.empty() )
+		{
+			ExclusiveLock lock{ *this };
+
+			drainReadBuffers();
+
+			const auto now{ currentTime() };
+
+			checkAndPerformBackgroundCleanup( now );
+
+			findBatch( keys, pending, [&]( std::size_t index, typename CacheMap::iterator it ) {
+				if ( auto* item{ lookupExclusive( keys[index], it, now ) } )
+				{
+					values[index] = std::ref( item->value );
+					hits[index] = true;
+					++hitCount;
+				}
+				else
+				{
+					values[index] = std::nullopt;
+					++missCount;
+				}
+			} );
+		}
+
+		if ( m_statistics )
+		{
+			m_statistics->recordHits( hitCount );
+			m_statistics->recordMisses( missCount );
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TIndices, typename TVisit>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::findBatch( std::span<const TKey> keys, const TIndices& indices, TVisit&& visit )
+	{
+		if constexpr ( requires( CacheMap& map, const TKey& key, std::size_t hash ) {
+							   map.prefetchGroup( hash );
+							   map.prefetchEntries( hash );
+							   map.find( key, map.hash( key ) );
+						   } )
+		{
+			std::array<std::size_t, BATCH_PREFETCH_WINDOW> window;
+			std::array<std::size_t, BATCH_PREFETCH_WINDOW> hashes;
+
+			auto next{ std::ranges::begin( indices ) };
+			const auto last{ std::ranges::end( indices ) };
+
+			while ( next != last )
+			{
+				std::size_t count{ 0 };
+				for ( ; next != last && count < BATCH_PREFETCH_WINDOW; ++next, ++count )
+				{
+					window[count] = *next;
+					hashes[count] = m_cache.hash( keys[window[count]] );
+				}
+
+				// Issue every group load of the window before waiting on any of them
+				for ( std::size_t i{ 0 }; i < count; ++i )
+				{
+					m_cache.prefetchGroup( hashes[i] );
+				}
+
+				for ( std::size_t i{ 0 }; i < count; ++i )
+				{
+					m_cache.prefetchEntries( hashes[i] );
+				}
+
+				for ( std::size_t i{ 0 }; i < count; ++i )
+				{
+					visit( window[i], m_cache.find( keys[window[i]], hashes[i] ) );
+				}
+			}
+		}
+		else
+		{
+			for ( const auto index : indices )
+			{
+				visit( index, m_cache.find( keys[index] ) );
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TIndices, typename TConfigure>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::insertBatch( std::span<std::pair<TKey, TValue>> entries, const TIndices& indices,
+		TConfigure& configure, std::vector<bool>& inserted )
+	{
+		ExclusiveLock lock{ *this };
+
+		drainReadBuffers();
+
+		const auto now{ currentTime() };
+
+		checkAndPerformBackgroundCleanup( now );
+
+		for ( const auto index : indices )
+		{
+			auto& [key, value]{ entries[index] };
+
+			if ( auto it{ m_cache.find( key ) }; it != m_cache.end() )
+			{
+				if ( !it->second.metadata.isExpired( now ) )
+				{
+					continue;
+				}
+
+				eraseItem( it, RemovalCause::Expired );
+			}
+
+			insertItem( std::move( key ), std::move( value ), configure );
+			inserted[index] = true;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::removeImpl( const TLookup& key )
+	{
+		ExclusiveLock lock{ *this };
+
+		drainReadBuffers();
+
+		auto it = m_cache.find( key );
+		if ( it != m_cache.end() )
+		{
+			eraseItem( it, RemovalCause::Explicit );
+			return true;
+		}
+
+		return false;
+	}
+
+	//----------------------------------------------
+	// Insertion and loading
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TConfigure>
+	inline TValue& LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::insertItem( TKey&& key, TValue&& value, TConfigure& configure )
+	{
+		auto existing{ m_cache.find( key ) };
+		if ( existing != m_cache.end() )
+		{
+			return existing->second.value;
+		}
+
+		CacheEntry metadata{ m_options.slidingExpiration(), currentTime() };
+		metadata.absoluteExpiration = m_options.absoluteExpiration();
+
+		if constexpr ( std::is_null_pointer_v<std::remove_cvref_t<TConfigure>> )
+		{
+			// No configuration requested
+		}
+		else if constexpr ( std::is_constructible_v<bool, TConfigure&> )
+		{
+			// Null pointers and empty std::function objects mean no configuration
+			if ( configure )
+			{
+				std::invoke( configure, metadata );
+			}
+		}
+		else
+		{
+			std::invoke( configure, metadata );
+		}
+
+		if ( m_weigher )
+		{
+			metadata.size = m_weigher( key, value );
+		}
+
+		evictForInsertion( metadata.size );
+
+		auto [insert_it, inserted]{ m_cache.try_emplace( std::move( key ), std::move( value ), std::move( metadata ) ) };
+		insert_it->second.metadata.keyPtr = &insert_it->first;
+		try
+		{
+			m_policy.onInsert( &insert_it->second.metadata, [this, &insert_it]() { return keyHash( &insert_it->second.metadata ); } );
+		}
+		catch ( ... )
+		{
+			// A policy that throws never linked the entry, nothing else knows it yet
+			m_cache.erase( insert_it );
+			throw;
+		}
+		m_timerWheel.schedule( &insert_it->second.metadata, insert_it->second.metadata.expiresAt() );
+		addWeight( insert_it->second.metadata.size );
+
+		if ( hasCustomExpiration( insert_it->second.metadata ) )
+		{
+			++m_customExpirationCount;
+		}
+
+		return insert_it->second.value;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::abandonFlight( const TKey& key, const std::shared_ptr<InFlight>& flight, std::exception_ptr error ) noexcept
+	{
+		{
+			ExclusiveLock lock{ *this };
+
+			// The registration is already gone if insertion itself failed
+			auto it{ m_inFlight.find( key ) };
+			if ( it != m_inFlight.end() && it->second == flight )
+			{
+				m_inFlight.erase( it );
+			}
+		}
+
+		completeFlight( *flight, std::move( error ) );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::completeFlight( InFlight& flight, std::exception_ptr error ) noexcept
+	{
+		flight.error = std::move( error );
+
+		std::vector<std::coroutine_handle<>> waiters;
+		{
+			std::lock_guard<std::mutex> lock{ flight.waitersMutex };
+
+			flight.done.store( true, std::memory_order_release );
+			waiters.swap( flight.waiters );
+		}
+
+		flight.done.notify_all();
+
+		// Suspended coroutines run on this thread, each until its next suspension
+		for ( auto waiter : waiters )
+		{
+			waiter.resume();
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::FlightAwaiter::await_ready() const noexcept
+	{
+		return flight.done.load( std::memory_order_acquire );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::FlightAwaiter::await_suspend( std::coroutine_handle<> awaiting )
+	{
+		std::lock_guard<std::mutex> lock{ flight.waitersMutex };
+
+		if ( flight.done.load( std::memory_order_acquire ) )
+		{
+			return false;
+		}
+
+		flight.waiters.push_back( awaiting );
+
+		return true;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::FlightAwaiter::await_resume() const noexcept
+	{
+	}
+
+	//----------------------------------------------
+	// Removal delivery
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::ExclusiveLock::ExclusiveLock( LruCache& cache )
+		: m_cache{ cache }
+	{
+		m_cache.m_mutex.lock();
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::ExclusiveLock::~ExclusiveLock()
+	{
+		m_cache.unlockAndNotify();
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::unlockAndNotify() noexcept
+	{
+		if ( m_pendingRemovals.empty() )
+		{
+			m_mutex.unlock();
+
+			return;
+		}
+
+		std::vector<PendingRemoval> removals;
+		removals.swap( m_pendingRemovals );
+		auto listener{ m_removalListener };
+
+		m_mutex.unlock();
+
+		for ( auto& removal : removals )
+		{
+			try
+			{
+				( *listener )( removal.key, std::move( removal.value ), removal.cause );
+			}
+			catch ( ... )
+			{
+				// A failing listener must not lose the remaining notifications
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TFactory>
+	inline TValue LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::loadValue( TFactory& factory )
+	{
+		if ( !m_statistics )
+		{
+			return std::invoke( factory );
+		}
+
+		const auto start{ std::chrono::steady_clock::now() };
+		try
+		{
+			TValue value{ std::invoke( factory ) };
+			m_statistics->recordLoadSuccess( std::chrono::steady_clock::now() - start );
+
+			return value;
+		}
+		catch ( ... )
+		{
+			m_statistics->recordLoadFailure( std::chrono::steady_clock::now() - start );
+			throw;
+		}
+	}
+
+	//----------------------------------------------
+	// Background cleanup implementation
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::checkAndPerformBackgroundCleanup( std::chrono::steady_clock::time_point now ) const
+	{
+		// Skip if background cleanup is disabled or not yet due
+		if ( !isBackgroundCleanupDue( now ) )
+		{
+			return;
+		}
+
+		m_lastCleanupTime = now;
+
+		// Perform incremental cleanup of expired entries
+		// Note: We need to cast away const since we're modifying the cache
+		// This is safe because the method is called from within locked operations
+		auto* self = const_cast<LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>*>( this );
+
+		m_cleanupPending = !self->expireDue( now, MAX_CLEANUP_PER_CYCLE );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::isBackgroundCleanupDue( std::chrono::steady_clock::time_point now ) const noexcept
+	{
+		// The maintenance thread takes this work off the callers
+		if ( m_options.backgroundCleanupInterval().count() <= 0 || m_maintenanceThread )
+		{
+			return false;
+		}
+
+		return m_cleanupPending || ( now - m_lastCleanupTime ) >= m_options.backgroundCleanupInterval();
+	}
+
+	//----------------------------------------------
+	// Maintenance thread
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::performMaintenance()
+	{
+		// Destroyed last, after the lock has been released
+		decltype( m_deferred ) deferred;
+
+		bool done{ false };
+		while ( !done )
+		{
+			ExclusiveLock lock{ *this };
+
+			drainReadBuffers();
+			done = expireDue( currentTime(), MAINTENANCE_BATCH );
+
+			if ( done )
+			{
+				deferred.swap( m_deferred );
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Clock
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::chrono::steady_clock::time_point LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::currentTime() const noexcept
+	{
+		return m_clock ? m_clock->now() : std::chrono::steady_clock::now();
+	}
+
+	//----------------------------------------------
+	// Shared hit path
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::sharedHits() const noexcept
+	{
+		return TPolicy<CacheEntry>::CONCURRENT_ACCESS || m_readBuffers != nullptr;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline typename LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::CachedItem* LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::tryGetShared( typename CacheMap::iterator it, std::chrono::steady_clock::time_point now )
+	{
+		if ( it == m_cache.end() )
+		{
+			return nullptr;
+		}
+
+		auto& metadata{ it->second.metadata };
+
+		// Other readers may stamp the same entry concurrently
+		std::atomic_ref<std::chrono::steady_clock::time_point> lastAccessed{ metadata.lastAccessed };
+		if ( CacheEntry::hasElapsed( lastAccessed.load( std::memory_order_relaxed ), now, metadata.slidingExpiration ) ||
+			 ( metadata.absoluteExpiration.count() > 0 && CacheEntry::hasElapsed( metadata.writtenAt, now, metadata.absoluteExpiration ) ) ||
+			 isBackgroundCleanupDue( now ) )
+		{
+			return nullptr;
+		}
+
+		if constexpr ( TPolicy<CacheEntry>::CONCURRENT_ACCESS )
+		{
+			m_policy.onSharedAccess( &metadata );
+		}
+		else if ( !recordRead( &metadata ) )
+		{
+			return nullptr;
+		}
+
+		lastAccessed.store( now, std::memory_order_relaxed );
+
+		return &it->second;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::recordRead( CacheEntry* entry ) noexcept
+	{
+		static thread_local const std::size_t stripe{ std::hash<std::thread::id>{}( std::this_thread::get_id() ) % READ_BUFFER_STRIPES };
+
+		auto& buffer{ m_readBuffers[stripe] };
+		const auto index{ buffer.writeCount.fetch_add( 1, std::memory_order_relaxed ) };
+		if ( index >= READ_BUFFER_CAPACITY )
+		{
+			return false;
+		}
+
+		// Published to the draining thread by the shared unlock / exclusive lock pair
+		buffer.entries[index].store( entry, std::memory_order_relaxed );
+
+		return true;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::drainReadBuffers() noexcept
+	{
+		if ( !m_readBuffers )
+		{
+			return;
+		}
+
+		for ( std::size_t i{ 0 }; i < READ_BUFFER_STRIPES; ++i )
+		{
+			auto& buffer{ m_readBuffers[i] };
+			const auto count{ std::min<std::uint32_t>( buffer.writeCount.load( std::memory_order_relaxed ), READ_BUFFER_CAPACITY ) };
+
+			for ( std::uint32_t j{ 0 }; j < count; ++j )
+			{
+				recordAccess( buffer.entries[j].load( std::memory_order_relaxed ) );
+			}
+
+			buffer.writeCount.store( 0, std::memory_order_relaxed );
+		}
+	}
+
+	//=====================================================================
+	// LruCache::LoadAwaiter
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLoader, typename TConfigure>
+	inline LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::LoadAwaiter<TLoader, TConfigure>::LoadAwaiter( LruCache& cache, const TKey& key, TLoader loader, TConfigure configure )
+		: m_cache{ cache },
+		  m_key{ key },
+		  m_loader{ std::move( loader ) },
+		  m_configure{ std::move( configure ) }
+	{
+	}
+
+	//----------------------------------------------
+	// Awaiting
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLoader, typename TConfigure>
+	inline bool LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::LoadAwaiter<TLoader, TConfigure>::await_ready()
+	{
+		if ( auto* value{ m_cache.sharedHit( m_key, nullptr ) } )
+		{
+			m_start.hit = value;
+
+			return true;
+		}
+
+		m_start = m_cache.startLoad( m_key, nullptr );
+
+		return m_start.hit != nullptr;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLoader, typename TConfigure>
+	inline std::coroutine_handle<> LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::LoadAwaiter<TLoader, TConfigure>::await_suspend( std::coroutine_handle<> awaiting )
+	{
+		m_task.emplace( m_cache.loadAsync( m_key, std::move( m_start ), std::move( m_loader ), std::move( m_configure ) ) );
+
+		return m_task->await_suspend( awaiting );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLoader, typename TConfigure>
+	inline TValue& LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::LoadAwaiter<TLoader, TConfigure>::await_resume()
+	{
+		if ( m_task )
+		{
+			return *m_task->await_resume();
+		}
+
+		return *m_start.hit;
 	}
 } // namespace nfx::memory
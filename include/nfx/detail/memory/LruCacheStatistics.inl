@@ -0,0 +1,275 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file LruCacheStatistics.inl
+ * @brief Implementation of cache statistics recording and rendering
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// LruCacheStatisticsSnapshot
+	//=====================================================================
+
+	//----------------------------------------------
+	// Derived metrics
+	//----------------------------------------------
+
+	inline std::uint64_t LruCacheStatisticsSnapshot::requestCount() const noexcept
+	{
+		return hitCount + missCount;
+	}
+
+	inline double LruCacheStatisticsSnapshot::hitRatio() const noexcept
+	{
+		const auto requests{ requestCount() };
+
+		return requests == 0 ? 1.0 : static_cast<double>( hitCount ) / static_cast<double>( requests );
+	}
+
+	inline std::chrono::nanoseconds LruCacheStatisticsSnapshot::averageLoadPenalty() const noexcept
+	{
+		const auto loads{ loadSuccessCount + loadFailureCount };
+
+		return loads == 0 ? std::chrono::nanoseconds{ 0 } : totalLoadTime / static_cast<std::int64_t>( loads );
+	}
+
+	constexpr std::uint64_t LruCacheStatisticsSnapshot::latencyBucketUpperBound( std::size_t bucket ) noexcept
+	{
+		return std::uint64_t{ 1 } << bucket;
+	}
+
+	//----------------------------------------------
+	// Aggregation
+	//----------------------------------------------
+
+	inline LruCacheStatisticsSnapshot& LruCacheStatisticsSnapshot::operator+=( const LruCacheStatisticsSnapshot& other ) noexcept
+	{
+		hitCount += other.hitCount;
+		missCount += other.missCount;
+		loadSuccessCount += other.loadSuccessCount;
+		loadFailureCount += other.loadFailureCount;
+		totalLoadTime += other.totalLoadTime;
+		evictionCount += other.evictionCount;
+		expirationCount += other.expirationCount;
+
+		for ( std::size_t i{ 0 }; i < LATENCY_BUCKET_COUNT; ++i )
+		{
+			loadLatencyBuckets[i] += other.loadLatencyBuckets[i];
+		}
+
+		return *this;
+	}
+
+	//----------------------------------------------
+	// Rendering
+	//----------------------------------------------
+
+	inline std::string LruCacheStatisticsSnapshot::toJson() const
+	{
+		std::ostringstream out;
+
+		out << "{\"hits\":" << hitCount
+			<< ",\"misses\":" << missCount
+			<< ",\"hitRatio\":" << hitRatio()
+			<< ",\"loadSuccesses\":" << loadSuccessCount
+			<< ",\"loadFailures\":" << loadFailureCount
+			<< ",\"totalLoadTimeNs\":" << totalLoadTime.count()
+			<< ",\"evictions\":" << evictionCount
+			<< ",\"expirations\":" << expirationCount
+			<< ",\"loadLatencyNs\":[";
+
+		bool first{ true };
+		for ( std::size_t i{ 0 }; i < LATENCY_BUCKET_COUNT; ++i )
+		{
+			if ( loadLatencyBuckets[i] == 0 )
+			{
+				continue;
+			}
+
+			out << ( first ? "" : "," ) << "{\"lt\":";
+			if ( i + 1 == LATENCY_BUCKET_COUNT )
+			{
+				out << "null";
+			}
+			else
+			{
+				out << latencyBucketUpperBound( i );
+			}
+			out << ",\"count\":" << loadLatencyBuckets[i] << "}";
+
+			first = false;
+		}
+
+		out << "]}";
+
+		return out.str();
+	}
+
+	inline std::string LruCacheStatisticsSnapshot::toPrometheus( std::string_view metricPrefix ) const
+	{
+		std::ostringstream out;
+
+		auto counter = [&out, metricPrefix]( std::string_view name, std::string_view help, std::uint64_t value ) {
+			out << "# HELP " << metricPrefix << "_" << name << " " << help << "\n"
+				<< "# TYPE " << metricPrefix << "_" << name << " counter\n"
+				<< metricPrefix << "_" << name << " " << value << "\n";
+		};
+
+		counter( "hits_total", "Lookups that returned a live entry.", hitCount );
+		counter( "misses_total", "Lookups that found no live entry.", missCount );
+		counter( "load_successes_total", "Factory invocations that produced a value.", loadSuccessCount );
+		counter( "load_failures_total", "Factory invocations that threw.", loadFailureCount );
+		counter( "evictions_total", "Entries evicted by the size or weight limit.", evictionCount );
+		counter( "expirations_total", "Entries removed because they expired.", expirationCount );
+
+		const std::string histogram{ std::string{ metricPrefix } + "_load_duration_seconds" };
+		out << "# HELP " << histogram << " Time spent in factory invocations.\n"
+			<< "# TYPE " << histogram << " histogram\n";
+
+		std::uint64_t cumulative{ 0 };
+		for ( std::size_t i{ 0 }; i + 1 < LATENCY_BUCKET_COUNT; ++i )
+		{
+			cumulative += loadLatencyBuckets[i];
+			out << histogram << "_bucket{le=\"" << static_cast<double>( latencyBucketUpperBound( i ) ) * 1e-9 << "\"} " << cumulative << "\n";
+		}
+		cumulative += loadLatencyBuckets[LATENCY_BUCKET_COUNT - 1];
+
+		out << histogram << "_bucket{le=\"+Inf\"} " << cumulative << "\n"
+			<< histogram << "_sum " << static_cast<double>( totalLoadTime.count() ) * 1e-9 << "\n"
+			<< histogram << "_count " << cumulative << "\n";
+
+		return out.str();
+	}
+
+	//=====================================================================
+	// LruCacheStatistics
+	//=====================================================================
+
+	//----------------------------------------------
+	// Recording
+	//----------------------------------------------
+
+	inline void LruCacheStatistics::recordHits( std::uint64_t count ) noexcept
+	{
+		add( Hits, count );
+	}
+
+	inline void LruCacheStatistics::recordMisses( std::uint64_t count ) noexcept
+	{
+		add( Misses, count );
+	}
+
+	inline void LruCacheStatistics::recordLoadSuccess( std::chrono::nanoseconds duration ) noexcept
+	{
+		add( LoadSuccesses, 1 );
+		recordLoadTime( duration );
+	}
+
+	inline void LruCacheStatistics::recordLoadFailure( std::chrono::nanoseconds duration ) noexcept
+	{
+		add( LoadFailures, 1 );
+		recordLoadTime( duration );
+	}
+
+	inline void LruCacheStatistics::recordEvictions( std::uint64_t count ) noexcept
+	{
+		add( Evictions, count );
+	}
+
+	inline void LruCacheStatistics::recordExpirations( std::uint64_t count ) noexcept
+	{
+		add( Expirations, count );
+	}
+
+	//----------------------------------------------
+	// Reporting
+	//----------------------------------------------
+
+	inline LruCacheStatisticsSnapshot LruCacheStatistics::snapshot() const noexcept
+	{
+		LruCacheStatisticsSnapshot result;
+
+		for ( const auto& stripe : m_stripes )
+		{
+			result.hitCount += stripe.counters[Hits].load( std::memory_order_relaxed );
+			result.missCount += stripe.counters[Misses].load( std::memory_order_relaxed );
+			result.loadSuccessCount += stripe.counters[LoadSuccesses].load( std::memory_order_relaxed );
+			result.loadFailureCount += stripe.counters[LoadFailures].load( std::memory_order_relaxed );
+			result.totalLoadTime += std::chrono::nanoseconds{ stripe.counters[LoadTimeNanos].load( std::memory_order_relaxed ) };
+			result.evictionCount += stripe.counters[Evictions].load( std::memory_order_relaxed );
+			result.expirationCount += stripe.counters[Expirations].load( std::memory_order_relaxed );
+
+			for ( std::size_t i{ 0 }; i < LruCacheStatisticsSnapshot::LATENCY_BUCKET_COUNT; ++i )
+			{
+				result.loadLatencyBuckets[i] += stripe.latencyBuckets[i].load( std::memory_order_relaxed );
+			}
+		}
+
+		return result;
+	}
+
+	inline void LruCacheStatistics::reset() noexcept
+	{
+		for ( auto& stripe : m_stripes )
+		{
+			for ( auto& counter : stripe.counters )
+			{
+				counter.store( 0, std::memory_order_relaxed );
+			}
+
+			for ( auto& bucket : stripe.latencyBuckets )
+			{
+				bucket.store( 0, std::memory_order_relaxed );
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Helpers
+	//----------------------------------------------
+
+	inline LruCacheStatistics::Stripe& LruCacheStatistics::localStripe() noexcept
+	{
+		static thread_local const std::size_t stripe{ std::hash<std::thread::id>{}( std::this_thread::get_id() ) % STRIPE_COUNT };
+
+		return m_stripes[stripe];
+	}
+
+	inline void LruCacheStatistics::add( Counter counter, std::uint64_t value ) noexcept
+	{
+		localStripe().counters[counter].fetch_add( value, std::memory_order_relaxed );
+	}
+
+	inline void LruCacheStatistics::recordLoadTime( std::chrono::nanoseconds duration ) noexcept
+	{
+		const auto nanos{ static_cast<std::uint64_t>( std::max<std::int64_t>( 0, duration.count() ) ) };
+		const auto bucket{ std::min<std::size_t>( static_cast<std::size_t>( std::bit_width( nanos ) ), LruCacheStatisticsSnapshot::LATENCY_BUCKET_COUNT - 1 ) };
+
+		auto& stripe{ localStripe() };
+		stripe.counters[LoadTimeNanos].fetch_add( nanos, std::memory_order_relaxed );
+		stripe.latencyBuckets[bucket].fetch_add( 1, std::memory_order_relaxed );
+	}
+} // namespace nfx::memory
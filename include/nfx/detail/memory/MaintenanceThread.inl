@@ -0,0 +1,143 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file MaintenanceThread.inl
+ * @brief Implementation of MaintenanceThread
+ * @details Earliest-deadline task loop with interruptible waits
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// MaintenanceThread
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline MaintenanceThread::MaintenanceThread()
+	{
+		m_thread = std::jthread{ [this]( std::stop_token stopToken ) { run( stopToken ); } };
+	}
+
+	//----------------------------------------------
+	// Tasks
+	//----------------------------------------------
+
+	inline MaintenanceThread::TaskId MaintenanceThread::add( Task task, std::chrono::milliseconds interval )
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		const auto id{ m_nextId++ };
+		m_tasks.push_back( { id, std::move( task ), interval, std::chrono::steady_clock::now() + interval } );
+		++m_generation;
+		m_changed.notify_all();
+
+		return id;
+	}
+
+	inline void MaintenanceThread::remove( TaskId id )
+	{
+		std::unique_lock<std::mutex> lock{ m_mutex };
+
+		std::erase_if( m_tasks, [id]( const ScheduledTask& scheduled ) { return scheduled.id == id; } );
+		++m_generation;
+
+		// A task removing itself must not wait for its own run
+		if ( std::this_thread::get_id() != m_thread.get_id() )
+		{
+			m_changed.wait( lock, [this, id]() { return m_running != id; } );
+		}
+	}
+
+	inline std::size_t MaintenanceThread::taskCount() const
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+
+		return m_tasks.size();
+	}
+
+	//----------------------------------------------
+	// Thread body
+	//----------------------------------------------
+
+	inline void MaintenanceThread::run( std::stop_token stopToken )
+	{
+		std::unique_lock<std::mutex> lock{ m_mutex };
+
+		while ( !stopToken.stop_requested() )
+		{
+			auto due{ std::min_element( m_tasks.begin(), m_tasks.end(), []( const ScheduledTask& a, const ScheduledTask& b ) { return a.next < b.next; } ) };
+
+			if ( due == m_tasks.end() )
+			{
+				m_changed.wait( lock, stopToken, [this]() { return !m_tasks.empty(); } );
+
+				continue;
+			}
+
+			if ( due->next > std::chrono::steady_clock::now() )
+			{
+				// Wakes early for stop requests and task list changes, then picks the earliest task again.
+				// The deadline is copied, add() and remove() may move the task while the lock is released
+				const auto next{ due->next };
+				const auto generation{ m_generation };
+				m_changed.wait_until( lock, stopToken, next, [this, generation]() { return m_generation != generation; } );
+
+				continue;
+			}
+
+			// Copied, the task list may change while the lock is released
+			auto task{ due->task };
+			const auto id{ due->id };
+			m_running = id;
+
+			lock.unlock();
+
+			try
+			{
+				task();
+			}
+			catch ( ... )
+			{
+				// A failing task must not stop the others
+			}
+
+			lock.lock();
+
+			m_running = 0;
+
+			auto it{ std::find_if( m_tasks.begin(), m_tasks.end(), [id]( const ScheduledTask& scheduled ) { return scheduled.id == id; } ) };
+			if ( it != m_tasks.end() )
+			{
+				it->next = std::chrono::steady_clock::now() + it->interval;
+			}
+
+			m_changed.notify_all();
+		}
+	}
+} // namespace nfx::memory
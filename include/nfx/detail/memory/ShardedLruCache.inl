@@ -0,0 +1,442 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file ShardedLruCache.inl
+ * @brief Implementation of ShardedLruCache template methods
+ * @details Shard selection and aggregate operations over independent LruCache shards
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// ShardedLruCache
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::ShardedLruCache( const LruCacheOptions& options, std::size_t shardCount )
+		: ShardedLruCache{ options, shardCount, WeigherFunction{} }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::ShardedLruCache( const LruCacheOptions& options, std::size_t shardCount, WeigherFunction weigher )
+		: ShardedLruCache{ options, shardCount, std::move( weigher ), nullptr }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::ShardedLruCache( const LruCacheOptions& options, std::size_t shardCount, WeigherFunction weigher,
+		AllocatorFactory allocatorFactory )
+		: ShardedLruCache{ options, shardCount, std::move( weigher ), ReloadFunction{}, std::move( allocatorFactory ) }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::ShardedLruCache( const LruCacheOptions& options, std::size_t shardCount, ReloadFunction reload )
+		requires RefreshableValue<TValue>
+		: ShardedLruCache{ options, shardCount, WeigherFunction{}, std::move( reload ), nullptr }
+	{
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::ShardedLruCache( const LruCacheOptions& options, std::size_t shardCount, WeigherFunction weigher,
+		ReloadFunction reload, AllocatorFactory allocatorFactory )
+	{
+		if ( shardCount == 0 )
+		{
+			// Default to a few shards per hardware thread to keep collision probability low
+			shardCount = std::max<std::size_t>( 1, std::thread::hardware_concurrency() ) * 4;
+		}
+
+		// Every shard must own at least one slot and one unit of weight, a zero limit would mean unlimited
+		if ( options.sizeLimit() > 0 && shardCount > options.sizeLimit() )
+		{
+			shardCount = options.sizeLimit();
+		}
+		if ( options.maxWeight() > 0 && shardCount > options.maxWeight() )
+		{
+			shardCount = options.maxWeight();
+		}
+
+		shardCount = std::bit_floor( shardCount );
+		m_shardMask = shardCount - 1;
+		m_shardBits = static_cast<int>( std::countr_zero( shardCount ) );
+		m_maxWeight = options.maxWeight();
+
+		// Distribute the limits exactly, the first shards absorb the remainder
+		const std::size_t baseLimit{ options.sizeLimit() / shardCount };
+		const std::size_t limitRemainder{ options.sizeLimit() % shardCount };
+		const std::size_t baseWeight{ options.maxWeight() / shardCount };
+		const std::size_t weightRemainder{ options.maxWeight() % shardCount };
+
+		// One maintenance thread serves every shard
+		LruCacheOptions sharedOptions{ options };
+		if ( options.maintenanceInterval().count() > 0 && !options.maintenanceThread() )
+		{
+			sharedOptions.withMaintenance( options.maintenanceInterval(), std::make_shared<MaintenanceThread>() );
+		}
+
+		m_shards.reserve( shardCount );
+		for ( std::size_t i{ 0 }; i < shardCount; ++i )
+		{
+			LruCacheOptions shardOptions{ sharedOptions };
+			shardOptions.withSizeLimit( baseLimit + ( i < limitRemainder ? 1 : 0 ) );
+			shardOptions.withMaxWeight( baseWeight + ( i < weightRemainder ? 1 : 0 ) );
+
+			m_shards.push_back( std::make_unique<PaddedShard>( shardOptions, weigher, reload, allocatorFactory ? allocatorFactory( i ) : TAllocator{} ) );
+			if ( m_maxWeight > 0 )
+			{
+				m_shards.back()->cache.m_sharedWeight = &m_totalWeight;
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Cache operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure>
+	inline TValue& ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::getOrCreate( const TKey& key, TFactory&& factory, TConfigure&& configure )
+	{
+		const auto index{ shardIndex( key ) };
+		auto& value{ m_shards[index]->cache.getOrCreate( key, std::forward<TFactory>( factory ), std::forward<TConfigure>( configure ) ) };
+		enforceMaxWeight( index );
+
+		return value;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup, CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure>
+		requires TransparentLookup<TLookup, TKey, THash, TKeyEqual> && std::constructible_from<TKey, const TLookup&>
+	inline TValue& ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::getOrCreate( const TLookup& key, TFactory&& factory, TConfigure&& configure )
+	{
+		const auto index{ shardIndex( key ) };
+		auto& value{ m_shards[index]->cache.getOrCreate( key, std::forward<TFactory>( factory ), std::forward<TConfigure>( configure ) ) };
+		enforceMaxWeight( index );
+
+		return value;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline TValue ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::get( const TKey& key )
+		requires RefreshableValue<TValue>
+	{
+		const auto index{ shardIndex( key ) };
+		auto value{ m_shards[index]->cache.get( key ) };
+		enforceMaxWeight( index );
+
+		return value;
+	}
+
+	//----------------------------------------------
+	// Coroutine operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLoader, CacheEntryConfigurator TConfigure>
+		requires std::invocable<std::decay_t<TLoader>&> && std::move_constructible<std::decay_t<TLoader>>
+	inline typename ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::Shard::template LoadAwaiter<std::decay_t<TLoader>, std::decay_t<TConfigure>> ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::getOrLoad( const TKey& key, TLoader&& loader, TConfigure&& configure )
+	{
+		// Loads insert when they complete, so this catches up with the ones completed since the last call
+		enforceMaxWeight( m_shards.size() );
+
+		return shardFor( key ).getOrLoad( key, std::forward<TLoader>( loader ), std::forward<TConfigure>( configure ) );
+	}
+
+	//----------------------------------------------
+	// Lookup operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::optional<std::reference_wrapper<TValue>> ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::tryGet( const TKey& key )
+	{
+		return shardFor( key ).tryGet( key );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup>
+		requires TransparentLookup<TLookup, TKey, THash, TKeyEqual>
+	inline std::optional<std::reference_wrapper<TValue>> ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::tryGet( const TLookup& key )
+	{
+		return shardFor( key ).tryGet( key );
+	}
+
+	//----------------------------------------------
+	// Batch operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::vector<bool> ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::tryGetMany( std::span<const TKey> keys,
+		std::span<std::optional<std::reference_wrapper<TValue>>> values )
+	{
+		if ( values.size() < keys.size() )
+		{
+			throw std::invalid_argument{ "ShardedLruCache::tryGetMany: fewer values than keys" };
+		}
+
+		// Shards share their refresh setting, tryGetBatch() does not check it
+		m_shards.front()->cache.requireReferenceLookups();
+
+		std::vector<bool> hits( keys.size(), false );
+		forEachShardBatch(
+			keys.size(), [keys]( std::size_t index ) -> const TKey& { return keys[index]; },
+			[keys, values, &hits]( Shard& shard, std::span<const std::size_t> indices ) { shard.tryGetBatch( keys, indices, values, hits ); } );
+
+		return hits;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <CacheEntryConfigurator TConfigure>
+	inline std::vector<bool> ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::insertMany( std::span<std::pair<TKey, TValue>> entries, TConfigure&& configure )
+	{
+		std::vector<bool> inserted( entries.size(), false );
+		forEachShardBatch(
+			entries.size(), [entries]( std::size_t index ) -> const TKey& { return entries[index].first; },
+			[entries, &configure, &inserted]( Shard& shard, std::span<const std::size_t> indices ) { shard.insertBatch( entries, indices, configure, inserted ); } );
+		enforceMaxWeight( m_shards.size() );
+
+		return inserted;
+	}
+
+	//----------------------------------------------
+	// Modification operations
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::remove( const TKey& key )
+	{
+		return shardFor( key ).remove( key );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup>
+		requires TransparentLookup<TLookup, TKey, THash, TKeyEqual>
+	inline bool ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::remove( const TLookup& key )
+	{
+		return shardFor( key ).remove( key );
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::clear()
+	{
+		for ( auto& shard : m_shards )
+		{
+			shard->cache.clear();
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::size_t ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::size() const
+	{
+		std::size_t total{ 0 };
+		for ( const auto& shard : m_shards )
+		{
+			total += shard->cache.size();
+		}
+
+		return total;
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::size_t ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::totalWeight() const
+	{
+		std::size_t total{ 0 };
+		for ( const auto& shard : m_shards )
+		{
+			total += shard->cache.totalWeight();
+		}
+
+		return total;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline bool ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::isEmpty() const
+	{
+		for ( const auto& shard : m_shards )
+		{
+			if ( !shard->cache.isEmpty() )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::cleanupExpired()
+	{
+		for ( auto& shard : m_shards )
+		{
+			shard->cache.cleanupExpired();
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline LruCacheStatisticsSnapshot ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::stats() const noexcept
+	{
+		LruCacheStatisticsSnapshot total;
+		for ( const auto& shard : m_shards )
+		{
+			total += shard->cache.stats();
+		}
+
+		return total;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline std::size_t ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::shardCount() const noexcept
+	{
+		return m_shards.size();
+	}
+
+	//----------------------------------------------
+	// Removal notification
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::setRemovalListener( RemovalListener listener )
+	{
+		for ( auto& shard : m_shards )
+		{
+			shard->cache.setRemovalListener( listener );
+		}
+	}
+
+	//----------------------------------------------
+	// Internal data structures
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::PaddedShard::PaddedShard( const LruCacheOptions& options, const WeigherFunction& weigher,
+		const ReloadFunction& reload, const TAllocator& allocator )
+		: cache{ options, weigher, reload, allocator }
+	{
+	}
+
+	//----------------------------------------------
+	// Shard selection
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup>
+	inline typename ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::Shard& ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::shardFor( const TLookup& key ) const noexcept
+	{
+		return m_shards[shardIndex( key )]->cache;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLookup>
+	inline std::size_t ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::shardIndex( const TLookup& key ) const noexcept
+	{
+		const auto hash{ mixHash( static_cast<std::uint64_t>( THash{}( key ) ) ) };
+
+		// The top bits: FlatHashMap takes its control byte and group from the low bits of the
+		// same mix, which would otherwise be equal for every key of a shard
+		return static_cast<std::size_t>( std::rotl( hash, m_shardBits ) ) & m_shardMask;
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TKeyAt, typename TVisit>
+	inline void ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::forEachShardBatch( std::size_t count, const TKeyAt& keyAt, const TVisit& visit )
+	{
+		std::vector<std::size_t> shardOf( count );
+		for ( std::size_t i{ 0 }; i < count; ++i )
+		{
+			shardOf[i] = shardIndex( keyAt( i ) );
+		}
+
+		// Positions grouped by shard, in batch order within a shard
+		std::vector<std::size_t> order( count );
+		std::iota( order.begin(), order.end(), std::size_t{ 0 } );
+		std::ranges::stable_sort( order, {}, [&shardOf]( std::size_t index ) { return shardOf[index]; } );
+
+		const std::span<const std::size_t> positions{ order };
+		for ( std::size_t begin{ 0 }; begin < count; )
+		{
+			const auto shard{ shardOf[order[begin]] };
+
+			auto end{ begin + 1 };
+			while ( end < count && shardOf[order[end]] == shard )
+			{
+				++end;
+			}
+
+			visit( m_shards[shard]->cache, positions.subspan( begin, end - begin ) );
+			begin = end;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	constexpr std::uint64_t ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::mixHash( std::uint64_t hash ) noexcept
+	{
+		// MurmurHash3 64-bit finalizer
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb3f99f2c1b53ULL;
+		hash ^= hash >> 33;
+
+		return hash;
+	}
+
+	//----------------------------------------------
+	// Weight limit
+	//----------------------------------------------
+
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	inline void ShardedLruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::enforceMaxWeight( std::size_t origin )
+	{
+		if ( m_maxWeight == 0 || m_totalWeight.load( std::memory_order_relaxed ) <= m_maxWeight )
+		{
+			return;
+		}
+
+		// One victim per shard in turn, from a rotating start so that concurrent callers spread out
+		auto shard{ m_evictionCursor.fetch_add( 1, std::memory_order_relaxed ) };
+		std::size_t idle{ 0 };
+		while ( idle < m_shards.size() && m_totalWeight.load( std::memory_order_relaxed ) > m_maxWeight )
+		{
+			const auto index{ shard++ & m_shardMask };
+			if ( index != origin && m_shards[index]->cache.evictForSharedWeight() )
+			{
+				idle = 0;
+			}
+			else
+			{
+				++idle;
+			}
+		}
+	}
+} // namespace nfx::memory
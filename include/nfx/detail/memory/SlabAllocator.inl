@@ -0,0 +1,261 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file SlabAllocator.inl
+ * @brief Implementation of SlabArena and SlabAllocator
+ * @details Size-class pools with intrusive free lists carved from aligned slabs
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// SlabArena
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	inline SlabArena::SlabArena( std::size_t slabSize, bool hugePages )
+		: m_slabSize{ slabSize },
+		  m_slabAlignment{ hugePages ? HUGE_PAGE_SIZE : SLAB_ALIGNMENT },
+		  m_hugePages{ hugePages }
+	{
+		// Whole pages only, and whole huge pages when they are requested
+		m_slabSize = ( ( std::max( m_slabSize, m_slabAlignment ) + m_slabAlignment - 1 ) / m_slabAlignment ) * m_slabAlignment;
+	}
+
+	//----------------------------------------------
+	// Destruction
+	//----------------------------------------------
+
+	inline SlabArena::~SlabArena()
+	{
+		for ( auto* slab : m_slabs )
+		{
+			::operator delete( slab, m_slabSize, std::align_val_t{ m_slabAlignment } );
+		}
+	}
+
+	//----------------------------------------------
+	// Pools
+	//----------------------------------------------
+
+	inline SlabArena::Pool* SlabArena::pool( std::size_t size, std::size_t alignment )
+	{
+		if ( auto* existing{ findPool( size, alignment ) } )
+		{
+			return existing;
+		}
+
+		const auto [blockSize, blockAlignment]{ blockLayout( size, alignment ) };
+		if ( blockSize == 0 )
+		{
+			return nullptr;
+		}
+
+		m_pools.push_back( std::make_unique<Pool>( Pool{ blockSize, blockAlignment } ) );
+
+		return m_pools.back().get();
+	}
+
+	inline SlabArena::Pool* SlabArena::findPool( std::size_t size, std::size_t alignment ) const noexcept
+	{
+		const auto [blockSize, blockAlignment]{ blockLayout( size, alignment ) };
+
+		for ( const auto& existing : m_pools )
+		{
+			if ( existing->blockSize == blockSize && existing->alignment == blockAlignment )
+			{
+				return existing.get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	inline void* SlabArena::allocate( Pool& pool )
+	{
+		if ( pool.freeList != nullptr )
+		{
+			auto* block{ pool.freeList };
+			pool.freeList = *static_cast<void**>( block );
+
+			return block;
+		}
+
+		if ( static_cast<std::size_t>( pool.end - pool.cursor ) < pool.blockSize )
+		{
+			m_slabs.reserve( m_slabs.size() + 1 );
+
+			auto* slab{ static_cast<std::byte*>( ::operator new( m_slabSize, std::align_val_t{ m_slabAlignment } ) ) };
+
+#if defined( __linux__ ) && defined( MADV_HUGEPAGE )
+			if ( m_hugePages )
+			{
+				// Advisory only, the slab works the same if the kernel declines
+				::madvise( slab, m_slabSize, MADV_HUGEPAGE );
+			}
+#endif
+
+			m_slabs.push_back( slab );
+			pool.cursor = slab;
+			pool.end = slab + m_slabSize;
+		}
+
+		auto* block{ pool.cursor };
+		pool.cursor += pool.blockSize;
+
+		return block;
+	}
+
+	inline void SlabArena::deallocate( Pool& pool, void* block ) noexcept
+	{
+		*static_cast<void**>( block ) = pool.freeList;
+		pool.freeList = block;
+	}
+
+	//----------------------------------------------
+	// State inspection
+	//----------------------------------------------
+
+	inline std::size_t SlabArena::slabCount() const noexcept
+	{
+		return m_slabs.size();
+	}
+
+	inline std::size_t SlabArena::slabSize() const noexcept
+	{
+		return m_slabSize;
+	}
+
+	//----------------------------------------------
+	// Block layout
+	//----------------------------------------------
+
+	inline std::pair<std::size_t, std::size_t> SlabArena::blockLayout( std::size_t size, std::size_t alignment ) const noexcept
+	{
+		// Blocks hold the free list link, large or over-aligned objects bypass the arena
+		const auto blockAlignment{ std::max( alignment, alignof( void* ) ) };
+		const auto blockSize{ ( ( std::max( size, sizeof( void* ) ) + blockAlignment - 1 ) / blockAlignment ) * blockAlignment };
+
+		if ( blockAlignment > SLAB_ALIGNMENT || blockSize > m_slabSize / 8 )
+		{
+			return { 0, blockAlignment };
+		}
+
+		return { blockSize, blockAlignment };
+	}
+
+	//=====================================================================
+	// SlabAllocator
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename T>
+	inline SlabAllocator<T>::SlabAllocator()
+		: SlabAllocator{ std::make_shared<SlabArena>() }
+	{
+	}
+
+	template <typename T>
+	inline SlabAllocator<T>::SlabAllocator( std::shared_ptr<SlabArena> arena )
+		: m_arena{ std::move( arena ) }
+	{
+	}
+
+	template <typename T>
+	template <typename U>
+	inline SlabAllocator<T>::SlabAllocator( const SlabAllocator<U>& other ) noexcept
+		: m_arena{ other.m_arena }
+	{
+	}
+
+	//----------------------------------------------
+	// Allocation
+	//----------------------------------------------
+
+	template <typename T>
+	inline T* SlabAllocator<T>::allocate( std::size_t count )
+	{
+		if ( count == 1 )
+		{
+			if ( m_pool == nullptr )
+			{
+				m_pool = m_arena->pool( sizeof( T ), alignof( T ) );
+			}
+
+			if ( m_pool != nullptr )
+			{
+				return static_cast<T*>( m_arena->allocate( *m_pool ) );
+			}
+		}
+
+		return std::allocator<T>{}.allocate( count );
+	}
+
+	template <typename T>
+	inline void SlabAllocator<T>::deallocate( T* pointer, std::size_t count ) noexcept
+	{
+		if ( count == 1 )
+		{
+			// Single objects of a size served by the arena always come from its pool,
+			// even when allocated through another copy of this allocator
+			auto* pool{ m_pool != nullptr ? m_pool : m_arena->findPool( sizeof( T ), alignof( T ) ) };
+			if ( pool != nullptr )
+			{
+				m_arena->deallocate( *pool, pointer );
+
+				return;
+			}
+		}
+
+		std::allocator<T>{}.deallocate( pointer, count );
+	}
+
+	//----------------------------------------------
+	// Accessors
+	//----------------------------------------------
+
+	template <typename T>
+	inline const std::shared_ptr<SlabArena>& SlabAllocator<T>::arena() const noexcept
+	{
+		return m_arena;
+	}
+
+	//----------------------------------------------
+	// Comparison
+	//----------------------------------------------
+
+	template <typename T>
+	template <typename U>
+	inline bool SlabAllocator<T>::operator==( const SlabAllocator<U>& other ) const noexcept
+	{
+		return m_arena == other.m_arena;
+	}
+} // namespace nfx::memory
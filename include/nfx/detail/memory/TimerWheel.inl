@@ -0,0 +1,244 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerWheel.inl
+ * @brief Implementation of TimerWheel template methods
+ * @details Bucket selection by deadline distance, cascading advance with a resumable
+ *          sweep cursor and intrusive singly-linked lists with back pointers for O(1) removal
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// TimerWheel
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	template <typename TEntry>
+	inline TimerWheel<TEntry>::TimerWheel( std::chrono::steady_clock::time_point now ) noexcept
+		: m_time{ toNanoseconds( now ) }
+	{
+	}
+
+	//----------------------------------------------
+	// Scheduling
+	//----------------------------------------------
+
+	template <typename TEntry>
+	inline void TimerWheel<TEntry>::schedule( TEntry* entry, std::chrono::steady_clock::time_point deadline ) noexcept
+	{
+		deschedule( entry );
+		link( bucketFor( toNanoseconds( deadline ) ), entry );
+	}
+
+	template <typename TEntry>
+	inline void TimerWheel<TEntry>::deschedule( TEntry* entry ) noexcept
+	{
+		if ( entry->timerPrevNext != nullptr )
+		{
+			unlink( entry );
+		}
+	}
+
+	template <typename TEntry>
+	inline void TimerWheel<TEntry>::clear() noexcept
+	{
+		for ( auto& level : m_buckets )
+		{
+			level.fill( nullptr );
+		}
+
+		m_overflow = nullptr;
+		m_sweep = Sweep{};
+	}
+
+	//----------------------------------------------
+	// Expiration
+	//----------------------------------------------
+
+	template <typename TEntry>
+	template <typename TOnDue>
+	inline bool TimerWheel<TEntry>::advance( std::chrono::steady_clock::time_point now, TOnDue&& onDue, std::size_t budget )
+	{
+		bool started{ false };
+
+		while ( true )
+		{
+			if ( !isAdvancing() )
+			{
+				// Entries filed from here on are placed relative to the new time
+				m_sweep.from = m_time;
+				m_sweep.level = 0;
+				m_sweep.offset = 0;
+				m_time = std::max( m_time, toNanoseconds( now ) );
+				started = true;
+			}
+
+			while ( true )
+			{
+				while ( m_sweep.pending != nullptr )
+				{
+					if ( budget == 0 )
+					{
+						return false;
+					}
+					--budget;
+
+					auto* entry{ m_sweep.pending };
+					unlink( entry );
+					onDue( entry );
+				}
+
+				auto* bucket{ nextBucket() };
+				if ( bucket == nullptr )
+				{
+					break;
+				}
+
+				// Detach the list first, so entries filed again into this bucket wait for the next visit
+				m_sweep.pending = std::exchange( *bucket, nullptr );
+				if ( m_sweep.pending != nullptr )
+				{
+					m_sweep.pending->timerPrevNext = &m_sweep.pending;
+				}
+			}
+
+			// A resumed advance ended at an earlier time, so run one for now as well
+			if ( started )
+			{
+				return true;
+			}
+		}
+	}
+
+	template <typename TEntry>
+	inline bool TimerWheel<TEntry>::isAdvancing() const noexcept
+	{
+		return m_sweep.level <= LEVELS;
+	}
+
+	//----------------------------------------------
+	// Bucket management
+	//----------------------------------------------
+
+	template <typename TEntry>
+	constexpr std::size_t TimerWheel<TEntry>::shift( std::size_t level ) noexcept
+	{
+		return BASE_SHIFT + level * BUCKET_BITS;
+	}
+
+	template <typename TEntry>
+	inline std::int64_t TimerWheel<TEntry>::toNanoseconds( std::chrono::steady_clock::time_point time ) noexcept
+	{
+		return std::max<std::int64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( time.time_since_epoch() ).count(), 0 );
+	}
+
+	template <typename TEntry>
+	inline TEntry*& TimerWheel<TEntry>::bucketFor( std::int64_t deadline ) noexcept
+	{
+		// Past deadlines go to the current bucket, which the next advance always visits
+		deadline = std::max( deadline, m_time );
+
+		const auto distance{ deadline - m_time };
+		for ( std::size_t level{ 0 }; level < LEVELS; ++level )
+		{
+			if ( distance < ( std::int64_t{ 1 } << shift( level + 1 ) ) )
+			{
+				return m_buckets[level][static_cast<std::size_t>( deadline >> shift( level ) ) & ( BUCKETS - 1 )];
+			}
+		}
+
+		return m_overflow;
+	}
+
+	template <typename TEntry>
+	inline TEntry** TimerWheel<TEntry>::nextBucket() noexcept
+	{
+		while ( m_sweep.level < LEVELS )
+		{
+			const auto previousTicks{ m_sweep.from >> shift( m_sweep.level ) };
+			const auto currentTicks{ m_time >> shift( m_sweep.level ) };
+
+			// Coarser levels only move when this one wrapped into their next bucket
+			if ( m_sweep.level > 0 && currentTicks == previousTicks )
+			{
+				m_sweep.level = LEVELS + 1;
+
+				return nullptr;
+			}
+
+			// Visit every bucket from the previous tick to the current one, both included
+			const auto count{ std::min<std::int64_t>( currentTicks - previousTicks + 1, BUCKETS ) };
+			if ( m_sweep.offset < count )
+			{
+				return &m_buckets[m_sweep.level][static_cast<std::size_t>( previousTicks + m_sweep.offset++ ) & ( BUCKETS - 1 )];
+			}
+
+			++m_sweep.level;
+			m_sweep.offset = 0;
+		}
+
+		if ( m_sweep.level == LEVELS )
+		{
+			// Overflow entries move down once they come within range of the coarsest level
+			++m_sweep.level;
+
+			return &m_overflow;
+		}
+
+		return nullptr;
+	}
+
+	template <typename TEntry>
+	inline void TimerWheel<TEntry>::link( TEntry*& bucket, TEntry* entry ) noexcept
+	{
+		entry->timerNext = bucket;
+		entry->timerPrevNext = &bucket;
+
+		if ( bucket != nullptr )
+		{
+			bucket->timerPrevNext = &entry->timerNext;
+		}
+
+		bucket = entry;
+	}
+
+	template <typename TEntry>
+	inline void TimerWheel<TEntry>::unlink( TEntry* entry ) noexcept
+	{
+		*entry->timerPrevNext = entry->timerNext;
+
+		if ( entry->timerNext != nullptr )
+		{
+			entry->timerNext->timerPrevNext = entry->timerPrevNext;
+		}
+
+		entry->timerNext = nullptr;
+		entry->timerPrevNext = nullptr;
+	}
+} // namespace nfx::memory
@@ -0,0 +1,212 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file AsyncLruCache.h
+ * @brief LRU cache of shared futures whose factories run on a caller-supplied executor
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "nfx/memory/LruCache.h"
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// AsyncLruCache class
+	//=====================================================================
+
+	/**
+	 * @brief Thread-safe cache handing out std::shared_future values without blocking on factories
+	 * @tparam TKey Key type for cache entries
+	 * @tparam TValue Value type produced by the factories
+	 * @tparam THash Hash function type for keys
+	 * @tparam TKeyEqual Key equality type
+	 * @tparam TStorage Storage engine, NodeStorage or FlatStorage
+	 * @tparam TAllocator Allocator for the storage engine, rebound to its internal node type
+	 * @tparam TPolicy Eviction policy over the cached entries, LruPolicy by default
+	 * @details Entries are futures in an underlying LruCache. A miss caches a new future right
+	 *          away and submits the factory to the executor, so the calling thread never runs
+	 *          or waits for it, and concurrent callers for the same key share that future. Once
+	 *          the factory completes, the future stays cached ready: a hit copies it under the
+	 *          cache lock, which only bumps a reference count. A factory that throws fails its
+	 *          future and the entry is removed, so the next call retries. Size limits,
+	 *          expiration, eviction policy and statistics are those of the underlying cache and
+	 *          apply from the miss on, whether the future is ready or not.
+	 */
+	template <typename TKey, typename TValue, typename THash = std::hash<TKey>, typename TKeyEqual = std::equal_to<TKey>, typename TStorage = NodeStorage,
+		typename TAllocator = std::allocator<std::pair<const TKey, std::shared_future<TValue>>>, template <typename> typename TPolicy = LruPolicy>
+	class AsyncLruCache final
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Future handed out for every key, shared by all callers of that key */
+		using Future = std::shared_future<TValue>;
+
+		/** @brief Function type running a task, e.g. by posting it to an event loop or a thread pool */
+		using Executor = CacheExecutor;
+
+		/** @brief Underlying cache type storing the futures */
+		using Cache = LruCache<TKey, Future, THash, TKeyEqual, TStorage, TAllocator, TPolicy>;
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct async cache with specified options and executor
+		 * @param options Configuration options of the underlying cache
+		 * @param executor Function running factory tasks, called on the thread that missed
+		 * @throws std::invalid_argument if executor is empty, or if the options enable refresh after write
+		 */
+		inline AsyncLruCache( const LruCacheOptions& options, Executor executor );
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		AsyncLruCache( const AsyncLruCache& ) = delete;
+		AsyncLruCache( AsyncLruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		AsyncLruCache& operator=( const AsyncLruCache& ) = delete;
+		AsyncLruCache& operator=( AsyncLruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Release the cache; factory tasks still queued complete their futures without touching it */
+		~AsyncLruCache() = default;
+
+		//----------------------------------------------
+		// Cache operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the future of a key, submitting the factory to the executor on a miss
+		 * @tparam TFactory Factory callable type, copied into the submitted task
+		 * @tparam TConfigure Configurator callable type, std::nullptr_t when omitted
+		 * @param key The cache key
+		 * @param factory Function creating the value, run by the executor
+		 * @param configure Optional function to configure the cache entry, run on the calling thread
+		 * @return Future of the value, ready on a hit once the factory has completed
+		 * @details If the executor throws, the future is failed with that exception, the entry
+		 *          is removed and the exception is rethrown to the caller that missed.
+		 */
+		template <CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure = std::nullptr_t>
+			requires std::copy_constructible<std::decay_t<TFactory>>
+		inline Future getOrCreateAsync( const TKey& key, TFactory&& factory, TConfigure&& configure = nullptr );
+
+		//----------------------------------------------
+		// Lookup operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Try to get the future of a key without creating it
+		 * @param key The cache key
+		 * @return Future of the value, possibly not ready yet, if cached and not expired
+		 */
+		inline std::optional<Future> tryGet( const TKey& key );
+
+		//----------------------------------------------
+		// Modification operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Remove an entry from the cache
+		 * @param key The cache key to remove
+		 * @return True if entry was removed, false if not found
+		 * @details Callers already holding the future still receive its value
+		 */
+		inline bool remove( const TKey& key );
+
+		/**
+		 * @brief Clear all cache entries
+		 */
+		inline void clear();
+
+		/**
+		 * @brief Get current cache size
+		 * @return Number of entries in cache, pending or ready
+		 */
+		inline std::size_t size() const;
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		/**
+		 * @brief Get a snapshot of the underlying cache statistics
+		 * @return Current statistics; a hit on a pending future counts as a hit
+		 */
+		inline LruCacheStatisticsSnapshot stats() const noexcept;
+
+	private:
+		/** @brief Underlying cache, shared with queued factory tasks that may outlive this object */
+		std::shared_ptr<Cache> m_cache;
+
+		/** @brief Function running factory tasks */
+		Executor m_executor;
+
+		//----------------------------------------------
+		// Helpers
+		//----------------------------------------------
+
+		/**
+		 * @brief Check whether a future holds an exception
+		 * @param future Future to inspect without waiting
+		 * @return True if the future is ready and failed
+		 */
+		static inline bool isFailed( const Future& future );
+
+		/**
+		 * @brief Check the options of the underlying cache
+		 * @param options Options given to the constructor
+		 * @return The options, unchanged
+		 * @throws std::invalid_argument if the options enable refresh after write, cached futures have no reload
+		 */
+		static inline const LruCacheOptions& checkOptions( const LruCacheOptions& options );
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/AsyncLruCache.inl"
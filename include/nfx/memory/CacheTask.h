@@ -0,0 +1,180 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file CacheTask.h
+ * @brief Lazy coroutine task resuming its awaiter by symmetric transfer
+ */
+
+#pragma once
+
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// CacheTask class
+	//=====================================================================
+
+	/**
+	 * @brief Coroutine producing one value, started when first awaited
+	 * @tparam T Result type, an object type
+	 * @details Used by LruCache::getOrLoad() to run a miss, and usable as the return type of
+	 *          loader coroutines. The task does not start until awaited and transfers control
+	 *          straight back to its awaiter when it finishes, so chains of tasks that complete
+	 *          synchronously neither park a thread nor grow the stack. A task is awaited at
+	 *          most once and destroys its coroutine frame when it goes out of scope.
+	 */
+	template <typename T>
+		requires std::is_object_v<T>
+	class [[nodiscard]] CacheTask final
+	{
+	public:
+		//----------------------------------------------
+		// Promise
+		//----------------------------------------------
+
+		/** @brief Coroutine promise holding the awaiter to resume and the result */
+		class promise_type final
+		{
+		public:
+			/** @brief Resumes the awaiter of a finished task */
+			struct FinalAwaiter
+			{
+				/** @brief Never ready, the finished coroutine always suspends */
+				[[nodiscard]] inline bool await_ready() const noexcept;
+
+				/**
+				 * @brief Pick the coroutine to run next
+				 * @param finished The finished task's coroutine
+				 * @return Its awaiter, or a no-op coroutine if it was never awaited
+				 */
+				inline std::coroutine_handle<> await_suspend( std::coroutine_handle<promise_type> finished ) const noexcept;
+
+				/** @brief Nothing to produce, the frame is never resumed again */
+				inline void await_resume() const noexcept;
+			};
+
+			/** @brief Create the task owning this coroutine */
+			inline CacheTask get_return_object() noexcept;
+
+			/** @brief Start suspended, the awaiter starts the task */
+			[[nodiscard]] inline std::suspend_always initial_suspend() const noexcept;
+
+			/** @brief Finish suspended and transfer to the awaiter */
+			[[nodiscard]] inline FinalAwaiter final_suspend() const noexcept;
+
+			/**
+			 * @brief Store the result of co_return
+			 * @param value Value converted to T
+			 */
+			template <typename U>
+				requires std::convertible_to<U, T>
+			inline void return_value( U&& value );
+
+			/** @brief Store the exception escaping the coroutine body */
+			inline void unhandled_exception() noexcept;
+
+			/**
+			 * @brief Take the result, rethrowing a stored exception
+			 * @return The value given to co_return
+			 */
+			inline T result();
+
+		private:
+			friend class CacheTask;
+
+			/** @brief Coroutine to resume once finished (null while not awaited) */
+			std::coroutine_handle<> m_continuation;
+
+			/** @brief Result of the coroutine, empty until it finishes */
+			std::variant<std::monostate, T, std::exception_ptr> m_result;
+		};
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Take ownership of a coroutine frame
+		 * @param handle Coroutine created with this task's promise type
+		 */
+		inline explicit CacheTask( std::coroutine_handle<promise_type> handle ) noexcept;
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		CacheTask( const CacheTask& ) = delete;
+
+		/** @brief Take over the coroutine of another task */
+		inline CacheTask( CacheTask&& other ) noexcept;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		CacheTask& operator=( const CacheTask& ) = delete;
+		CacheTask& operator=( CacheTask&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Destroy the coroutine frame */
+		inline ~CacheTask();
+
+		//----------------------------------------------
+		// Awaiting
+		//----------------------------------------------
+
+		/** @brief Never ready, awaiting starts the coroutine */
+		[[nodiscard]] inline bool await_ready() const noexcept;
+
+		/**
+		 * @brief Record the awaiter and start the coroutine
+		 * @param awaiting Coroutine resumed when the task finishes
+		 * @return Handle of this task's coroutine, resumed in place of the awaiter
+		 */
+		inline std::coroutine_handle<> await_suspend( std::coroutine_handle<> awaiting ) noexcept;
+
+		/**
+		 * @brief Take the result of the finished task
+		 * @return The value given to co_return
+		 * @throws Whatever escaped the coroutine body
+		 */
+		inline T await_resume();
+
+	private:
+		std::coroutine_handle<promise_type> m_handle;
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/CacheTask.inl"
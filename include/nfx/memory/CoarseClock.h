@@ -0,0 +1,128 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file CoarseClock.h
+ * @brief Cached steady clock refreshed by a background thread at a fixed resolution
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// CoarseClock class
+	//=====================================================================
+
+	/**
+	 * @brief Steady clock whose reading is a cached atomic value
+	 * @details A background thread stores std::chrono::steady_clock::now() every resolution
+	 *          period, so now() is a single relaxed atomic load instead of a clock read.
+	 *          Readings lag real time by at most one period plus scheduling delay; update()
+	 *          refreshes the reading immediately, e.g. once before a batch of operations.
+	 *          Caches configured with the same resolution share one clock through shared().
+	 */
+	class CoarseClock final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Start a clock refreshed every resolution period
+		 * @param resolution Refresh period, must be positive
+		 */
+		inline explicit CoarseClock( std::chrono::milliseconds resolution );
+
+		/**
+		 * @brief Get the clock shared by all users of a resolution, starting it if needed
+		 * @param resolution Refresh period, must be positive
+		 * @return Shared clock, stopped when its last user releases it
+		 */
+		static inline std::shared_ptr<CoarseClock> shared( std::chrono::milliseconds resolution );
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		CoarseClock( const CoarseClock& ) = delete;
+		CoarseClock( CoarseClock&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		CoarseClock& operator=( const CoarseClock& ) = delete;
+		CoarseClock& operator=( CoarseClock&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Stop and join the refresh thread */
+		~CoarseClock() = default;
+
+		//----------------------------------------------
+		// Time
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the cached time
+		 * @return Steady clock time of the last refresh
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::steady_clock::time_point now() const noexcept;
+
+		/** @brief Refresh the cached time from the steady clock */
+		inline void update() noexcept;
+
+		/**
+		 * @brief Get the refresh period
+		 * @return Resolution of the clock
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::milliseconds resolution() const noexcept;
+
+	private:
+		std::chrono::milliseconds m_resolution;
+
+		/** @brief Ticks of steady_clock since its epoch, at the last refresh */
+		std::atomic<std::chrono::steady_clock::rep> m_now;
+
+		/** @brief Refresh thread, declared last so it stops before the members it uses go away */
+		std::jthread m_thread;
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/CoarseClock.inl"
@@ -0,0 +1,424 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file CompactLruCache.h
+ * @brief Thread-safe LRU cache with sliding expiration and compact per-entry metadata
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "nfx/memory/LruCache.h"
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// CompactLruCache class
+	//=====================================================================
+
+	/**
+	 * @brief Thread-safe LRU cache storing 12 bytes of metadata per entry
+	 * @tparam TKey Key type for cache entries
+	 * @tparam TValue Value type for cached objects
+	 * @tparam THash Hash function type for keys
+	 * @tparam TKeyEqual Key equality type
+	 * @details Intended for caches holding tens of millions of small entries, where the
+	 *          48-byte CacheEntry and the map node of LruCache dominate memory use.
+	 *          Each entry is a slot holding the key, the value, two 32-bit LRU list indices
+	 *          and a 32-bit access time in TICK units relative to cache construction.
+	 *          Slots live in fixed-size chunks, so returned references stay valid until the
+	 *          entry is removed, and an open-addressing table of 32-bit slot indices
+	 *          replaces the map. Expirations differing from the default are kept in a side
+	 *          table, and keys are stored once with no back-pointer.
+	 *
+	 *          Compared to LruCache, the factory runs under the cache lock, and weights,
+	 *          read buffering, statistics, removal listeners, absolute expiration and refresh
+	 *          after write are not supported. Options enabling a weight limit, absolute
+	 *          expiration or refresh after write are rejected; the other settings are ignored.
+	 */
+	template <typename TKey, typename TValue, typename THash = std::hash<TKey>, typename TKeyEqual = std::equal_to<TKey>>
+	class CompactLruCache final
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Type-erased factory, accepted by getOrCreate() like any other CacheFactory */
+		using FactoryFunction = std::function<TValue()>;
+
+		/** @brief Type-erased entry configurator, only CacheEntry::slidingExpiration is honoured */
+		using ConfigFunction = std::function<void( CacheEntry& )>;
+
+		//----------------------------------------------
+		// Constants
+		//----------------------------------------------
+
+		/**
+		 * @brief Resolution of entry access times
+		 * @details Entries never expire early; they may outlive their expiration by up to one tick.
+		 *          32-bit timestamps cover about 497 days of idle time per entry.
+		 */
+		static constexpr std::chrono::milliseconds TICK{ 10 };
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct compact cache with specified options
+		 * @param options Size limit, default sliding expiration, background cleanup interval and clock resolution
+		 * @throws std::invalid_argument if the options set a weight limit, absolute expiration or refresh after write
+		 */
+		inline explicit CompactLruCache( const LruCacheOptions& options = {} );
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		CompactLruCache( const CompactLruCache& ) = delete;
+		CompactLruCache( CompactLruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		CompactLruCache& operator=( const CompactLruCache& ) = delete;
+		CompactLruCache& operator=( CompactLruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Destroy all cached entries */
+		inline ~CompactLruCache();
+
+		//----------------------------------------------
+		// Cache operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Get or create a cache entry using factory function
+		 * @tparam TFactory Factory callable type, taken by reference and never copied
+		 * @tparam TConfigure Configurator callable type, std::nullptr_t when omitted
+		 * @param key The cache key
+		 * @param factory Function to create the value if not cached, called under the cache lock
+		 * @param configure Optional function adjusting CacheEntry::slidingExpiration of a new entry
+		 * @return Reference to the cached value
+		 */
+		template <CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure = std::nullptr_t>
+		inline TValue& getOrCreate( const TKey& key, TFactory&& factory, TConfigure&& configure = nullptr );
+
+		//----------------------------------------------
+		// Lookup operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Try to get a cached value without creating it
+		 * @param key The cache key
+		 * @return Optional reference to the value if found and not expired
+		 */
+		inline std::optional<std::reference_wrapper<TValue>> tryGet( const TKey& key );
+
+		//----------------------------------------------
+		// Modification operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Remove an entry from the cache
+		 * @param key The cache key
+		 * @return True if the entry was found and removed
+		 */
+		inline bool remove( const TKey& key );
+
+		/** @brief Remove all entries from the cache */
+		inline void clear();
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the number of cached entries
+		 * @return Number of entries, including expired entries not yet removed
+		 */
+		inline std::size_t size() const;
+
+		/**
+		 * @brief Check if the cache is empty
+		 * @return True if the cache holds no entries
+		 */
+		inline bool isEmpty() const;
+
+		/** @brief Remove all expired entries */
+		inline void cleanupExpired();
+
+	private:
+		//----------------------------------------------
+		// Internal data structures
+		//----------------------------------------------
+
+		/** @brief Index value marking an empty table position or the end of the LRU list */
+		static constexpr std::uint32_t NIL{ std::numeric_limits<std::uint32_t>::max() };
+
+		/** @brief Table position returned when a key is not found */
+		static constexpr std::size_t NO_POSITION{ std::numeric_limits<std::size_t>::max() };
+
+		/** @brief Minimum number of index table positions */
+		static constexpr std::size_t MIN_INDEX_CAPACITY{ 16 };
+
+		/** @brief log2 of the number of slots per chunk */
+		static constexpr std::size_t CHUNK_SHIFT{ 8 };
+
+		/** @brief Number of slots per chunk */
+		static constexpr std::size_t CHUNK_SIZE{ std::size_t{ 1 } << CHUNK_SHIFT };
+
+		/** @brief Maximum number of slots visited per background cleanup cycle */
+		static constexpr std::size_t MAX_CLEANUP_PER_CYCLE{ 10 };
+
+		/** @brief Cached key and value with compact LRU and expiration metadata */
+		struct Slot
+		{
+			/** @brief The key, stored only here */
+			TKey key;
+
+			/** @brief The cached value */
+			TValue value;
+
+			/** @brief Previous (more recently used) slot, NIL at the head */
+			std::uint32_t lruPrev;
+
+			/** @brief Next (less recently used) slot, NIL at the tail */
+			std::uint32_t lruNext;
+
+			/** @brief Tick of the last access */
+			std::uint32_t lastAccessed;
+		};
+
+		/** @brief Raw storage for CHUNK_SIZE slots */
+		struct Chunk
+		{
+			alignas( Slot ) std::byte storage[CHUNK_SIZE * sizeof( Slot )];
+		};
+
+		mutable std::mutex m_mutex;
+		LruCacheOptions m_options;
+
+		/** @brief Construction time, the origin of all ticks */
+		std::chrono::steady_clock::time_point m_epoch;
+
+		/** @brief Default sliding expiration in ticks */
+		std::uint32_t m_defaultExpiration;
+
+		/** @brief Sliding expirations in ticks of the slots that do not use the default */
+		std::unordered_map<std::uint32_t, std::uint32_t> m_expirations;
+
+		/** @brief Open-addressing table of slot indices, linear probing, NIL when empty */
+		std::unique_ptr<std::uint32_t[]> m_index;
+		std::size_t m_indexMask{ 0 };
+
+		/** @brief Slot storage, never moved once allocated */
+		std::vector<std::unique_ptr<Chunk>> m_chunks;
+		std::vector<std::uint32_t> m_freeSlots;
+		std::uint32_t m_nextSlot{ 0 };
+
+		std::size_t m_size{ 0 };
+
+		/** @brief Most recently used slot */
+		std::uint32_t m_lruHead{ NIL };
+
+		/** @brief Least recently used slot */
+		std::uint32_t m_lruTail{ NIL };
+
+		/** @brief Tick of the last background cleanup */
+		std::uint32_t m_lastCleanup{ 0 };
+
+		/** @brief Slot the next background cleanup resumes from, NIL to start at the tail */
+		std::uint32_t m_cleanupCursor{ NIL };
+
+		/** @brief Whether the last background cleanup cycle stopped before the end of its walk */
+		bool m_cleanupPending{ false };
+
+		/** @brief Shared coarse clock (null when the steady clock is read directly) */
+		std::shared_ptr<CoarseClock> m_clock;
+
+		[[no_unique_address]] THash m_hasher;
+		[[no_unique_address]] TKeyEqual m_equal;
+
+		//----------------------------------------------
+		// Time
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the current tick
+		 * @return Ticks elapsed since construction, wrapping at 2^32
+		 */
+		[[nodiscard]] inline std::uint32_t currentTick() const noexcept;
+
+		/**
+		 * @brief Convert a duration to ticks, rounding up
+		 * @param duration Duration to convert
+		 * @return Number of ticks, saturated to the 32-bit range
+		 */
+		[[nodiscard]] static inline std::uint32_t toTicks( std::chrono::milliseconds duration ) noexcept;
+
+		/**
+		 * @brief Check if a slot has expired
+		 * @param index Slot index
+		 * @param now Current tick
+		 * @return True if the slot has been idle longer than its sliding expiration
+		 */
+		[[nodiscard]] inline bool isExpired( std::uint32_t index, std::uint32_t now ) const;
+
+		//----------------------------------------------
+		// Index table
+		//----------------------------------------------
+
+		/**
+		 * @brief Find the table position holding a key
+		 * @param key Key to look up
+		 * @return Table position, or NO_POSITION if the key is not cached
+		 */
+		[[nodiscard]] inline std::size_t findPosition( const TKey& key ) const;
+
+		/**
+		 * @brief Get the home table position of a key
+		 * @param key Key to hash
+		 * @return Position at which probing for the key starts
+		 */
+		[[nodiscard]] inline std::size_t homePosition( const TKey& key ) const;
+
+		/**
+		 * @brief Insert a slot index into the table, growing it when needed
+		 * @param index Slot index whose key is not yet in the table
+		 */
+		inline void insertIndex( std::uint32_t index );
+
+		/**
+		 * @brief Remove a table position, shifting back the rest of its probe run
+		 * @param position Table position to clear
+		 */
+		inline void erasePosition( std::size_t position );
+
+		/**
+		 * @brief Rebuild the table with the given number of positions
+		 * @param capacity New number of positions, a power of two
+		 */
+		inline void rehash( std::size_t capacity );
+
+		//----------------------------------------------
+		// Slot management
+		//----------------------------------------------
+
+		/**
+		 * @brief Get a slot by index
+		 * @param index Slot index
+		 * @return Reference to the slot
+		 */
+		[[nodiscard]] inline Slot& slotAt( std::uint32_t index ) const noexcept;
+
+		/**
+		 * @brief Reserve an unused slot index
+		 * @return Index of uninitialized slot storage
+		 */
+		inline std::uint32_t allocateSlot();
+
+		/**
+		 * @brief Remove a slot from the table, the LRU list and the expiration table, then destroy it
+		 * @param position Table position of the slot
+		 */
+		inline void eraseSlot( std::size_t position );
+
+		/** @brief Destroy every live slot */
+		inline void destroySlots() noexcept;
+
+		//----------------------------------------------
+		// LRU list management
+		//----------------------------------------------
+
+		/**
+		 * @brief Add slot to head of LRU list (most recently used)
+		 * @param index Slot index
+		 */
+		inline void addToLruHead( std::uint32_t index ) noexcept;
+
+		/**
+		 * @brief Remove slot from LRU list
+		 * @param index Slot index
+		 */
+		inline void removeFromLru( std::uint32_t index ) noexcept;
+
+		/**
+		 * @brief Stamp the access time and move the slot to the LRU head
+		 * @param index Slot index
+		 * @param now Current tick
+		 */
+		inline void touch( std::uint32_t index, std::uint32_t now ) noexcept;
+
+		//----------------------------------------------
+		// Expiration
+		//----------------------------------------------
+
+		/**
+		 * @brief Run a bounded cleanup cycle if one is due
+		 * @param now Current tick
+		 * @details Cycles run every background cleanup interval, and on every operation while
+		 *          the previous cycle left its walk unfinished
+		 */
+		inline void checkAndPerformBackgroundCleanup( std::uint32_t now );
+
+		/**
+		 * @brief Check whether checkAndPerformBackgroundCleanup() would run a cycle
+		 * @param now Current tick
+		 * @return True if cleanup is enabled and either the interval elapsed or a walk is pending
+		 */
+		[[nodiscard]] inline bool isBackgroundCleanupDue( std::uint32_t now ) const noexcept;
+
+		/**
+		 * @brief Remove expired slots, walking from the LRU tail or the cleanup cursor
+		 * @param now Current tick
+		 * @param limit Maximum number of slots to visit, the cursor records where the walk stopped
+		 * @return True if the walk finished, false if it stopped at the limit
+		 */
+		inline bool removeExpired( std::uint32_t now, std::size_t limit );
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/CompactLruCache.inl"
@@ -0,0 +1,991 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file EvictionPolicy.h
+ * @brief Eviction policies ordering intrusively linked cache entries: LRU, SLRU, 2Q, ARC, W-TinyLFU, CLOCK, CLOCK-Pro and S3-FIFO
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "nfx/memory/FrequencySketch.h"
+
+/*
+ * Eviction policy interface, implemented by every policy below:
+ * - Policy( capacity, weighted ): capacity in entries, or in weight when weighted (0 = unbounded)
+ * - onInsert( entry, hash ): a new entry was cached; if it throws, it must not have linked the entry
+ * - onAccess( entry, hash ): a cached entry was hit
+ * - onMiss( hash ): a key was looked up and not found
+ * - onRemove( entry ): an entry is about to leave the cache, whatever the cause
+ * - victim( hashOf ): choose the entry to evict next; the cache then removes it
+ * - clear(): forget every entry, keeping the access history (ghosts, frequencies)
+ * - RECENCY_ORDERED: true if oldest() returns the least recently accessed entry
+ * - CONCURRENT_ACCESS: true if onSharedAccess( entry ) records a hit with a relaxed atomic store,
+ *   so the cache serves hits under its shared lock without buffering them
+ * - RECORDS_MISSES: true if onMiss( hash ) records anything, so the cache takes its exclusive
+ *   lock for misses too instead of settling them under the shared lock
+ * The hash arguments are callables returning the key hash, evaluated only by policies that
+ * remember keys; hashOf takes the entry whose key to hash. Entries are linked through
+ * `TEntry* lruPrev`, `TEntry* lruNext`, weighed by `std::size_t size` and tagged with the
+ * list holding them in `std::uint8_t segment`; CLOCK and S3-FIFO also use `std::uint8_t referenced`.
+ */
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// SegmentedList class
+	//=====================================================================
+
+	/**
+	 * @brief Fixed set of intrusive doubly-linked lists, most recently used first
+	 * @tparam TEntry Entry type with lruPrev, lruNext, size and segment members
+	 * @tparam SEGMENTS Number of lists
+	 */
+	template <typename TEntry, std::size_t SEGMENTS>
+	class SegmentedList final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct empty lists
+		 * @param weighted True to measure lists by entry weight, false by entry count
+		 */
+		inline explicit SegmentedList( bool weighted ) noexcept;
+
+		//----------------------------------------------
+		// Modifiers
+		//----------------------------------------------
+
+		/**
+		 * @brief Link an entry at the front of a list
+		 * @param entry Unlinked entry
+		 * @param segment List to link it into, recorded in the entry
+		 */
+		inline void pushFront( TEntry* entry, std::uint8_t segment ) noexcept;
+
+		/**
+		 * @brief Unlink an entry from its list
+		 * @param entry Linked entry
+		 */
+		inline void remove( TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Move an entry to the front of a list, possibly another one
+		 * @param entry Linked entry
+		 * @param segment Destination list
+		 */
+		inline void moveToFront( TEntry* entry, std::uint8_t segment ) noexcept;
+
+		/**
+		 * @brief Forget all entries without touching them
+		 */
+		inline void clear() noexcept;
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the least recently used entry of a list
+		 * @param segment List to inspect
+		 * @return Back entry, null when the list is empty
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline TEntry* back( std::uint8_t segment ) const noexcept;
+
+		/**
+		 * @brief Get the occupancy of a list
+		 * @param segment List to measure
+		 * @return Total weight when weighted, entry count otherwise
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t load( std::uint8_t segment ) const noexcept;
+
+		/**
+		 * @brief Get the number of entries of a list
+		 * @param segment List to measure
+		 * @return Entry count
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t count( std::uint8_t segment ) const noexcept;
+
+		/**
+		 * @brief Get the occupancy one entry adds to a list
+		 * @param entry Entry to measure
+		 * @return Its weight when weighted, 1 otherwise
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t unit( const TEntry* entry ) const noexcept;
+
+	private:
+		/** @brief One list and its occupancy */
+		struct List
+		{
+			TEntry* head{ nullptr };
+			TEntry* tail{ nullptr };
+			std::size_t count{ 0 };
+			std::size_t weight{ 0 };
+		};
+
+		std::array<List, SEGMENTS> m_lists{};
+		bool m_weighted;
+	};
+
+	//=====================================================================
+	// GhostList class
+	//=====================================================================
+
+	/**
+	 * @brief Bounded recency-ordered set of key hashes of recently evicted entries
+	 * @details Hashes are appended to a ring in push order and found through an open-addressing
+	 *          index of ring positions. Both are allocated by the constructor with room for
+	 *          twice the capacity, so pushes never allocate: an erased ghost only leaves a dead
+	 *          ring slot, and a full ring is compacted in place once dead slots make up half of
+	 *          it. Without a capacity, as for weighted caches whose entry count is unknown, the
+	 *          ring doubles instead, so allocations stay amortized over as many pushes.
+	 */
+	class GhostList final
+	{
+	public:
+		/**
+		 * @brief Construct an empty ghost list
+		 * @param capacity Largest number of ghosts the owner keeps through trim() (0 = unknown, grown on demand)
+		 */
+		inline explicit GhostList( std::size_t capacity );
+
+		/**
+		 * @brief Remember a key hash as the most recent ghost
+		 * @param hash Key hash
+		 */
+		inline void push( std::uint64_t hash );
+
+		/**
+		 * @brief Forget a key hash
+		 * @param hash Key hash
+		 * @return True if it was remembered
+		 */
+		inline bool erase( std::uint64_t hash ) noexcept;
+
+		/**
+		 * @brief Forget the oldest ghosts beyond a count
+		 * @param maxCount Number of ghosts to keep
+		 * @return Number of ghosts forgotten
+		 */
+		inline std::size_t trim( std::size_t maxCount ) noexcept;
+
+		/**
+		 * @brief Get the number of ghosts
+		 * @return Remembered key hashes
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t size() const noexcept;
+
+	private:
+		/** @brief Index slot holding no ring position */
+		static constexpr std::uint32_t EMPTY = UINT32_MAX;
+
+		/** @brief Largest ring, so that positions fit the 32-bit index */
+		static constexpr std::size_t MAX_RING_SIZE = std::size_t{ 1 } << 31;
+
+		/** @brief Ring size a list without capacity starts from */
+		static constexpr std::size_t MIN_RING_SIZE = 16;
+
+		/** @brief Key hashes in push order from m_head, including dead slots of erased ghosts */
+		std::vector<std::uint64_t> m_ring;
+
+		/** @brief Ring position of every remembered hash, linear probing, EMPTY when free */
+		std::vector<std::uint32_t> m_index;
+
+		std::size_t m_head{ 0 };
+		std::size_t m_used{ 0 };
+		std::size_t m_size{ 0 };
+		int m_indexShift{ 64 };
+		bool m_growable;
+
+		/**
+		 * @brief Allocate an empty ring and index
+		 * @param ringSize Number of ring slots
+		 */
+		inline void allocate( std::size_t ringSize );
+
+		/**
+		 * @brief Free at least one ring slot before a push
+		 * @details Compacts when dead slots make up half of the ring, otherwise doubles a list
+		 *          without capacity or forgets the oldest ghost
+		 */
+		inline void makeRoom();
+
+		/**
+		 * @brief Move the live ghosts to the front of the ring, in order, and rebuild the index
+		 */
+		inline void compact() noexcept;
+
+		/**
+		 * @brief Forget the oldest ghost, dropping the dead slots before it
+		 */
+		inline void popOldest() noexcept;
+
+		/**
+		 * @brief Find the index slot of a hash
+		 * @param hash Key hash
+		 * @return Slot holding its ring position, or the free slot ending its probe
+		 */
+		[[nodiscard]] inline std::size_t findSlot( std::uint64_t hash ) const noexcept;
+
+		/**
+		 * @brief Store the ring position of a hash known to be absent from the index
+		 * @param position Ring position holding the hash
+		 */
+		inline void insertSlot( std::size_t position ) noexcept;
+
+		/**
+		 * @brief Free an index slot, shifting back the entries probing past it
+		 * @param slot Index slot in use
+		 */
+		inline void removeSlot( std::size_t slot ) noexcept;
+	};
+
+	//=====================================================================
+	// ClockRing class
+	//=====================================================================
+
+	/**
+	 * @brief Intrusive circular list swept by a clock hand
+	 * @details Entries are linked through lruPrev and lruNext. The hand moves along lruNext;
+	 *          new entries are linked just behind it, so a full sweep passes them last.
+	 * @tparam TEntry Entry type with lruPrev, lruNext, size, segment and referenced members
+	 */
+	template <typename TEntry>
+	class ClockRing final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct an empty ring
+		 * @param weighted True to measure the ring by entry weight, false by entry count
+		 */
+		inline explicit ClockRing( bool weighted ) noexcept;
+
+		//----------------------------------------------
+		// Modifiers
+		//----------------------------------------------
+
+		/**
+		 * @brief Link an entry just behind the hand, with its reference bit clear
+		 * @param entry Unlinked entry
+		 * @param segment Tag recorded in the entry
+		 */
+		inline void insert( TEntry* entry, std::uint8_t segment ) noexcept;
+
+		/**
+		 * @brief Unlink an entry, moving the hand past it if it points at it
+		 * @param entry Linked entry
+		 */
+		inline void remove( TEntry* entry ) noexcept;
+
+		/** @brief Move the hand to the next entry */
+		inline void advance() noexcept;
+
+		/** @brief Forget all entries without touching them */
+		inline void clear() noexcept;
+
+		//----------------------------------------------
+		// Reference bits
+		//----------------------------------------------
+
+		/**
+		 * @brief Set the reference bit of an entry
+		 * @param entry Cached entry, possibly hit concurrently by other threads
+		 * @details A single relaxed store, safe under a shared lock
+		 */
+		static inline void reference( TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Clear the reference bit of an entry
+		 * @param entry Cached entry, with no concurrent hits
+		 * @return True if the bit was set
+		 */
+		static inline bool clearReference( TEntry* entry ) noexcept;
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the entry under the hand
+		 * @return Next entry to examine, null when the ring is empty
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline TEntry* hand() const noexcept;
+
+		/**
+		 * @brief Get the occupancy of the ring
+		 * @return Total weight when weighted, entry count otherwise
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t load() const noexcept;
+
+		/**
+		 * @brief Get the number of entries of the ring
+		 * @return Entry count
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t count() const noexcept;
+
+		/**
+		 * @brief Get the occupancy one entry adds to the ring
+		 * @param entry Entry to measure
+		 * @return Its weight when weighted, 1 otherwise
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t unit( const TEntry* entry ) const noexcept;
+
+	private:
+		TEntry* m_hand{ nullptr };
+		std::size_t m_count{ 0 };
+		std::size_t m_weight{ 0 };
+		bool m_weighted;
+	};
+
+	//=====================================================================
+	// LruPolicy class
+	//=====================================================================
+
+	/**
+	 * @brief Least recently used: a hit moves the entry to the front, the back is evicted
+	 * @tparam TEntry Intrusively linked entry type
+	 */
+	template <typename TEntry>
+	class LruPolicy final
+	{
+	public:
+		/** @brief The back of the list is the least recently accessed entry */
+		static constexpr bool RECENCY_ORDERED = true;
+
+		/** @brief Hits reorder lists and need the exclusive lock */
+		static constexpr bool CONCURRENT_ACCESS = false;
+
+		/** @brief Misses are not tracked */
+		static constexpr bool RECORDS_MISSES = false;
+
+		/**
+		 * @brief Construct an empty policy
+		 * @param capacity Cache capacity (unused)
+		 * @param weighted True if capacity is a weight (unused)
+		 */
+		inline LruPolicy( std::size_t capacity, bool weighted ) noexcept;
+
+		/** @brief Link a new entry at the front */
+		template <typename THashFn>
+		inline void onInsert( TEntry* entry, const THashFn& hash ) noexcept;
+
+		/** @brief Move a hit entry to the front */
+		template <typename THashFn>
+		inline void onAccess( TEntry* entry, const THashFn& hash ) noexcept;
+
+		/** @brief Misses are not tracked */
+		template <typename THashFn>
+		inline void onMiss( const THashFn& hash ) noexcept;
+
+		/** @brief Unlink a leaving entry */
+		inline void onRemove( TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Choose the least recently used entry
+		 * @return Entry to evict, null when empty
+		 */
+		template <typename THashOf>
+		[[nodiscard]] inline TEntry* victim( const THashOf& hashOf ) noexcept;
+
+		/**
+		 * @brief Get the least recently accessed entry
+		 * @return Back entry, null when empty
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline TEntry* oldest() const noexcept;
+
+		/** @brief Forget all entries */
+		inline void clear() noexcept;
+
+	private:
+		SegmentedList<TEntry, 1> m_lists;
+	};
+
+	//=====================================================================
+	// SlruPolicy class
+	//=====================================================================
+
+	/**
+	 * @brief Segmented LRU: entries hit at least twice are protected from one-off entries
+	 * @details New entries go on probation. A hit on probation promotes the entry to the
+	 *          protected segment (80% of the capacity), whose least recent entries are demoted
+	 *          back to probation. Victims come from probation first.
+	 * @tparam TEntry Intrusively linked entry type
+	 */
+	template <typename TEntry>
+	class SlruPolicy final
+	{
+	public:
+		/** @brief Segments are not merged in recency order */
+		static constexpr bool RECENCY_ORDERED = false;
+
+		/** @brief Hits reorder lists and need the exclusive lock */
+		static constexpr bool CONCURRENT_ACCESS = false;
+
+		/** @brief Misses are not tracked */
+		static constexpr bool RECORDS_MISSES = false;
+
+		/**
+		 * @brief Construct an empty policy
+		 * @param capacity Cache capacity (0 = unbounded)
+		 * @param weighted True if capacity is a weight
+		 */
+		inline SlruPolicy( std::size_t capacity, bool weighted ) noexcept;
+
+		/** @brief Put a new entry on probation */
+		template <typename THashFn>
+		inline void onInsert( TEntry* entry, const THashFn& hash ) noexcept;
+
+		/** @brief Promote a hit entry to the front of the protected segment */
+		template <typename THashFn>
+		inline void onAccess( TEntry* entry, const THashFn& hash ) noexcept;
+
+		/** @brief Misses are not tracked */
+		template <typename THashFn>
+		inline void onMiss( const THashFn& hash ) noexcept;
+
+		/** @brief Unlink a leaving entry */
+		inline void onRemove( TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Choose the least recent entry on probation, else the least recent protected one
+		 * @return Entry to evict, null when empty
+		 */
+		template <typename THashOf>
+		[[nodiscard]] inline TEntry* victim( const THashOf& hashOf ) noexcept;
+
+		/** @brief Forget all entries */
+		inline void clear() noexcept;
+
+	private:
+		static constexpr std::uint8_t PROBATION = 0;
+		static constexpr std::uint8_t PROTECTED = 1;
+
+		SegmentedList<TEntry, 2> m_lists;
+
+		/** @brief Occupancy above which protected entries are demoted */
+		std::size_t m_protectedCapacity;
+	};
+
+	//=====================================================================
+	// TwoQueuePolicy class
+	//=====================================================================
+
+	/**
+	 * @brief 2Q: a FIFO for first references, an LRU for keys seen again after eviction
+	 * @details New entries enter the A1in FIFO (25% of the capacity), where hits do not reorder
+	 *          them. Keys evicted from A1in are remembered in the A1out ghost list; a key found
+	 *          there on insertion goes straight to the Am LRU. Victims come from A1in while it
+	 *          exceeds its share, otherwise from the back of Am.
+	 * @tparam TEntry Intrusively linked entry type
+	 */
+	template <typename TEntry>
+	class TwoQueuePolicy final
+	{
+	public:
+		/** @brief Queues are not merged in recency order */
+		static constexpr bool RECENCY_ORDERED = false;
+
+		/** @brief Hits reorder lists and need the exclusive lock */
+		static constexpr bool CONCURRENT_ACCESS = false;
+
+		/** @brief Misses are not tracked */
+		static constexpr bool RECORDS_MISSES = false;
+
+		/**
+		 * @brief Construct an empty policy
+		 * @param capacity Cache capacity (0 = unbounded)
+		 * @param weighted True if capacity is a weight
+		 */
+		inline TwoQueuePolicy( std::size_t capacity, bool weighted );
+
+		/** @brief Queue a new entry in A1in, or in Am if its key is a ghost */
+		template <typename THashFn>
+		inline void onInsert( TEntry* entry, const THashFn& hash );
+
+		/** @brief Move a hit Am entry to the front, A1in entries stay in place */
+		template <typename THashFn>
+		inline void onAccess( TEntry* entry, const THashFn& hash ) noexcept;
+
+		/** @brief Misses are not tracked */
+		template <typename THashFn>
+		inline void onMiss( const THashFn& hash ) noexcept;
+
+		/** @brief Unlink a leaving entry */
+		inline void onRemove( TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Choose the oldest A1in entry while A1in is over its share, else the back of Am
+		 * @param hashOf Callable hashing the key of an entry, for the ghost list
+		 * @return Entry to evict, null when empty
+		 */
+		template <typename THashOf>
+		[[nodiscard]] inline TEntry* victim( const THashOf& hashOf );
+
+		/** @brief Forget all entries, keeping the ghosts */
+		inline void clear() noexcept;
+
+	private:
+		static constexpr std::uint8_t A1IN = 0;
+		static constexpr std::uint8_t AM = 1;
+
+		SegmentedList<TEntry, 2> m_lists;
+
+		/** @brief Key hashes evicted from A1in, at most half as many as cached entries */
+		GhostList m_a1out;
+
+		/** @brief Share of A1in, above which it supplies the victims */
+		std::size_t m_a1inCapacity;
+	};
+
+	//=====================================================================
+	// ArcPolicy class
+	//=====================================================================
+
+	/**
+	 * @brief Adaptive Replacement Cache: balances recency and frequency from eviction feedback
+	 * @details T1 holds entries hit once, T2 entries hit again. Keys evicted from each are
+	 *          remembered in the ghost lists B1 and B2. A new key found in B1 means T1 was too
+	 *          small and grows its target size; one found in B2 shrinks it. Victims come from T1
+	 *          while it exceeds its target, otherwise from T2.
+	 * @tparam TEntry Intrusively linked entry type
+	 */
+	template <typename TEntry>
+	class ArcPolicy final
+	{
+	public:
+		/** @brief Lists are not merged in recency order */
+		static constexpr bool RECENCY_ORDERED = false;
+
+		/** @brief Hits reorder lists and need the exclusive lock */
+		static constexpr bool CONCURRENT_ACCESS = false;
+
+		/** @brief Misses are not tracked */
+		static constexpr bool RECORDS_MISSES = false;
+
+		/**
+		 * @brief Construct an empty policy
+		 * @param capacity Cache capacity (0 = unbounded)
+		 * @param weighted True if capacity is a weight
+		 */
+		inline ArcPolicy( std::size_t capacity, bool weighted );
+
+		/** @brief Link a new entry into T1, or into T2 after adapting the target if it is a ghost */
+		template <typename THashFn>
+		inline void onInsert( TEntry* entry, const THashFn& hash );
+
+		/** @brief Move a hit entry to the front of T2 */
+		template <typename THashFn>
+		inline void onAccess( TEntry* entry, const THashFn& hash ) noexcept;
+
+		/** @brief Misses are not tracked */
+		template <typename THashFn>
+		inline void onMiss( const THashFn& hash ) noexcept;
+
+		/** @brief Unlink a leaving entry */
+		inline void onRemove( TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Choose the back of T1 while it exceeds its target, else the back of T2
+		 * @param hashOf Callable hashing the key of an entry, for the ghost lists
+		 * @return Entry to evict, null when empty
+		 */
+		template <typename THashOf>
+		[[nodiscard]] inline TEntry* victim( const THashOf& hashOf );
+
+		/** @brief Forget all entries, keeping the ghosts and the target */
+		inline void clear() noexcept;
+
+		/**
+		 * @brief Get the current target occupancy of T1
+		 * @return Target in entries or weight
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t recencyTarget() const noexcept;
+
+	private:
+		static constexpr std::uint8_t T1 = 0;
+		static constexpr std::uint8_t T2 = 1;
+
+		SegmentedList<TEntry, 2> m_lists;
+
+		/** @brief Ghosts of entries evicted from T1 */
+		GhostList m_b1;
+
+		/** @brief Ghosts of entries evicted from T2 */
+		GhostList m_b2;
+
+		/** @brief Cache capacity, bounding the target */
+		std::size_t m_capacity;
+
+		/** @brief Target occupancy of T1 (p in the ARC paper) */
+		std::size_t m_target{ 0 };
+	};
+
+	//=====================================================================
+	// WTinyLfuPolicy class
+	//=====================================================================
+
+	/**
+	 * @brief Window TinyLFU: a small LRU window in front of an SLRU main region guarded by frequency
+	 * @details New entries enter an admission window holding 1% of the capacity. The rest is a
+	 *          segmented LRU: probation (20%) and protected (80%). When the cache is full, the
+	 *          window's least recent entry (candidate) competes with the probation victim: a
+	 *          FrequencySketch of recent accesses, misses included, keeps the more frequent one.
+	 *          One-off keys, e.g. from a scan, pass through the window without displacing the
+	 *          frequently used entries of the main region.
+	 * @tparam TEntry Intrusively linked entry type
+	 */
+	template <typename TEntry>
+	class WTinyLfuPolicy final
+	{
+	public:
+		/** @brief Regions are not merged in recency order */
+		static constexpr bool RECENCY_ORDERED = false;
+
+		/** @brief Hits reorder lists and need the exclusive lock */
+		static constexpr bool CONCURRENT_ACCESS = false;
+
+		/** @brief Misses are counted in the frequency sketch, which needs the exclusive lock */
+		static constexpr bool RECORDS_MISSES = true;
+
+		/**
+		 * @brief Construct an empty policy
+		 * @param capacity Cache capacity (0 = unbounded)
+		 * @param weighted True if capacity is a weight
+		 */
+		inline WTinyLfuPolicy( std::size_t capacity, bool weighted );
+
+		/** @brief Count the access and link a new entry into the window */
+		template <typename THashFn>
+		inline void onInsert( TEntry* entry, const THashFn& hash );
+
+		/** @brief Count the access and move the entry forward, promoting it off probation */
+		template <typename THashFn>
+		inline void onAccess( TEntry* entry, const THashFn& hash );
+
+		/** @brief Count the access, so keys requested before they are loaded compete for admission */
+		template <typename THashFn>
+		inline void onMiss( const THashFn& hash );
+
+		/** @brief Unlink a leaving entry */
+		inline void onRemove( TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Evict the less frequent of the window candidate and the main region victim
+		 * @param hashOf Callable hashing the key of an entry, for the frequency estimates
+		 * @return Entry to evict, null when empty; a winning candidate moves to probation
+		 */
+		template <typename THashOf>
+		[[nodiscard]] inline TEntry* victim( const THashOf& hashOf );
+
+		/** @brief Forget all entries, keeping the frequencies */
+		inline void clear() noexcept;
+
+	private:
+		static constexpr std::uint8_t WINDOW = 0;
+		static constexpr std::uint8_t PROBATION = 1;
+		static constexpr std::uint8_t PROTECTED = 2;
+
+		SegmentedList<TEntry, 3> m_lists;
+		FrequencySketch m_sketch;
+
+		/** @brief Capacity of the admission window */
+		std::size_t m_windowCapacity;
+
+		/** @brief Occupancy above which protected entries are demoted */
+		std::size_t m_protectedCapacity;
+	};
+
+	//=====================================================================
+	// ClockPolicy class
+	//=====================================================================
+
+	/**
+	 * @brief CLOCK: second-chance FIFO where a hit only sets a reference bit
+	 * @details Entries sit on a ring swept by a hand. A hit sets the entry's reference bit
+	 *          with a relaxed store and never relinks it, so the cache serves hits under its
+	 *          shared lock. On eviction the hand clears the bits it passes and stops at the
+	 *          first entry not referenced since the previous sweep.
+	 * @tparam TEntry Intrusively linked entry type
+	 */
+	template <typename TEntry>
+	class ClockPolicy final
+	{
+	public:
+		/** @brief The ring is in insertion order, not access order */
+		static constexpr bool RECENCY_ORDERED = false;
+
+		/** @brief Hits only set the reference bit */
+		static constexpr bool CONCURRENT_ACCESS = true;
+
+		/** @brief Misses are not tracked */
+		static constexpr bool RECORDS_MISSES = false;
+
+		/**
+		 * @brief Construct an empty policy
+		 * @param capacity Cache capacity (unused)
+		 * @param weighted True if capacity is a weight
+		 */
+		inline ClockPolicy( std::size_t capacity, bool weighted ) noexcept;
+
+		/** @brief Link a new entry behind the hand */
+		template <typename THashFn>
+		inline void onInsert( TEntry* entry, const THashFn& hash ) noexcept;
+
+		/** @brief Set the reference bit of a hit entry */
+		template <typename THashFn>
+		inline void onAccess( TEntry* entry, const THashFn& hash ) noexcept;
+
+		/**
+		 * @brief Set the reference bit of an entry hit under the shared lock
+		 * @param entry Cached entry
+		 */
+		inline void onSharedAccess( TEntry* entry ) noexcept;
+
+		/** @brief Misses are not tracked */
+		template <typename THashFn>
+		inline void onMiss( const THashFn& hash ) noexcept;
+
+		/** @brief Unlink a leaving entry */
+		inline void onRemove( TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Sweep the hand to the first entry whose reference bit is clear
+		 * @return Entry to evict, null when empty
+		 */
+		template <typename THashOf>
+		[[nodiscard]] inline TEntry* victim( const THashOf& hashOf ) noexcept;
+
+		/** @brief Forget all entries */
+		inline void clear() noexcept;
+
+	private:
+		ClockRing<TEntry> m_ring;
+	};
+
+	//=====================================================================
+	// ClockProPolicy class
+	//=====================================================================
+
+	/**
+	 * @brief CLOCK-Pro: CLOCK split into hot and cold entries by reuse distance
+	 * @details New entries are cold and start a test period. A cold entry referenced during
+	 *          its test period, or a key inserted again while its evicted entry is still
+	 *          remembered as a non-resident test ghost, becomes hot. The cold hand evicts
+	 *          unreferenced cold entries; the hot hand demotes unreferenced hot entries to cold
+	 *          while hot entries exceed the capacity left by the cold target. A test ghost hit
+	 *          grows the cold target, a ghost forgotten unused shrinks it. Hits only set the
+	 *          reference bit, as with ClockPolicy.
+	 * @tparam TEntry Intrusively linked entry type
+	 */
+	template <typename TEntry>
+	class ClockProPolicy final
+	{
+	public:
+		/** @brief The rings are in insertion order, not access order */
+		static constexpr bool RECENCY_ORDERED = false;
+
+		/** @brief Hits only set the reference bit */
+		static constexpr bool CONCURRENT_ACCESS = true;
+
+		/** @brief Misses are not tracked */
+		static constexpr bool RECORDS_MISSES = false;
+
+		/**
+		 * @brief Construct an empty policy
+		 * @param capacity Cache capacity (0 = unbounded)
+		 * @param weighted True if capacity is a weight
+		 */
+		inline ClockProPolicy( std::size_t capacity, bool weighted );
+
+		/** @brief Link a new entry as cold in its test period, or as hot if its key is a test ghost */
+		template <typename THashFn>
+		inline void onInsert( TEntry* entry, const THashFn& hash );
+
+		/** @brief Set the reference bit of a hit entry */
+		template <typename THashFn>
+		inline void onAccess( TEntry* entry, const THashFn& hash ) noexcept;
+
+		/**
+		 * @brief Set the reference bit of an entry hit under the shared lock
+		 * @param entry Cached entry
+		 */
+		inline void onSharedAccess( TEntry* entry ) noexcept;
+
+		/** @brief Misses are not tracked */
+		template <typename THashFn>
+		inline void onMiss( const THashFn& hash ) noexcept;
+
+		/** @brief Unlink a leaving entry */
+		inline void onRemove( TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Run the hot hand while hot entries are over their share, then the cold hand to an unreferenced cold entry
+		 * @param hashOf Callable hashing the key of an entry, for the test ghosts
+		 * @return Entry to evict, null when empty
+		 */
+		template <typename THashOf>
+		[[nodiscard]] inline TEntry* victim( const THashOf& hashOf );
+
+		/** @brief Forget all entries, keeping the test ghosts and the cold target */
+		inline void clear() noexcept;
+
+		/**
+		 * @brief Get the current target occupancy of cold entries
+		 * @return Target in entries or weight
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t coldTarget() const noexcept;
+
+	private:
+		static constexpr std::uint8_t COLD = 0;
+		static constexpr std::uint8_t COLD_TEST = 1;
+		static constexpr std::uint8_t HOT = 2;
+
+		/** @brief Demote the entry under the hot hand if unreferenced, else give it another sweep */
+		inline void runHotHand() noexcept;
+
+		ClockRing<TEntry> m_cold;
+		ClockRing<TEntry> m_hot;
+
+		/** @brief Key hashes of cold entries evicted during their test period */
+		GhostList m_test;
+
+		/** @brief Cache capacity, bounding the cold target */
+		std::size_t m_capacity;
+
+		/** @brief Target occupancy of cold entries */
+		std::size_t m_coldTarget;
+	};
+
+	//=====================================================================
+	// S3FifoPolicy class
+	//=====================================================================
+
+	/**
+	 * @brief S3-FIFO: a small probationary FIFO, a main FIFO and a ghost FIFO of evicted keys
+	 * @details New entries enter the small FIFO (10% of the capacity), or the main FIFO if their
+	 *          key is a ghost. A hit only bumps a 2-bit access counter with relaxed atomics, so
+	 *          the cache serves hits under its shared lock and no list is ever reordered by one.
+	 *          Entries leaving the small FIFO move to the main FIFO if they were hit there,
+	 *          otherwise they are evicted and their key becomes a ghost. Entries leaving the main
+	 *          FIFO are reinserted with their counter decremented until it reaches zero.
+	 * @tparam TEntry Intrusively linked entry type
+	 */
+	template <typename TEntry>
+	class S3FifoPolicy final
+	{
+	public:
+		/** @brief The queues are in insertion order, not access order */
+		static constexpr bool RECENCY_ORDERED = false;
+
+		/** @brief Hits only bump the access counter */
+		static constexpr bool CONCURRENT_ACCESS = true;
+
+		/** @brief Misses are not tracked */
+		static constexpr bool RECORDS_MISSES = false;
+
+		/** @brief Saturation value of the 2-bit access counter */
+		static constexpr std::uint8_t MAX_FREQUENCY = 3;
+
+		/**
+		 * @brief Construct an empty policy
+		 * @param capacity Cache capacity (0 = unbounded)
+		 * @param weighted True if capacity is a weight
+		 */
+		inline S3FifoPolicy( std::size_t capacity, bool weighted );
+
+		/** @brief Queue a new entry in the small FIFO, or in the main FIFO if its key is a ghost */
+		template <typename THashFn>
+		inline void onInsert( TEntry* entry, const THashFn& hash );
+
+		/** @brief Bump the access counter of a hit entry */
+		template <typename THashFn>
+		inline void onAccess( TEntry* entry, const THashFn& hash ) noexcept;
+
+		/**
+		 * @brief Bump the access counter of an entry hit under the shared lock
+		 * @param entry Cached entry
+		 */
+		inline void onSharedAccess( TEntry* entry ) noexcept;
+
+		/** @brief Misses are not tracked */
+		template <typename THashFn>
+		inline void onMiss( const THashFn& hash ) noexcept;
+
+		/** @brief Unlink a leaving entry */
+		inline void onRemove( TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Drain the small FIFO while it is over its share, else the main FIFO, to an entry not hit since it was queued
+		 * @param hashOf Callable hashing the key of an entry, for the ghost FIFO
+		 * @return Entry to evict, null when empty
+		 */
+		template <typename THashOf>
+		[[nodiscard]] inline TEntry* victim( const THashOf& hashOf );
+
+		/** @brief Forget all entries, keeping the ghosts */
+		inline void clear() noexcept;
+
+	private:
+		static constexpr std::uint8_t SMALL = 0;
+		static constexpr std::uint8_t MAIN = 1;
+
+		SegmentedList<TEntry, 2> m_lists;
+
+		/** @brief Key hashes evicted from the small FIFO, at most as many as main FIFO entries */
+		GhostList m_ghosts;
+
+		/** @brief Share of the small FIFO, above which it supplies the victims */
+		std::size_t m_smallCapacity;
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/EvictionPolicy.inl"
@@ -0,0 +1,607 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file FlatHashMap.h
+ * @brief Open-addressing hash map with SIMD control-byte probing and stable entry addresses
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#	define NFX_LRUCACHE_FLAT_HASH_MAP_SSE2 1
+#	include <emmintrin.h>
+#endif
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// FlatHashMap class
+	//=====================================================================
+
+	/**
+	 * @brief Swiss-table style hash map used as the flat LruCache storage engine
+	 * @tparam TKey Key type
+	 * @tparam TMapped Mapped type
+	 * @tparam THash Hash function type, transparent to enable heterogeneous find()
+	 * @tparam TKeyEqual Key equality type, transparent to enable heterogeneous find()
+	 * @tparam TAllocator Allocator rebound for the probe table, entry block and entry chunks
+	 * @details Keys and values are stored inline in a contiguous array of entries, addressed
+	 *          by 32-bit index. The probe table is an array of cache-line groups, each holding
+	 *          16 control bytes and the entry indices of its first 12 slots; the last four
+	 *          control bytes are padding that never matches. A probe compares the control
+	 *          bytes of a group with one SSE2 instruction (or a portable SWAR fallback) and
+	 *          only reads the entry of a slot whose byte matches, so a hit reads one line of
+	 *          the probe table and then the entry. Control bytes hold 7 bits of the hash, or
+	 *          mark a slot empty or deleted.
+	 *
+	 *          reserve() on a map that has not stored anything yet allocates the entries it
+	 *          asks for as a single block; entries beyond it go to fixed-size chunks. Entries
+	 *          never move and erased ones are reused through a free list threaded through
+	 *          their storage, so references and pointers to keys and values stay valid until
+	 *          the entry is erased, exactly as with std::unordered_map. Growing and reclaiming
+	 *          tombstones only rebuild the probe table of indices. The interface is the subset
+	 *          of std::unordered_map used by LruCache, plus hash(), find() with a precomputed
+	 *          hash and prefetching so that batched lookups can overlap their cache misses.
+	 */
+	template <typename TKey, typename TMapped, typename THash = std::hash<TKey>, typename TKeyEqual = std::equal_to<TKey>,
+		typename TAllocator = std::allocator<std::pair<const TKey, TMapped>>>
+	class FlatHashMap final
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		using key_type = TKey;
+		using mapped_type = TMapped;
+		using size_type = std::size_t;
+		using allocator_type = TAllocator;
+
+		/** @brief Number of control bytes compared by one probe */
+		static constexpr std::size_t GROUP_WIDTH = 16;
+
+		/** @brief Number of slots of a group, the control bytes past them are padding */
+		static constexpr std::size_t GROUP_SLOTS = 12;
+
+		/** @brief Key and value references produced by dereferencing an iterator */
+		struct reference
+		{
+			/** @brief The entry key */
+			const TKey& first;
+
+			/** @brief The entry value */
+			TMapped& second;
+		};
+
+		/** @brief Forward iterator over occupied slots, in probe table order */
+		class iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = std::pair<const TKey, TMapped>;
+			using reference = typename FlatHashMap::reference;
+
+			/** @brief Proxy giving operator-> access to the reference members */
+			struct pointer
+			{
+				reference ref;
+
+				const reference* operator->() const noexcept
+				{
+					return &ref;
+				}
+			};
+
+			/** @brief Construct an end iterator of no map */
+			iterator() = default;
+
+			/** @brief Access the entry */
+			inline reference operator*() const noexcept;
+
+			/** @brief Access the entry members */
+			inline pointer operator->() const noexcept;
+
+			/** @brief Advance to the next occupied slot */
+			inline iterator& operator++() noexcept;
+
+			/** @brief Advance to the next occupied slot */
+			inline iterator operator++( int ) noexcept;
+
+			/** @brief Compare positions */
+			bool operator==( const iterator& other ) const noexcept = default;
+
+		private:
+			friend class FlatHashMap;
+
+			inline iterator( FlatHashMap* map, std::size_t position ) noexcept;
+
+			FlatHashMap* m_map{ nullptr };
+			std::size_t m_position{ 0 };
+		};
+
+		/** @brief Key and value moved out of the map by extract() */
+		class node_type
+		{
+		public:
+			/** @brief Access the extracted key */
+			TKey& key() noexcept
+			{
+				return m_key;
+			}
+
+			/** @brief Access the extracted value */
+			TMapped& mapped() noexcept
+			{
+				return m_mapped;
+			}
+
+		private:
+			friend class FlatHashMap;
+
+			inline node_type( TKey&& key, TMapped&& mapped );
+
+			TKey m_key;
+			TMapped m_mapped;
+		};
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/** @brief Construct an empty map, the probe table is allocated on first insertion */
+		FlatHashMap() = default;
+
+		/**
+		 * @brief Construct an empty map using an allocator
+		 * @param allocator Allocator for all internal storage
+		 */
+		inline explicit FlatHashMap( const TAllocator& allocator );
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		FlatHashMap( const FlatHashMap& ) = delete;
+		FlatHashMap( FlatHashMap&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		FlatHashMap& operator=( const FlatHashMap& ) = delete;
+		FlatHashMap& operator=( FlatHashMap&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Destroy all entries */
+		inline ~FlatHashMap();
+
+		//----------------------------------------------
+		// Iterators
+		//----------------------------------------------
+
+		/**
+		 * @brief Get an iterator to the first entry
+		 * @return Iterator to the first occupied slot, end() when empty
+		 */
+		inline iterator begin() noexcept;
+
+		/**
+		 * @brief Get the past-the-end iterator
+		 * @return End iterator
+		 */
+		inline iterator end() noexcept;
+
+		//----------------------------------------------
+		// Capacity
+		//----------------------------------------------
+
+		/**
+		 * @brief Check whether the map holds no entry
+		 * @return True if empty
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool empty() const noexcept;
+
+		/**
+		 * @brief Get the number of entries
+		 * @return Entry count
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline size_type size() const noexcept;
+
+		/**
+		 * @brief Size the probe table and the entry storage for a number of entries
+		 * @param count Expected number of entries
+		 * @details Up to count entries then never grow the probe table. On a map that has not
+		 *          stored anything yet, their storage is allocated as one contiguous block.
+		 * @throws std::length_error if count exceeds the 32-bit entry index range
+		 */
+		inline void reserve( size_type count );
+
+		//----------------------------------------------
+		// Observers
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the hash function
+		 * @return Copy of the hash function used by the map
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline THash hash_function() const;
+
+		//----------------------------------------------
+		// Lookup
+		//----------------------------------------------
+
+		/**
+		 * @brief Find an entry
+		 * @tparam TLookup Key type, or a heterogeneous key when THash and TKeyEqual are transparent
+		 * @param key Key to find
+		 * @return Iterator to the entry, end() if absent
+		 * @details Does not modify the map, so concurrent calls are safe
+		 */
+		template <typename TLookup>
+		inline iterator find( const TLookup& key );
+
+		/**
+		 * @brief Find an entry whose hash was computed beforehand
+		 * @tparam TLookup Key type, or a heterogeneous key when THash and TKeyEqual are transparent
+		 * @param key Key to find
+		 * @param hash Mixed hash of the key, as returned by hash()
+		 * @return Iterator to the entry, end() if absent
+		 * @details Does not modify the map, so concurrent calls are safe
+		 */
+		template <typename TLookup>
+		inline iterator find( const TLookup& key, std::size_t hash );
+
+		//----------------------------------------------
+		// Prefetching
+		//----------------------------------------------
+
+		/**
+		 * @brief Compute the mixed hash a lookup of a key probes with
+		 * @tparam TLookup Key type, or a heterogeneous key when THash and TKeyEqual are transparent
+		 * @param key Key to hash
+		 * @return Mixed hash, to pass to prefetchGroup(), prefetchEntries() and find()
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		template <typename TLookup>
+		[[nodiscard]] inline std::size_t hash( const TLookup& key ) const;
+
+		/**
+		 * @brief Prefetch the control bytes and entry indices of the first probe group of a hash
+		 * @param hash Mixed hash, as returned by hash()
+		 */
+		inline void prefetchGroup( std::size_t hash ) const noexcept;
+
+		/**
+		 * @brief Prefetch the entries of the first probe group whose control byte matches a hash
+		 * @param hash Mixed hash, as returned by hash()
+		 * @details Reads the control bytes and matching indices of the group, so it stalls
+		 *          less once the prefetchGroup() of the same hash has had time to complete
+		 */
+		inline void prefetchEntries( std::size_t hash ) const noexcept;
+
+		//----------------------------------------------
+		// Modifiers
+		//----------------------------------------------
+
+		/**
+		 * @brief Insert an entry constructed in place if the key is absent
+		 * @param key Key to insert, moved from only when inserted
+		 * @param args Arguments forwarded to the TMapped constructor
+		 * @return Iterator to the entry with this key and whether it was inserted
+		 * @throws std::length_error if the map already holds the maximum number of entries
+		 */
+		template <typename... TArgs>
+		inline std::pair<iterator, bool> try_emplace( TKey&& key, TArgs&&... args );
+
+		/**
+		 * @brief Insert a copy of the key if absent
+		 * @param key Key to insert
+		 * @param args Arguments forwarded to the TMapped constructor
+		 * @return Iterator to the entry with this key and whether it was inserted
+		 */
+		template <typename... TArgs>
+		inline std::pair<iterator, bool> try_emplace( const TKey& key, TArgs&&... args );
+
+		/**
+		 * @brief Erase an entry
+		 * @param it Iterator to a valid entry
+		 * @return Iterator to the next entry, other iterators stay valid
+		 */
+		inline iterator erase( iterator it );
+
+		/**
+		 * @brief Move an entry's key and value out of the map and erase it
+		 * @param it Iterator to a valid entry
+		 * @return Node owning the key and value
+		 */
+		inline node_type extract( iterator it );
+
+		/**
+		 * @brief Destroy every entry, keeping allocated memory for reuse
+		 */
+		inline void clear() noexcept;
+
+		//----------------------------------------------
+		// Group matching
+		//----------------------------------------------
+
+		/**
+		 * @brief Find the slots of a group whose control byte equals a value
+		 * @param ctrl Control bytes of the group
+		 * @param value Byte to match
+		 * @return Bit i set if slot i matches
+		 */
+		static inline std::uint32_t matchByte( const std::array<std::uint8_t, GROUP_WIDTH>& ctrl, std::uint8_t value ) noexcept;
+
+		/**
+		 * @brief Portable SWAR implementation of matchByte(), used when SSE2 is unavailable
+		 * @param ctrl Control bytes of the group
+		 * @param value Byte to match
+		 * @return Bit i set if slot i matches
+		 */
+		static constexpr std::uint32_t matchBytePortable( const std::array<std::uint8_t, GROUP_WIDTH>& ctrl, std::uint8_t value ) noexcept;
+
+		/**
+		 * @brief Find the free (empty or deleted) slots of a group
+		 * @param ctrl Control bytes of the group
+		 * @return Bit i set if slot i is free
+		 */
+		static inline std::uint32_t matchFree( const std::array<std::uint8_t, GROUP_WIDTH>& ctrl ) noexcept;
+
+	private:
+		//----------------------------------------------
+		// Internal data structures
+		//----------------------------------------------
+
+		/** @brief Log2 of the number of entries per storage chunk */
+		static constexpr std::size_t CHUNK_SHIFT = 8;
+
+		/** @brief Number of entries per storage chunk */
+		static constexpr std::size_t CHUNK_SIZE = std::size_t{ 1 } << CHUNK_SHIFT;
+
+		/** @brief Control byte of a never used slot */
+		static constexpr std::uint8_t CTRL_EMPTY = 0x80;
+
+		/** @brief Control byte of a slot whose entry was erased (tombstone) */
+		static constexpr std::uint8_t CTRL_DELETED = 0xFE;
+
+		/** @brief Control byte past the slots of a group, never matches a fragment and is masked out of free slots */
+		static constexpr std::uint8_t CTRL_PADDING = 0xFF;
+
+		/** @brief Group match bits of the slots, excluding the padding */
+		static constexpr std::uint32_t SLOT_MASK = ( std::uint32_t{ 1 } << GROUP_SLOTS ) - 1;
+
+		/** @brief Index ending the free list, one past the largest entry index */
+		static constexpr std::uint32_t NO_ENTRY = std::numeric_limits<std::uint32_t>::max();
+
+		/** @brief Stored key and value, never moved while alive */
+		struct Entry
+		{
+			/** @brief The key */
+			TKey key;
+
+			/** @brief The value */
+			TMapped mapped;
+
+			template <typename TKeyArg, typename... TArgs>
+			Entry( TKeyArg&& entryKey, TArgs&&... args );
+		};
+
+		/** @brief Raw storage of one entry, holding the next free index while unused */
+		struct alignas( std::max( alignof( Entry ), alignof( std::uint32_t ) ) ) EntrySlot
+		{
+			std::byte storage[std::max( sizeof( Entry ), sizeof( std::uint32_t ) )];
+		};
+
+		/** @brief Control bytes and entry indices of 12 consecutive slots, one cache line */
+		struct alignas( 64 ) Group
+		{
+			/** @brief Hash fragment (0-127) of occupied slots, or CTRL_EMPTY / CTRL_DELETED; CTRL_PADDING past the slots */
+			std::array<std::uint8_t, GROUP_WIDTH> ctrl;
+
+			/** @brief Entry index, meaningful for occupied slots */
+			std::array<std::uint32_t, GROUP_SLOTS> entries;
+		};
+
+		static_assert( sizeof( Group ) == 64, "A probe must read a single cache line" );
+
+		/** @brief Raw storage for CHUNK_SIZE entries */
+		struct Chunk
+		{
+			EntrySlot slots[CHUNK_SIZE];
+		};
+
+		using GroupAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<Group>;
+		using EntrySlotAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<EntrySlot>;
+		using ChunkAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<Chunk>;
+		using ChunkPointerAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<Chunk*>;
+
+		Group* m_groups{ nullptr };
+		std::size_t m_groupMask{ 0 };
+		std::size_t m_size{ 0 };
+		std::size_t m_tombstones{ 0 };
+
+		/** @brief Entries allocated by reserve() before the first insertion, indices below m_blockSize */
+		EntrySlot* m_block{ nullptr };
+		std::size_t m_blockSize{ 0 };
+
+		/** @brief Entries past the block, never moved or freed before destruction */
+		std::vector<Chunk*, ChunkPointerAllocator> m_chunks;
+
+		/** @brief Number of entry indices handed out, live or free */
+		std::size_t m_nextEntry{ 0 };
+
+		/** @brief Most recently erased entry, NO_ENTRY when none is free */
+		std::uint32_t m_freeEntry{ NO_ENTRY };
+
+		[[no_unique_address]] THash m_hasher;
+		[[no_unique_address]] TKeyEqual m_equal;
+		[[no_unique_address]] TAllocator m_allocator;
+
+	private:
+		//----------------------------------------------
+		// Helpers
+		//----------------------------------------------
+
+		/**
+		 * @brief Hash a key and spread its bits over the whole word
+		 * @param key Key or heterogeneous key
+		 * @return Mixed hash
+		 */
+		template <typename TLookup>
+		inline std::size_t hashOf( const TLookup& key ) const;
+
+		/**
+		 * @brief Hint the processor to load a cache line ahead of its use
+		 * @param address Any address within the line, never dereferenced
+		 */
+		static inline void prefetch( const void* address ) noexcept;
+
+		/**
+		 * @brief Probe for a key with a precomputed hash
+		 * @param key Key or heterogeneous key
+		 * @param hash Mixed hash of the key
+		 * @return Slot position, or the end position if absent
+		 */
+		template <typename TLookup>
+		inline std::size_t findPosition( const TLookup& key, std::size_t hash ) const;
+
+		/**
+		 * @brief Insert a new entry whose key is known to be absent
+		 * @param hash Mixed hash of the key
+		 * @param key Key forwarded to the entry
+		 * @param args Arguments forwarded to the TMapped constructor
+		 * @return Slot position of the new entry
+		 */
+		template <typename TKeyArg, typename... TArgs>
+		inline std::size_t insertNew( std::size_t hash, TKeyArg&& key, TArgs&&... args );
+
+		/**
+		 * @brief Find the first free slot along the probe sequence of a hash
+		 * @param groups Probe table to search
+		 * @param groupMask Number of groups of the table minus one
+		 * @param hash Mixed hash
+		 * @return Slot position
+		 */
+		static inline std::size_t findFreePosition( const Group* groups, std::size_t groupMask, std::size_t hash ) noexcept;
+
+		/**
+		 * @brief Rebuild the probe table with a new number of groups, dropping tombstones
+		 * @param groupCount New number of groups (power of two)
+		 * @details Rehashes the stored keys; entries stay where they are
+		 */
+		inline void rehash( std::size_t groupCount );
+
+		/**
+		 * @brief Get the end position of the probe table
+		 * @return Number of groups times GROUP_WIDTH (zero before the first insertion)
+		 */
+		inline std::size_t slotCount() const noexcept;
+
+		/**
+		 * @brief Get the maximum number of used (occupied or deleted) slots before rebuilding
+		 * @param groupCount Number of groups
+		 * @return 7/8 of the slots
+		 */
+		static constexpr std::size_t maxUsedSlots( std::size_t groupCount ) noexcept;
+
+		/**
+		 * @brief Get the maximum number of occupied slots before growing
+		 * @param groupCount Number of groups
+		 * @return 3/4 of the used slot limit, so that a rebuild reclaiming tombstones frees
+		 *         at least a quarter of it and rebuilds stay amortized at a constant size
+		 */
+		static constexpr std::size_t maxLiveSlots( std::size_t groupCount ) noexcept;
+
+		/**
+		 * @brief Advance a slot position to the next occupied slot
+		 * @param position Starting position (inclusive)
+		 * @return Position of an occupied slot, or the end position
+		 */
+		inline std::size_t nextOccupied( std::size_t position ) const noexcept;
+
+		/**
+		 * @brief Get the entry referenced by an occupied slot
+		 * @param position Slot position
+		 * @return Reference to the entry
+		 */
+		inline Entry& entryAtPosition( std::size_t position ) const noexcept;
+
+		/**
+		 * @brief Get the storage of an entry index
+		 * @param index Entry index below m_nextEntry
+		 * @return Storage in the block or in a chunk
+		 */
+		inline EntrySlot& slotAt( std::uint32_t index ) const noexcept;
+
+		/**
+		 * @brief Get the live entry of an entry index
+		 * @param index Index of a constructed entry
+		 * @return Reference to the entry
+		 */
+		inline Entry& entryAt( std::uint32_t index ) const noexcept;
+
+		/**
+		 * @brief Reserve storage for a new entry
+		 * @return Index of uninitialized storage, reusing erased entries first
+		 * @throws std::length_error if every 32-bit index is in use
+		 */
+		inline std::uint32_t allocateEntry();
+
+		/**
+		 * @brief Return the storage of a destroyed entry to the free list
+		 * @param index Entry index
+		 */
+		inline void freeEntry( std::uint32_t index ) noexcept;
+
+		/**
+		 * @brief Destroy every live entry
+		 */
+		inline void destroyEntries() noexcept;
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/FlatHashMap.inl"
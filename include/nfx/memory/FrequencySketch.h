@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file FrequencySketch.h
+ * @brief Count-min sketch of 4-bit access counters with periodic aging
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// FrequencySketch class
+	//=====================================================================
+
+	/**
+	 * @brief Approximate access frequency of keys, as used by TinyLFU admission
+	 * @details Counters are 4 bits wide, 16 to a 64-bit word, and saturate at 15. A key is
+	 *          counted in four counters chosen from its hash and its frequency is the smallest
+	 *          of them, so collisions can only overestimate. After a sample of 10 additions
+	 *          per counted entry every counter is halved, which keeps the sketch following the
+	 *          recent access pattern instead of all-time popularity.
+	 */
+	class FrequencySketch final
+	{
+	public:
+		//----------------------------------------------
+		// Constants
+		//----------------------------------------------
+
+		/** @brief Largest value of a counter */
+		static constexpr std::uint32_t MAX_FREQUENCY = 15;
+
+		/** @brief Additions per counted entry between two agings */
+		static constexpr std::size_t SAMPLE_FACTOR = 10;
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct a sketch sized for a number of entries
+		 * @param capacity Expected number of distinct hot entries, e.g. the cache size limit
+		 */
+		inline explicit FrequencySketch( std::size_t capacity = 0 );
+
+		//----------------------------------------------
+		// Capacity
+		//----------------------------------------------
+
+		/**
+		 * @brief Grow the sketch to count at least a number of entries
+		 * @param capacity Expected number of distinct hot entries
+		 * @details Growing discards the counts gathered so far; shrinking is never done
+		 */
+		inline void ensureCapacity( std::size_t capacity );
+
+		//----------------------------------------------
+		// Counting
+		//----------------------------------------------
+
+		/**
+		 * @brief Count one access
+		 * @param hash Hash of the accessed key, remixed internally
+		 */
+		inline void increment( std::uint64_t hash ) noexcept;
+
+		/**
+		 * @brief Estimate the access frequency of a key
+		 * @param hash Hash of the key
+		 * @return Estimated number of recent accesses, at most MAX_FREQUENCY
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::uint32_t frequency( std::uint64_t hash ) const noexcept;
+
+		/**
+		 * @brief Halve every counter
+		 * @details Called automatically once per sample period
+		 */
+		inline void age() noexcept;
+
+		/**
+		 * @brief Reset every counter to zero
+		 */
+		inline void clear() noexcept;
+
+	private:
+		/** @brief Counter words, a power of two in number */
+		std::vector<std::uint64_t> m_table;
+
+		/** @brief Number of words minus one */
+		std::size_t m_mask{ 0 };
+
+		/** @brief Additions between two agings */
+		std::size_t m_sampleSize{ 0 };
+
+		/** @brief Additions since the last aging */
+		std::size_t m_additions{ 0 };
+
+		/**
+		 * @brief Remix a key hash, so identity hashes of integers spread over the table
+		 * @param hash Hash of the key
+		 * @return Well mixed 64-bit value
+		 */
+		static constexpr std::uint64_t spread( std::uint64_t hash ) noexcept;
+
+		/**
+		 * @brief Locate the counter of a row
+		 * @param spreadHash Remixed hash of the key
+		 * @param row Row index, 0 to 3
+		 * @return Word index and bit offset of the counter
+		 */
+		[[nodiscard]] inline std::pair<std::size_t, unsigned> counter( std::uint64_t spreadHash, unsigned row ) const noexcept;
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/FrequencySketch.inl"
@@ -29,14 +29,48 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <optional>
+#include <ranges>
+#include <shared_mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "nfx/memory/CacheTask.h"
+#include "nfx/memory/CoarseClock.h"
+#include "nfx/memory/FlatHashMap.h"
+#include "nfx/memory/EvictionPolicy.h"
+#include "nfx/memory/LruCacheStatistics.h"
+#include "nfx/memory/MaintenanceThread.h"
+#include "nfx/memory/TimerWheel.h"
 
 namespace nfx::memory
 {
+	//=====================================================================
+	// CacheExecutor
+	//=====================================================================
+
+	/** @brief Function type running a task, e.g. by posting it to an event loop or a thread pool */
+	using CacheExecutor = std::function<void( std::function<void()> )>;
+
 	//=====================================================================
 	// LruCacheOptions struct
 	//=====================================================================
@@ -79,6 +113,13 @@ namespace nfx::memory
 		 */
 		[[nodiscard]] inline std::chrono::milliseconds slidingExpiration() const;
 
+		/**
+		 * @brief Get the default absolute expiration time
+		 * @return Time after the value was written before entries expire (0 = none)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::milliseconds absoluteExpiration() const;
+
 		/**
 		 * @brief Get the background cleanup interval
 		 * @return Cleanup interval (0 = disabled)
@@ -86,6 +127,125 @@ namespace nfx::memory
 		 */
 		[[nodiscard]] inline std::chrono::milliseconds backgroundCleanupInterval() const;
 
+		/**
+		 * @brief Check whether cache hits are recorded into read buffers
+		 * @return True if hits take a shared lock and defer LRU reordering
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool readBuffering() const;
+
+		/**
+		 * @brief Get the maximum total weight of cache entries
+		 * @return Weight limit (0 = unlimited)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t maxWeight() const;
+
+		/**
+		 * @brief Check whether the cache records statistics
+		 * @return True if hits, misses, loads, evictions and expirations are counted
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool statisticsEnabled() const;
+
+		/**
+		 * @brief Get the resolution of the clock used for expiration
+		 * @return Coarse clock refresh period (0 = read the steady clock on every operation)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::milliseconds clockResolution() const;
+
+		/**
+		 * @brief Get the interval of the maintenance thread
+		 * @return Maintenance interval (0 = no maintenance thread)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::milliseconds maintenanceInterval() const;
+
+		/**
+		 * @brief Get the maintenance thread shared with other caches
+		 * @return Shared thread, null when the cache starts its own
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline const std::shared_ptr<MaintenanceThread>& maintenanceThread() const;
+
+		/**
+		 * @brief Get the age after which a value is reloaded on access
+		 * @return Refresh threshold since the value was written (0 = never refreshed)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::milliseconds refreshAfterWrite() const;
+
+		/**
+		 * @brief Get the executor running refreshes
+		 * @return Executor set with the refresh threshold
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline const CacheExecutor& refreshExecutor() const;
+
+		//----------------------------------------------
+		// Modifiers
+		//----------------------------------------------
+
+		/**
+		 * @brief Set the maximum number of cache entries
+		 * @param sizeLimit Maximum number of entries (0 = unlimited)
+		 * @return Reference to these options for chaining
+		 */
+		inline LruCacheOptions& withSizeLimit( std::size_t sizeLimit ) noexcept;
+
+		/**
+		 * @brief Set the default absolute expiration time
+		 * @param absoluteExpiration Time after the value was written before entries expire, however often they are read (0 = none)
+		 * @return Reference to these options for chaining
+		 */
+		inline LruCacheOptions& withAbsoluteExpiration( std::chrono::milliseconds absoluteExpiration ) noexcept;
+
+		/**
+		 * @brief Set the maximum total weight of cache entries
+		 * @param maxWeight Weight limit, compared against the sum of CacheEntry::size (0 = unlimited)
+		 * @return Reference to these options for chaining
+		 */
+		inline LruCacheOptions& withMaxWeight( std::size_t maxWeight ) noexcept;
+
+		/**
+		 * @brief Enable or disable buffered LRU reordering on cache hits
+		 * @param enabled True to serve hits under a shared lock and replay LRU moves in batches
+		 * @return Reference to these options for chaining
+		 */
+		inline LruCacheOptions& withReadBuffering( bool enabled ) noexcept;
+
+		/**
+		 * @brief Enable or disable statistics recording
+		 * @param enabled True to count cache events in striped atomic counters
+		 * @return Reference to these options for chaining
+		 */
+		inline LruCacheOptions& withStatistics( bool enabled ) noexcept;
+
+		/**
+		 * @brief Set the resolution of the clock used for expiration
+		 * @param resolution Coarse clock refresh period (0 = read the steady clock on every operation)
+		 * @return Reference to these options for chaining
+		 */
+		inline LruCacheOptions& withClockResolution( std::chrono::milliseconds resolution ) noexcept;
+
+		/**
+		 * @brief Run cache maintenance on a background thread
+		 * @param interval Time between maintenance runs (0 = no maintenance thread)
+		 * @param thread Thread shared with other caches, or null for a thread owned by the cache
+		 * @return Reference to these options for chaining
+		 */
+		inline LruCacheOptions& withMaintenance( std::chrono::milliseconds interval, std::shared_ptr<MaintenanceThread> thread = nullptr ) noexcept;
+
+		/**
+		 * @brief Reload values in the background once they reach an age, serving the current value meanwhile
+		 * @param refreshAfter Age since the value was written after which an access reloads it (0 = never)
+		 * @param executor Function running the reloads, required when refreshAfter is positive
+		 * @return Reference to these options for chaining
+		 * @details The cache also needs std::shared_ptr values and a reload function, given to its constructor
+		 */
+		inline LruCacheOptions& withRefreshAfterWrite( std::chrono::milliseconds refreshAfter, CacheExecutor executor ) noexcept;
+
 	private:
 		/** Maximum number of entries allowed in cache (0 = unlimited) */
 		std::size_t m_sizeLimit{ 0 };
@@ -93,16 +253,99 @@ namespace nfx::memory
 		/** Default time after last access before entries expire */
 		std::chrono::milliseconds m_slidingExpiration{ std::chrono::minutes{ 60 } };
 
+		/*
+		 * Absolute expiration design:
+		 * - When set (> 0), entries also expire this long after their value was written, on
+		 *   insertion or by a refresh, whether or not they are being read
+		 * - An entry expires at the earlier of its sliding and absolute deadlines; both are
+		 *   enforced by the same expiry index and checks as sliding expiration alone
+		 * - Entries can override it through CacheEntry::absoluteExpiration in the configure callback
+		 */
+		std::chrono::milliseconds m_absoluteExpiration{ 0 };
+
 		/*
 		 * Background cleanup design:
 		 * - When enabled (interval > 0), cache tracks last cleanup time
 		 * - During getOrCreate/tryGet operations, checks if cleanup interval has elapsed
 		 * - If elapsed, performs incremental cleanup of expired entries
+		 * - Each cycle visits a bounded number of entries; an unfinished sweep resumes on the
+		 *   next operation from where it stopped, before the interval elapses again
 		 * - Amortizes cleanup cost across normal operations without requiring separate thread
 		 * - Ideal for write-heavy scenarios with unique keys (logging, batch processing)
 		 * - For very low-activity caches, still requires occasional manual cleanupExpired() calls
 		 */
 		std::chrono::milliseconds m_backgroundCleanupInterval{ std::chrono::milliseconds{ 0 } };
+
+		/*
+		 * Read buffering design:
+		 * - Hits take the cache mutex in shared mode and stamp the access time atomically
+		 * - The LRU promotion is appended to a striped, fixed-size read buffer instead of
+		 *   splicing the intrusive list, so concurrent readers of hot keys do not contend
+		 * - Buffers are replayed in order by whichever thread next takes the exclusive lock
+		 * - A full buffer sends the hit down the exclusive path, which drains all buffers
+		 * - CLOCK and S3-FIFO serve hits under the shared lock regardless, updating the entry's
+		 *   reference bits instead of buffering, so this option has no effect on them
+		 */
+		bool m_readBuffering{ false };
+
+		/*
+		 * Weighted capacity design:
+		 * - Each entry weighs CacheEntry::size, set by the cache weigher or the configure callback
+		 * - Insertion evicts from the LRU tail until the new entry fits in the remaining weight
+		 * - An entry heavier than the limit evicts everything else and is admitted alone
+		 * - Applies in addition to the entry count limit
+		 * - Shards of a ShardedLruCache also add their weight to a total shared by all shards
+		 */
+		std::size_t m_maxWeight{ 0 };
+
+		/** Whether cache events are counted (see LruCacheStatistics) */
+		bool m_statisticsEnabled{ false };
+
+		/*
+		 * Coarse clock design:
+		 * - Every operation reads the time once and uses it for all expiration checks and stamps
+		 * - With a resolution, that read is an atomic load from a CoarseClock shared by all caches
+		 *   of the same resolution, refreshed by a background thread
+		 * - Expiration is then accurate to about one resolution period
+		 */
+		std::chrono::milliseconds m_clockResolution{ 0 };
+
+		/*
+		 * Maintenance thread design:
+		 * - When enabled (interval > 0), a MaintenanceThread runs the cache maintenance every
+		 *   interval, whether or not the cache is being used, so idle caches shrink too
+		 * - Each run drains the read buffers and removes expired entries in batches, releasing
+		 *   the lock between batches; operations then skip the opportunistic background cleanup
+		 * - Entries erased by operations are detached under the lock and destroyed by the next
+		 *   run, off the caller's thread (unless a removal listener takes the values). Only the
+		 *   values are detached with allocators other than std::allocator, their nodes are freed
+		 *   under the lock. At most MAX_DEFERRED_ENTRIES wait, further ones are destroyed inline
+		 * - One thread can serve many caches; ~LruCache unregisters and waits for a run in progress
+		 */
+		std::chrono::milliseconds m_maintenanceInterval{ 0 };
+
+		/** Thread shared with other caches (null = the cache starts its own) */
+		std::shared_ptr<MaintenanceThread> m_maintenanceThread;
+
+		/*
+		 * Refresh after write design:
+		 * - When enabled (threshold > 0), values are std::shared_ptr handles read by copy with
+		 *   LruCache::get(), which loads misses with the reload function given to the cache
+		 * - A get() hit on a value written at least the threshold ago returns that value and
+		 *   submits one reload of the key to the executor
+		 * - The reload is registered like a factory call in progress, so a key is refreshed by
+		 *   one reload at a time and misses on it meanwhile wait for that reload
+		 * - A successful reload swaps the handle under the lock, keeping the entry's position and
+		 *   expiration; readers keep the value they copied, and the old handle is reported to
+		 *   the removal listener as Replaced
+		 * - Lookups returning references would see their handle swapped, so they throw instead
+		 * - A failed reload keeps the current value, the next stale hit tries again
+		 * - Sliding expiration still applies: an entry nobody reads expires instead of refreshing
+		 */
+		std::chrono::milliseconds m_refreshAfterWrite{ 0 };
+
+		/** Executor running refreshes */
+		CacheExecutor m_refreshExecutor;
 	};
 
 	//=====================================================================
@@ -115,10 +358,16 @@ namespace nfx::memory
 		/** @brief Timestamp of the last access to this cache entry */
 		std::chrono::steady_clock::time_point lastAccessed;
 
+		/** @brief Timestamp of the creation or last refresh of the value */
+		std::chrono::steady_clock::time_point writtenAt;
+
 		/** @brief Sliding expiration time for this specific entry */
 		std::chrono::milliseconds slidingExpiration;
 
-		/** @brief Size of this cache entry for memory accounting */
+		/** @brief Time after writtenAt at which this entry expires regardless of access (0 = none) */
+		std::chrono::milliseconds absoluteExpiration{ 0 };
+
+		/** @brief Weight of this cache entry, counted against LruCacheOptions::maxWeight() */
 		std::size_t size{ 1 };
 
 		/** @brief Previous entry in the LRU doubly-linked list */
@@ -130,6 +379,18 @@ namespace nfx::memory
 		/** @brief Pointer to the key for this cache entry */
 		const void* keyPtr{ nullptr };
 
+		/** @brief Next entry in the same timer wheel bucket */
+		CacheEntry* timerNext{ nullptr };
+
+		/** @brief Link pointing at this entry in its timer wheel bucket (null when not scheduled) */
+		CacheEntry** timerPrevNext{ nullptr };
+
+		/** @brief Eviction policy list holding this entry */
+		std::uint8_t segment{ 0 };
+
+		/** @brief Reference bit of CLOCK policies, access counter of S3-FIFO; set by hits under the shared lock */
+		std::uint8_t referenced{ 0 };
+
 		//----------------------------------------------
 		// Construction
 		//----------------------------------------------
@@ -140,17 +401,51 @@ namespace nfx::memory
 		 */
 		inline CacheEntry( std::chrono::milliseconds expiration = std::chrono::hours( 1 ) );
 
+		/**
+		 * @brief Construct cache entry with specified expiration time and access time
+		 * @param expiration Sliding expiration time for this entry
+		 * @param now Time of creation
+		 */
+		inline CacheEntry( std::chrono::milliseconds expiration, std::chrono::steady_clock::time_point now );
+
 		//----------------------------------------------
 		// Expiration checking
 		//----------------------------------------------
 
 		/**
-		 * @brief Check if this cache entry has expired based on sliding expiration
+		 * @brief Check if this cache entry has expired based on sliding and absolute expiration
 		 * @return True if the entry has expired and should be evicted, false otherwise
 		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
 		 */
 		[[nodiscard]] inline bool isExpired() const noexcept;
 
+		/**
+		 * @brief Check if this cache entry has expired at a given time
+		 * @param now Current time, read once per cache operation
+		 * @return True if the entry has expired and should be evicted, false otherwise
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool isExpired( std::chrono::steady_clock::time_point now ) const noexcept;
+
+		/**
+		 * @brief Get the time after which this entry is expired
+		 * @return Earlier of last access plus sliding expiration and write time plus absolute expiration,
+		 *         saturated to time_point::max()
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::steady_clock::time_point expiresAt() const noexcept;
+
+		/**
+		 * @brief Check if more than an expiration time has passed since a timestamp
+		 * @param start Timestamp the expiration counts from
+		 * @param now Current time
+		 * @param expiration Expiration time, never reached when longer than a steady_clock duration
+		 * @return True if now is later than start plus expiration
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] static inline bool hasElapsed( std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point now,
+			std::chrono::milliseconds expiration ) noexcept;
+
 		//----------------------------------------------
 		// Access management
 		//----------------------------------------------
@@ -160,8 +455,110 @@ namespace nfx::memory
 		 * @details Resets the sliding expiration timer for this cache entry
 		 */
 		void inline updateAccess() noexcept;
+
+		/**
+		 * @brief Set the last accessed timestamp
+		 * @param now Current time, read once per cache operation
+		 */
+		void inline updateAccess( std::chrono::steady_clock::time_point now ) noexcept;
+	};
+
+	//=====================================================================
+	// RemovalCause enum
+	//=====================================================================
+
+	/** @brief Reason an entry left the cache, reported to the removal listener */
+	enum class RemovalCause : std::uint8_t
+	{
+		/** @brief Evicted to respect the size or weight limit */
+		Size,
+
+		/** @brief Removed because its sliding or absolute expiration elapsed */
+		Expired,
+
+		/** @brief Removed by an explicit remove() call */
+		Explicit,
+
+		/** @brief Its value was replaced by a newer one */
+		Replaced,
+
+		/** @brief Removed by clear() */
+		Cleared
+	};
+
+	//=====================================================================
+	// Storage engines
+	//=====================================================================
+
+	/** @brief Storage engine keeping entries in std::unordered_map nodes (default) */
+	struct NodeStorage final
+	{
+		/** @brief Map type storing cache items by key */
+		template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+		using Map = std::unordered_map<TKey, TMapped, THash, TKeyEqual, TAllocator>;
+	};
+
+	/**
+	 * @brief Storage engine keeping entries in a FlatHashMap
+	 * @details Lookups probe 16 control bytes at a time and then read the entry, instead of
+	 *          walking a bucket array and a node chain. Entries are stored inline in one array
+	 *          sized for sizeLimit at construction, so a size-bounded cache never rehashes or
+	 *          allocates per insertion; unbounded caches add entries in fixed-size chunks.
+	 *          Prefer it for large caches of small entries.
+	 */
+	struct FlatStorage final
+	{
+		/** @brief Map type storing cache items by key */
+		template <typename TKey, typename TMapped, typename THash, typename TKeyEqual, typename TAllocator>
+		using Map = FlatHashMap<TKey, TMapped, THash, TKeyEqual, TAllocator>;
 	};
 
+	//=====================================================================
+	// Callable concepts
+	//=====================================================================
+
+	/**
+	 * @brief Callable creating a cache value on a miss
+	 * @tparam TFactory Callable type, invoked without arguments
+	 * @tparam TValue Cached value type the result converts to
+	 */
+	template <typename TFactory, typename TValue>
+	concept CacheFactory = std::invocable<TFactory&> && std::convertible_to<std::invoke_result_t<TFactory&>, TValue>;
+
+	/**
+	 * @brief Optional callable configuring the metadata of a new cache entry
+	 * @tparam TConfigure Callable type invoked with CacheEntry&, or std::nullptr_t for none
+	 */
+	template <typename TConfigure>
+	concept CacheEntryConfigurator = std::is_null_pointer_v<std::remove_cvref_t<TConfigure>> || std::invocable<TConfigure&, CacheEntry&>;
+
+	/**
+	 * @brief Key-like type usable for heterogeneous lookup without constructing a key
+	 * @details Requires both THash and TKeyEqual to declare is_transparent, like the
+	 *          heterogeneous lookup of std::unordered_map
+	 * @tparam TLookup Lookup argument type, e.g. std::string_view for std::string keys
+	 * @tparam TKey Key type of the cache
+	 * @tparam THash Hash function type of the cache
+	 * @tparam TKeyEqual Key equality type of the cache
+	 */
+	template <typename TLookup, typename TKey, typename THash, typename TKeyEqual>
+	concept TransparentLookup = !std::same_as<std::remove_cvref_t<TLookup>, TKey> &&
+								requires {
+									typename THash::is_transparent;
+									typename TKeyEqual::is_transparent;
+								} &&
+								std::invocable<const THash&, const TLookup&> &&
+								std::predicate<const TKeyEqual&, const TKey&, const TLookup&>;
+
+	/**
+	 * @brief Value type a refreshing cache can replace while readers hold earlier values
+	 * @details A std::shared_ptr: get() hands out copies of the handle, so a refresh swaps the
+	 *          cached handle without touching the values already handed out
+	 * @tparam TValue Cached value type
+	 */
+	template <typename TValue>
+	concept RefreshableValue = requires { typename TValue::element_type; } && std::same_as<TValue, std::shared_ptr<typename TValue::element_type>>;
+
 	//=====================================================================
 	// LruCache class
 	//=====================================================================
@@ -170,8 +567,17 @@ namespace nfx::memory
 	 * @brief Thread-safe memory cache with size limits and expiration policies
 	 * @tparam TKey Key type for cache entries
 	 * @tparam TValue Value type for cached objects
+	 * @tparam THash Hash function type for keys, transparent to enable heterogeneous lookup
+	 * @tparam TKeyEqual Key equality type, transparent to enable heterogeneous lookup
+	 * @tparam TStorage Storage engine, NodeStorage or FlatStorage
+	 * @tparam TAllocator Allocator for the storage engine, rebound to its internal node type;
+	 *                    e.g. SlabAllocator to recycle evicted nodes or std::pmr::polymorphic_allocator
+	 * @tparam TPolicy Eviction policy over the cached entries: LruPolicy, SlruPolicy, TwoQueuePolicy,
+	 *                 ArcPolicy or WTinyLfuPolicy; its capacity is the weight limit when one is set,
+	 *                 otherwise the size limit
 	 */
-	template <typename TKey, typename TValue>
+	template <typename TKey, typename TValue, typename THash = std::hash<TKey>, typename TKeyEqual = std::equal_to<TKey>, typename TStorage = NodeStorage,
+		typename TAllocator = std::allocator<std::pair<const TKey, TValue>>, template <typename> typename TPolicy = LruPolicy>
 	class LruCache final
 	{
 	public:
@@ -179,12 +585,24 @@ namespace nfx::memory
 		// Type aliases
 		//----------------------------------------------
 
-		/** @brief Function type for creating cache values when not found */
+		/** @brief Type-erased factory, accepted by getOrCreate() like any other CacheFactory */
 		using FactoryFunction = std::function<TValue()>;
 
-		/** @brief Function type for configuring cache entry metadata */
+		/** @brief Type-erased entry configurator, accepted by getOrCreate() like any other CacheEntryConfigurator */
 		using ConfigFunction = std::function<void( CacheEntry& )>;
 
+		/** @brief Function type computing the weight of a newly created entry */
+		using WeigherFunction = std::function<std::size_t( const TKey&, const TValue& )>;
+
+		/** @brief Function type loading the value of a key for get(), with refresh after write */
+		using ReloadFunction = std::function<TValue( const TKey& )>;
+
+		/** @brief Function type notified of every entry leaving the cache, receives ownership of the value */
+		using RemovalListener = std::function<void( const TKey&, TValue&&, RemovalCause )>;
+
+		/** @brief Allocator type, as given; the storage engine uses a rebound copy */
+		using allocator_type = TAllocator;
+
 		//----------------------------------------------
 		// Construction
 		//----------------------------------------------
@@ -192,8 +610,40 @@ namespace nfx::memory
 		/**
 		 * @brief Construct memory cache with specified options
 		 * @param options Configuration options for cache behavior
+		 * @param allocator Allocator for cache entries, e.g. a std::pmr::memory_resource pointer for pmr caches
+		 * @throws std::invalid_argument if refresh after write is enabled, it needs a reload function
+		 */
+		inline explicit LruCache( const LruCacheOptions& options = {}, const TAllocator& allocator = TAllocator{} );
+
+		/**
+		 * @brief Construct memory cache with specified options and entry weigher
+		 * @param options Configuration options for cache behavior
+		 * @param weigher Function computing CacheEntry::size after the configure callback has run
+		 * @param allocator Allocator for cache entries
+		 * @throws std::invalid_argument if refresh after write is enabled, it needs a reload function
+		 */
+		inline LruCache( const LruCacheOptions& options, WeigherFunction weigher, const TAllocator& allocator = TAllocator{} );
+
+		/**
+		 * @brief Construct refreshing memory cache with specified options and reload function
+		 * @param options Configuration options for cache behavior, with refresh after write enabled
+		 * @param reload Function loading the value of a key for get() misses and refreshes
+		 * @param allocator Allocator for cache entries
+		 * @throws std::invalid_argument if refresh after write is not enabled, has no executor, or reload is empty
 		 */
-		inline explicit LruCache( const LruCacheOptions& options = {} );
+		inline LruCache( const LruCacheOptions& options, ReloadFunction reload, const TAllocator& allocator = TAllocator{} )
+			requires RefreshableValue<TValue>;
+
+		/**
+		 * @brief Construct memory cache with specified options, entry weigher and reload function
+		 * @param options Configuration options for cache behavior
+		 * @param weigher Function computing CacheEntry::size after the configure callback has run (may be empty)
+		 * @param reload Function loading the value of a key for get(), required exactly when refresh after write is enabled
+		 * @param allocator Allocator for cache entries
+		 * @throws std::invalid_argument if refresh after write is enabled for values other than std::shared_ptr,
+		 *         without an executor or without a reload function, or if a reload function is given without it
+		 */
+		inline LruCache( const LruCacheOptions& options, WeigherFunction weigher, ReloadFunction reload, const TAllocator& allocator = TAllocator{} );
 
 		//----------------------------------------------
 		// Copy and move operations
@@ -213,8 +663,8 @@ namespace nfx::memory
 		// Destruction
 		//----------------------------------------------
 
-		// Default destructor
-		~LruCache() = default;
+		/** @brief Stop maintenance and refreshes for this cache, waiting for those in progress */
+		inline ~LruCache();
 
 		//----------------------------------------------
 		// Cache operations
@@ -222,12 +672,84 @@ namespace nfx::memory
 
 		/**
 		 * @brief Get or create a cache entry using factory function
+		 * @tparam TFactory Factory callable type, taken by reference and never copied
+		 * @tparam TConfigure Configurator callable type, std::nullptr_t when omitted
 		 * @param key The cache key
 		 * @param factory Function to create the value if not cached
 		 * @param configure Optional function to configure cache entry
 		 * @return Reference to the cached value
+		 * @details The factory runs without holding the cache lock. Concurrent misses on the same
+		 *          key wait for the single in-flight factory call instead of starting their own;
+		 *          if it throws, every waiter rethrows the same exception and nothing is cached,
+		 *          so the next call retries. The factory must not request its own key.
+		 * @throws std::logic_error if refresh after write is enabled, use get() instead
+		 */
+		template <CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure = std::nullptr_t>
+		inline TValue& getOrCreate( const TKey& key, TFactory&& factory, TConfigure&& configure = nullptr );
+
+		/**
+		 * @brief Get or create a cache entry by a key-like value, constructing a key only on insertion
+		 * @tparam TLookup Heterogeneous key type accepted by the transparent hash and equality
+		 * @tparam TFactory Factory callable type, taken by reference and never copied
+		 * @tparam TConfigure Configurator callable type, std::nullptr_t when omitted
+		 * @param key Value equivalent to the cache key
+		 * @param factory Function to create the value if not cached
+		 * @param configure Optional function to configure cache entry
+		 * @return Reference to the cached value
+		 */
+		template <typename TLookup, CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure = std::nullptr_t>
+			requires TransparentLookup<TLookup, TKey, THash, TKeyEqual> && std::constructible_from<TKey, const TLookup&>
+		inline TValue& getOrCreate( const TLookup& key, TFactory&& factory, TConfigure&& configure = nullptr );
+
+		/**
+		 * @brief Get a copy of the value of a key in a refreshing cache, loading it on a miss
+		 * @param key The cache key
+		 * @return The cached value handle
+		 * @details Misses run the reload function given to the constructor on the
+		 *          calling thread, sharing concurrent misses on the key like getOrCreate(). A hit
+		 *          on a value written at least the refresh threshold ago returns that value and
+		 *          submits one reload to the refresh executor, which swaps the cached handle when
+		 *          it completes. The handle is copied under the lock, so it stays valid across
+		 *          refreshes, evictions and removals.
+		 * @throws std::logic_error if refresh after write is not enabled
+		 * @throws Whatever the reload function throws on a miss, or the executor when submitting a refresh
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
 		 */
-		inline TValue& getOrCreate( const TKey& key, FactoryFunction factory, ConfigFunction configure = nullptr );
+		[[nodiscard]] inline TValue get( const TKey& key )
+			requires RefreshableValue<TValue>;
+
+		//----------------------------------------------
+		// Coroutine operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Awaitable returned by getOrLoad()
+		 * @tparam TLoader Loader callable type
+		 * @tparam TConfigure Configurator callable type, std::nullptr_t when omitted
+		 */
+		template <typename TLoader, typename TConfigure>
+		class LoadAwaiter;
+
+		/**
+		 * @brief Get or load a cache entry from a coroutine, as co_await cache.getOrLoad( key, loader )
+		 * @tparam TLoader Loader callable type, returning an awaitable of the value such as CacheTask<TValue>
+		 * @tparam TConfigure Configurator callable type, std::nullptr_t when omitted
+		 * @param key The cache key, which must outlive the returned awaitable
+		 * @param loader Function starting the load of the value, invoked at most once and only on a miss
+		 * @param configure Optional function to configure cache entry
+		 * @return Awaitable resuming the caller with a reference to the cached value
+		 * @details A hit completes without suspending the caller. On a miss the caller is suspended
+		 *          while the loader's awaitable runs, and concurrent misses on the same key, from
+		 *          coroutines or getOrCreate(), share that single load. Suspended coroutines hold
+		 *          no thread: they are resumed by the thread that completes the load, one after
+		 *          another. If the loader fails, every waiter rethrows its exception and nothing
+		 *          is cached. The cache must outlive the load.
+		 * @throws std::logic_error if refresh after write is enabled
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		template <typename TLoader, CacheEntryConfigurator TConfigure = std::nullptr_t>
+			requires std::invocable<std::decay_t<TLoader>&> && std::move_constructible<std::decay_t<TLoader>>
+		[[nodiscard]] inline LoadAwaiter<std::decay_t<TLoader>, std::decay_t<TConfigure>> getOrLoad( const TKey& key, TLoader&& loader, TConfigure&& configure = nullptr );
 
 		//----------------------------------------------
 		// Lookup operations
@@ -237,9 +759,50 @@ namespace nfx::memory
 		 * @brief Try to get a cached value without creating it
 		 * @param key The cache key
 		 * @return Optional containing the value if found and not expired
+		 * @throws std::logic_error if refresh after write is enabled, use get() instead
 		 */
 		inline std::optional<std::reference_wrapper<TValue>> tryGet( const TKey& key );
 
+		/**
+		 * @brief Try to get a cached value by a key-like value without constructing a key
+		 * @tparam TLookup Heterogeneous key type accepted by the transparent hash and equality
+		 * @param key Value equivalent to the cache key
+		 * @return Optional containing the value if found and not expired
+		 * @throws std::logic_error if refresh after write is enabled, use get() instead
+		 */
+		template <typename TLookup>
+			requires TransparentLookup<TLookup, TKey, THash, TKeyEqual>
+		inline std::optional<std::reference_wrapper<TValue>> tryGet( const TLookup& key );
+
+		//----------------------------------------------
+		// Batch operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Try to get many cached values under a single lock acquisition
+		 * @param keys The cache keys
+		 * @param values Receives at each key's position its value, or nullopt on a miss;
+		 *               must hold at least keys.size() elements
+		 * @return Hit mask, true at the position of every key found and not expired
+		 * @details Hits are served under the shared lock when the policy or read buffering allows
+		 *          it, and the keys left over are resolved under one exclusive lock. The clock is
+		 *          read and background cleanup checked once per lock hold, not once per key.
+		 * @throws std::invalid_argument if values is shorter than keys
+		 * @throws std::logic_error if refresh after write is enabled
+		 */
+		inline std::vector<bool> tryGetMany( std::span<const TKey> keys, std::span<std::optional<std::reference_wrapper<TValue>>> values );
+
+		/**
+		 * @brief Insert many entries under a single lock acquisition
+		 * @tparam TConfigure Configurator callable type, std::nullptr_t when omitted
+		 * @param entries Keys and values to cache; the pairs that are inserted are moved from
+		 * @param configure Optional function to configure each new cache entry
+		 * @return Insertion mask, false at the position of every key already cached, whose entry is left as is
+		 * @details Evicts as each entry is inserted, so a batch larger than the size limit keeps its last entries.
+		 */
+		template <CacheEntryConfigurator TConfigure = std::nullptr_t>
+		inline std::vector<bool> insertMany( std::span<std::pair<TKey, TValue>> entries, TConfigure&& configure = nullptr );
+
 		//----------------------------------------------
 		// Modification operations
 		//----------------------------------------------
@@ -251,6 +814,27 @@ namespace nfx::memory
 		 */
 		inline bool remove( const TKey& key );
 
+		/**
+		 * @brief Remove an entry by a key-like value without constructing a key
+		 * @tparam TLookup Heterogeneous key type accepted by the transparent hash and equality
+		 * @param key Value equivalent to the cache key
+		 * @return True if entry was removed, false if not found
+		 */
+		template <typename TLookup>
+			requires TransparentLookup<TLookup, TKey, THash, TKeyEqual>
+		inline bool remove( const TLookup& key );
+
+		/**
+		 * @brief Remove an entry only if its value satisfies a predicate
+		 * @tparam TPredicate Predicate callable type invoked with const TValue&
+		 * @param key The cache key to remove
+		 * @param predicate Condition checked under the cache lock, must not call back into the cache
+		 * @return True if entry was removed, false if not found or the predicate rejected it
+		 */
+		template <typename TPredicate>
+			requires std::predicate<TPredicate&, const TValue&>
+		inline bool removeIf( const TKey& key, TPredicate&& predicate );
+
 		/**
 		 * @brief Clear all cache entries
 		 */
@@ -266,6 +850,12 @@ namespace nfx::memory
 		// State inspection
 		//----------------------------------------------
 
+		/**
+		 * @brief Get the total weight of all cached entries
+		 * @return Sum of CacheEntry::size over all entries
+		 */
+		inline std::size_t totalWeight() const;
+
 		/**
 		 * @brief Check if cache is empty
 		 * @return True if cache contains no entries
@@ -277,23 +867,98 @@ namespace nfx::memory
 		 */
 		inline void cleanupExpired();
 
+		/**
+		 * @brief Get a snapshot of the cache statistics
+		 * @return Current statistics, all zero when statistics are disabled
+		 * @note Does not take the cache lock
+		 */
+		inline LruCacheStatisticsSnapshot stats() const noexcept;
+
+		//----------------------------------------------
+		// Removal notification
+		//----------------------------------------------
+
+		/**
+		 * @brief Set the function notified when entries leave the cache
+		 * @param listener Listener receiving key, moved-out value and cause (nullptr to disable)
+		 * @details Removals are collected while the cache lock is held and delivered in a batch
+		 *          by the thread that caused them, after the lock has been released, so the
+		 *          listener may safely call back into the cache. Exceptions thrown by the
+		 *          listener are discarded. Entries still cached at destruction are not reported.
+		 */
+		inline void setRemovalListener( RemovalListener listener );
+
 	private:
+		/** @brief Hands each shard its part of a batch without copying keys */
+		template <typename, typename, typename, typename, typename, typename, template <typename> typename>
+		friend class ShardedLruCache;
+
+		/** @brief Reads its futures by copy under the cache lock */
+		template <typename, typename, typename, typename, typename, typename, template <typename> typename>
+		friend class AsyncLruCache;
+
 		//----------------------------------------------
 		// Background cleanup
 		//----------------------------------------------
 
 		/**
-		 * @brief Maximum number of expired entries to clean up per opportunistic cleanup cycle
+		 * @brief Maximum number of entries visited per opportunistic cleanup cycle
 		 * @details Limits cleanup work per operation to prevent blocking normal cache access.
-		 *          This ensures cleanup cost remains bounded and amortized across operations.
+		 *          Live entries count as well as expired ones, so the cost stays bounded even
+		 *          when nothing expires; an unfinished sweep continues on the next operation.
 		 */
 		static constexpr size_t MAX_CLEANUP_PER_CYCLE = 10;
 
 		/**
 		 * @brief Check if background cleanup should run and perform it if needed
 		 * @details Called during normal operations to amortize cleanup cost
+		 * @param now Current time
+		 */
+		inline void checkAndPerformBackgroundCleanup( std::chrono::steady_clock::time_point now ) const;
+
+		/**
+		 * @brief Check if the background cleanup interval has elapsed or a sweep is unfinished
+		 * @param now Current time
+		 * @return True if the next exclusive operation should perform cleanup
+		 */
+		[[nodiscard]] inline bool isBackgroundCleanupDue( std::chrono::steady_clock::time_point now ) const noexcept;
+
+		//----------------------------------------------
+		// Maintenance thread
+		//----------------------------------------------
+
+		/** @brief Maximum number of entries visited per lock hold by a maintenance run */
+		static constexpr std::size_t MAINTENANCE_BATCH = 256;
+
+		/** @brief Maximum number of erased entries awaiting destruction by the maintenance thread */
+		static constexpr std::size_t MAX_DEFERRED_ENTRIES = 256;
+
+		/**
+		 * @brief Drain the read buffers, remove expired entries and destroy deferred entries
+		 * @details Runs on the maintenance thread. Takes the lock once per batch of entries, and
+		 *          destroys the detached entries or values after releasing it.
 		 */
-		inline void checkAndPerformBackgroundCleanup() const;
+		inline void performMaintenance();
+
+		//----------------------------------------------
+		// Read buffering
+		//----------------------------------------------
+
+		/** @brief Number of independent read buffers, selected per thread */
+		static constexpr std::size_t READ_BUFFER_STRIPES = 16;
+
+		/** @brief Number of pending LRU promotions a single read buffer can hold */
+		static constexpr std::size_t READ_BUFFER_CAPACITY = 32;
+
+		/** @brief Fixed-size buffer of entries hit under the shared lock, awaiting LRU promotion */
+		struct alignas( 64 ) ReadBuffer
+		{
+			/** @brief Number of slots claimed since the last drain (may exceed capacity) */
+			std::atomic<std::uint32_t> writeCount{ 0 };
+
+			/** @brief Entries to promote, in hit order */
+			std::array<std::atomic<CacheEntry*>, READ_BUFFER_CAPACITY> entries{};
+		};
 
 		//----------------------------------------------
 		// Internal data structures
@@ -312,46 +977,592 @@ namespace nfx::memory
 			CachedItem( TValue val, CacheEntry meta );
 		};
 
-		mutable std::mutex m_mutex;
-		std::unordered_map<TKey, CachedItem> m_cache;
+		/** @brief Allocator rebound to the cache items stored by the map */
+		using CacheAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<std::pair<const TKey, CachedItem>>;
+
+		/** @brief Map type storing cache items by key */
+		using CacheMap = typename TStorage::template Map<TKey, CachedItem, THash, TKeyEqual, CacheAllocator>;
+
+		/** @brief Factory call in progress for a key, shared by the loading thread and its waiters */
+		struct InFlight
+		{
+			/** @brief Set once the value is cached or the factory failed */
+			std::atomic<bool> done{ false };
+
+			/** @brief Exception thrown by the factory, published by done */
+			std::exception_ptr error;
+
+			/** @brief Guards waiters against the completion of the call */
+			std::mutex waitersMutex;
+
+			/** @brief Coroutines suspended on the call, resumed once it is done */
+			std::vector<std::coroutine_handle<>> waiters;
+		};
+
+		/** @brief Suspends a coroutine until a factory call in progress is done */
+		struct FlightAwaiter
+		{
+			/** @brief The awaited call */
+			InFlight& flight;
+
+			/** @brief Ready once the call is done */
+			[[nodiscard]] inline bool await_ready() const noexcept;
+
+			/**
+			 * @brief Register the coroutine as a waiter of the call
+			 * @param awaiting The suspended coroutine
+			 * @return False to resume it at once if the call finished meanwhile
+			 */
+			inline bool await_suspend( std::coroutine_handle<> awaiting );
+
+			/** @brief Nothing to produce, the caller inspects the call */
+			inline void await_resume() const noexcept;
+		};
+
+		/** @brief Outcome of a locked lookup starting a load */
+		struct LoadStart
+		{
+			/** @brief The cached value on a hit */
+			TValue* hit{ nullptr };
+
+			/** @brief The call loading the key on a miss */
+			std::shared_ptr<InFlight> flight;
+
+			/** @brief Key registered in m_inFlight when the caller became the loader */
+			std::optional<TKey> ownedKey;
+		};
+
+		/** @brief Map type tracking factory calls in progress by key */
+		using InFlightMap = std::unordered_map<TKey, std::shared_ptr<InFlight>, THash, TKeyEqual>;
+
+		/** @brief Entry removed under the lock, awaiting delivery to the removal listener */
+		struct PendingRemoval
+		{
+			/** @brief Key of the removed entry */
+			TKey key;
+
+			/** @brief Value moved out of the removed entry */
+			TValue value;
+
+			/** @brief Reason for the removal */
+			RemovalCause cause;
+		};
+
+		/**
+		 * @brief Exclusive lock on the cache that delivers pending removals once released
+		 * @details Used in place of std::lock_guard by every operation that may erase entries
+		 */
+		class ExclusiveLock final
+		{
+		public:
+			/** @brief Lock the cache mutex exclusively */
+			inline explicit ExclusiveLock( LruCache& cache );
+
+			/** @brief Unlock the cache mutex, then notify the removal listener */
+			inline ~ExclusiveLock();
+
+			ExclusiveLock( const ExclusiveLock& ) = delete;
+			ExclusiveLock& operator=( const ExclusiveLock& ) = delete;
+
+		private:
+			LruCache& m_cache;
+		};
+
+		mutable std::shared_mutex m_mutex;
+		CacheMap m_cache;
 		LruCacheOptions m_options;
 
-		/** @brief Head of the LRU doubly-linked list (most recently used) */
-		CacheEntry* m_lruHead;
+		/** @brief Striped read buffers (null when read buffering is disabled) */
+		std::unique_ptr<ReadBuffer[]> m_readBuffers;
+
+		/** @brief Optional function computing entry weights */
+		WeigherFunction m_weigher;
+
+		/** @brief Sum of CacheEntry::size over all entries */
+		std::size_t m_totalWeight{ 0 };
+
+		/** @brief Total weight of the ShardedLruCache owning this shard, moved with m_totalWeight (null when not a weighted shard) */
+		std::atomic<std::size_t>* m_sharedWeight{ nullptr };
 
-		/** @brief Tail of the LRU doubly-linked list (least recently used) */
-		CacheEntry* m_lruTail;
+		/** @brief Statistics recorder (null when statistics are disabled) */
+		std::unique_ptr<LruCacheStatistics> m_statistics;
+
+		/** @brief Removal listener, shared with in-progress deliveries (null when not set) */
+		std::shared_ptr<const RemovalListener> m_removalListener;
+
+		/** @brief Removals collected under the lock since the last delivery */
+		std::vector<PendingRemoval> m_pendingRemovals;
+
+		/** @brief Keys whose factory is running outside the lock */
+		InFlightMap m_inFlight;
+
+		/** @brief Eviction order of the cached entries */
+		TPolicy<CacheEntry> m_policy;
+
+		/** @brief Entries indexed by expiry deadline */
+		TimerWheel<CacheEntry> m_timerWheel;
 
 		/** @brief Last time background cleanup was performed */
 		mutable std::chrono::steady_clock::time_point m_lastCleanupTime;
 
+		/** @brief Whether the last background cleanup cycle stopped with due entries left */
+		mutable bool m_cleanupPending{ false };
+
+		/** @brief Number of entries whose sliding expiration differs from the default or with an absolute expiration */
+		std::size_t m_customExpirationCount{ 0 };
+
+		/** @brief Thread running performMaintenance() (null when maintenance is disabled) */
+		std::shared_ptr<MaintenanceThread> m_maintenanceThread;
+
+		/** @brief Registration of this cache on the maintenance thread */
+		MaintenanceThread::TaskId m_maintenanceTask{ 0 };
+
+		/**
+		 * @brief True if erased nodes may be freed off the lock
+		 * @details std::allocator is thread-safe; others, such as SlabAllocator or an unsynchronized
+		 *          pmr pool, must only be used under the lock, so only the values are deferred
+		 */
+		static constexpr bool DEFER_NODES = std::is_same_v<TAllocator, std::allocator<std::pair<const TKey, TValue>>>;
+
+		/** @brief Erased entries, or their values, awaiting destruction by the maintenance thread */
+		std::vector<std::conditional_t<DEFER_NODES, typename CacheMap::node_type, TValue>> m_deferred;
+
+		/** @brief Shared coarse clock (null when the steady clock is read directly) */
+		std::shared_ptr<CoarseClock> m_clock;
+
+		/** @brief Cache reached by refresh tasks, cleared by ~LruCache so queued refreshes do nothing */
+		struct RefreshGuard
+		{
+			/** @brief Held shared by running refreshes, exclusively by ~LruCache */
+			std::shared_mutex mutex;
+
+			/** @brief The cache, null once destroyed */
+			LruCache* cache{ nullptr };
+		};
+
+		/** @brief Guard shared with refresh tasks (null when refresh after write is disabled) */
+		std::shared_ptr<RefreshGuard> m_refreshGuard;
+
+		/** @brief Function loading values for get() and refreshes (empty when refresh after write is disabled) */
+		ReloadFunction m_reload;
+
+		/**
+		 * @brief Read the current time from the configured clock
+		 * @return Coarse clock reading, or steady_clock::now() without a coarse clock
+		 */
+		[[nodiscard]] inline std::chrono::steady_clock::time_point currentTime() const noexcept;
+
 		//----------------------------------------------
-		// LRU list management
+		// Eviction policy
 		//----------------------------------------------
 
 		/**
-		 * @brief Add entry to head of LRU list (most recently used)
-		 * @param entry Entry to add to LRU list head
+		 * @brief Report a hit to the eviction policy
+		 * @param entry Entry that was hit
+		 */
+		inline void recordAccess( CacheEntry* entry );
+
+		/**
+		 * @brief Evict the entry chosen by the eviction policy
+		 */
+		inline void evictVictim();
+
+		/**
+		 * @brief Hash the key of an entry for the eviction policy
+		 * @param entry Cached entry
+		 * @return Hash of its key
 		 */
-		inline void addToLruHead( CacheEntry* entry ) noexcept;
+		[[nodiscard]] inline std::uint64_t keyHash( const CacheEntry* entry ) const;
 
 		/**
-		 * @brief Remove entry from LRU list
-		 * @param entry Entry to remove from LRU list
+		 * @brief Evict entries chosen by the eviction policy until an entry of the given weight fits
+		 * @param weight Weight of the entry about to be inserted
 		 */
-		inline void removeFromLru( CacheEntry* entry ) noexcept;
+		inline void evictForInsertion( std::size_t weight );
 
 		/**
-		 * @brief Move entry to head of LRU list (mark as most recently used)
-		 * @param entry Entry to move to LRU list head
+		 * @brief Evict the entry chosen by the eviction policy, for a ShardedLruCache over its weight limit
+		 * @return True if an entry was evicted
+		 */
+		inline bool evictForSharedWeight();
+
+		/**
+		 * @brief Account the weight of an entry entering the cache
+		 * @param weight Entry weight, also added to the shared weight of a shard
+		 */
+		inline void addWeight( std::size_t weight ) noexcept;
+
+		/**
+		 * @brief Account the weight of an entry leaving the cache
+		 * @param weight Entry weight, also subtracted from the shared weight of a shard
+		 */
+		inline void subtractWeight( std::size_t weight ) noexcept;
+
+		/**
+		 * @brief Unlink an entry from the LRU list, update accounting and erase it
+		 * @param it Iterator to the entry to erase
+		 * @param cause Reason for the removal, recorded in statistics and reported to the listener
+		 * @return Iterator following the erased entry
+		 */
+		inline typename CacheMap::iterator eraseItem( typename CacheMap::iterator it, RemovalCause cause );
+
+		/**
+		 * @brief Check whether an entry needs the expiry index to be removed in time
+		 * @param entry Cached entry
+		 * @return True if its sliding expiration differs from the default or it expires absolutely,
+		 *         so that least recently used order no longer matches expiry order
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool hasCustomExpiration( const CacheEntry& entry ) const noexcept;
+
+		//----------------------------------------------
+		// Expiration
+		//----------------------------------------------
+
+		/**
+		 * @brief Remove the entries whose deadline has passed, visiting at most budget entries
+		 * @param now Current time
+		 * @param budget Maximum number of entries to visit, live or expired
+		 * @return True if every due entry was removed, false if the budget ran out first
+		 * @details When all entries share the default expiration, LRU order is expiry order and
+		 *          expired entries are taken from the LRU tail until the first live one. Otherwise
+		 *          the timer wheel is advanced, visiting only the buckets that elapsed since the
+		 *          previous call; entries are filed on insertion and re-filed under their current
+		 *          deadline when their bucket comes up after they were accessed. Both resume where
+		 *          an interrupted call stopped. Must be called after the read buffers are drained.
+		 */
+		inline bool expireDue( std::chrono::steady_clock::time_point now, std::size_t budget = SIZE_MAX );
+
+		//----------------------------------------------
+		// Removal delivery
+		//----------------------------------------------
+
+		/**
+		 * @brief Release the exclusive lock and deliver the removals collected under it
+		 * @details Must be called with m_mutex held exclusively
+		 */
+		inline void unlockAndNotify() noexcept;
+
+		//----------------------------------------------
+		// Lookup implementation
+		//----------------------------------------------
+
+		/**
+		 * @brief Shared implementation of the getOrCreate() overloads
+		 * @param key The cache key or an equivalent heterogeneous value
+		 * @param factory Function to create the value if not cached
+		 * @param configure Optional function to configure cache entry
+		 * @return Reference to the cached value
+		 */
+		template <typename TLookup, typename TFactory, typename TConfigure>
+		inline TValue& getOrCreateImpl( const TLookup& key, TFactory& factory, TConfigure& configure );
+
+		/**
+		 * @brief Get or create a cache entry, returning a copy of the value made under the lock
+		 * @param key The cache key
+		 * @param factory Function to create the value if not cached
+		 * @param configure Optional function to configure cache entry
+		 * @return Copy of the cached value, valid whatever other threads evict or remove meanwhile
+		 * @details Implements get() and the lookups of AsyncLruCache. A stale hit in a refreshing
+		 *          cache submits its refresh like get().
+		 */
+		template <typename TFactory, typename TConfigure>
+			requires std::copy_constructible<TValue>
+		inline TValue getOrCreateValue( const TKey& key, TFactory& factory, TConfigure& configure );
+
+		/**
+		 * @brief Try to get a copy of a cached value made under the lock, without creating it
+		 * @param key The cache key
+		 * @return Optional containing a copy of the value if found and not expired
 		 */
-		inline void moveToLruHead( CacheEntry* entry ) noexcept;
+		inline std::optional<TValue> tryGetValue( const TKey& key )
+			requires std::copy_constructible<TValue>;
 
 		/**
-		 * @brief Evict least recently used entry in O(1) time
+		 * @brief Serve a hit under the shared lock, recording it
+		 * @param key The cache key or an equivalent heterogeneous value
+		 * @param copy Receives a copy of the value under the lock, for by-value lookups; null for lookups by reference
+		 * @return The cached value, nullptr if the exclusive path is required
 		 */
-		inline void evictLeastRecentlyUsed();
+		template <typename TLookup>
+		inline TValue* sharedHit( const TLookup& key, std::optional<TValue>* copy );
+
+		/**
+		 * @brief Look a key up under the exclusive lock, joining or registering its load on a miss
+		 * @param key The cache key or an equivalent heterogeneous value
+		 * @param copy Receives a copy of a hit under the lock and enables refreshing a stale one, for
+		 *             by-value lookups; null for lookups by reference
+		 * @return The hit, or the call to wait for, or the call the caller registered and must complete;
+		 *         a hit with a registered call is a refresh the caller must submit
+		 */
+		template <typename TLookup>
+		inline LoadStart startLoad( const TLookup& key, std::optional<TValue>* copy );
+
+		/**
+		 * @brief Cache a loaded value and unregister its load
+		 * @param start The load registered by the caller
+		 * @param value The loaded value
+		 * @param configure Optional function to configure cache entry
+		 * @return Reference to the cached value
+		 */
+		template <typename TConfigure>
+		inline TValue& insertLoaded( LoadStart& start, TValue&& value, TConfigure& configure );
+
+		/**
+		 * @brief Submit the refresh registered by startLoad() to the refresh executor
+		 * @param start The stale hit and its registered refresh
+		 */
+		inline void startRefresh( LoadStart& start );
+
+		/**
+		 * @brief Reload a key with the reload function and replace its value, run by the refresh executor
+		 * @param key The cache key
+		 * @param flight The refresh registered for the key
+		 * @details A failed reload is recorded in the statistics and otherwise ignored
+		 */
+		inline void refreshValue( const TKey& key, const std::shared_ptr<InFlight>& flight ) noexcept;
+
+		/**
+		 * @brief Replace the value of an entry, keeping its position and expiration
+		 * @param it Iterator to the entry
+		 * @param value The new value
+		 * @details Must be called with m_mutex held exclusively, after the read buffers are drained.
+		 *          If the policy fails to relink a reweighed entry, the entry is dropped.
+		 */
+		inline void replaceValue( typename CacheMap::iterator it, TValue&& value );
+
+		/**
+		 * @brief Check whether a value is old enough to be refreshed
+		 * @param entry Entry of the value
+		 * @param now Current time
+		 * @return True with refresh after write enabled and the value written at least the threshold ago
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool refreshDue( const CacheEntry& entry, std::chrono::steady_clock::time_point now ) const noexcept;
+
+		/**
+		 * @brief Reject lookups returning references into a refreshing cache
+		 * @throws std::logic_error if refresh after write is enabled
+		 */
+		inline void requireReferenceLookups() const;
+
+		/**
+		 * @brief Coroutine resolving a getOrLoad() miss
+		 * @param key The cache key
+		 * @param start Outcome of the lookup made when the miss was detected
+		 * @param loader Function starting the load of the value
+		 * @param configure Optional function to configure cache entry
+		 * @return Task producing the cached value
+		 */
+		template <typename TLoader, typename TConfigure>
+		inline CacheTask<TValue*> loadAsync( TKey key, LoadStart start, TLoader loader, TConfigure configure );
+
+		/**
+		 * @brief Shared implementation of the tryGet() overloads and tryGetValue()
+		 * @tparam TResult std::optional of a reference to the value or of a copy, made under the lock
+		 * @param key The cache key or an equivalent heterogeneous value
+		 * @return Optional containing the value if found and not expired
+		 */
+		template <typename TResult, typename TLookup>
+		inline TResult tryGetImpl( const TLookup& key );
+
+		/**
+		 * @brief Resolve a key lookup, refreshing a live entry and erasing an expired one
+		 * @param key The cache key or an equivalent heterogeneous value
+		 * @param it Result of finding key in m_cache
+		 * @param now Current time
+		 * @return Item on a live hit, nullptr on a miss
+		 * @details Must be called with m_mutex held exclusively, after the read buffers are drained
+		 */
+		template <typename TLookup>
+		inline CachedItem* lookupExclusive( const TLookup& key, typename CacheMap::iterator it, std::chrono::steady_clock::time_point now );
+
+		/** @brief Number of keys a batched lookup hashes and prefetches before probing any of them */
+		static constexpr std::size_t BATCH_PREFETCH_WINDOW = 16;
+
+		/**
+		 * @brief Find a subset of keys in m_cache, overlapping their cache misses when possible
+		 * @param keys The cache keys
+		 * @param indices Positions in keys to find
+		 * @param visit Called with each position and its m_cache iterator, in order
+		 * @details With a storage engine that supports prefetching, each window of keys is
+		 *          hashed first, then the probe groups and candidate entries of the whole window
+		 *          are prefetched, and only then are the probes resolved. Other engines find the
+		 *          keys one at a time. Each key is found right before its visit, so visit may
+		 *          erase entries.
+		 */
+		template <typename TIndices, typename TVisit>
+		inline void findBatch( std::span<const TKey> keys, const TIndices& indices, TVisit&& visit );
+
+		/**
+		 * @brief Implementation of tryGetMany() over a subset of the keys
+		 * @param keys The cache keys
+		 * @param indices Positions in keys to look up, each at most once
+		 * @param values Receives the results at the looked up positions
+		 * @param hits Hit mask, set at the positions of hits
+		 */
+		template <typename TIndices>
+		inline void tryGetBatch( std::span<const TKey> keys, const TIndices& indices,
+			std::span<std::optional<std::reference_wrapper<TValue>>> values, std::vector<bool>& hits );
+
+		/**
+		 * @brief Implementation of insertMany() over a subset of the entries
+		 * @param entries Keys and values to cache
+		 * @param indices Positions in entries to insert, each at most once
+		 * @param configure Optional function to configure each new cache entry
+		 * @param inserted Insertion mask, set at the positions of inserted entries
+		 */
+		template <typename TIndices, typename TConfigure>
+		inline void insertBatch( std::span<std::pair<TKey, TValue>> entries, const TIndices& indices, TConfigure& configure, std::vector<bool>& inserted );
+
+		/**
+		 * @brief Shared implementation of the remove() overloads
+		 * @param key The cache key or an equivalent heterogeneous value
+		 * @return True if entry was removed, false if not found
+		 */
+		template <typename TLookup>
+		inline bool removeImpl( const TLookup& key );
+
+		/**
+		 * @brief Insert a newly created value, evicting as required
+		 * @param key The cache key, moved into the map
+		 * @param value The value to cache
+		 * @param configure Optional function to configure the cache entry
+		 * @return Reference to the cached value (the existing one if the key is already cached)
+		 * @details Must be called with m_mutex held exclusively, after the read buffers are drained
+		 */
+		template <typename TConfigure>
+		inline TValue& insertItem( TKey&& key, TValue&& value, TConfigure& configure );
+
+		/**
+		 * @brief Unregister a failed factory call and wake its waiters
+		 * @param key The cache key
+		 * @param flight The failed call
+		 * @param error Exception thrown while loading or inserting
+		 */
+		inline void abandonFlight( const TKey& key, const std::shared_ptr<InFlight>& flight, std::exception_ptr error ) noexcept;
+
+		/**
+		 * @brief Mark a factory call as finished and wake its waiters
+		 * @param flight The finished call
+		 * @param error Exception to rethrow in the waiters, null on success
+		 */
+		static inline void completeFlight( InFlight& flight, std::exception_ptr error ) noexcept;
+
+		/**
+		 * @brief Invoke the factory, recording its latency when statistics are enabled
+		 * @param factory Function creating the value
+		 * @return The created value
+		 */
+		template <typename TFactory>
+		inline TValue loadValue( TFactory& factory );
+
+		//----------------------------------------------
+		// Shared hit path
+		//----------------------------------------------
+
+		/**
+		 * @brief Check whether hits are served under the shared lock
+		 * @return True with read buffering or a policy recording hits with atomic stores
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool sharedHits() const noexcept;
+
+		/**
+		 * @brief Serve a cache hit under the shared lock
+		 * @param it Result of finding the key in m_cache
+		 * @param now Current time
+		 * @return Item on a live hit whose promotion was recorded, nullptr on a miss or if the exclusive path is required
+		 * @details Must be called with m_mutex held in shared mode
+		 */
+		inline CachedItem* tryGetShared( typename CacheMap::iterator it, std::chrono::steady_clock::time_point now );
+
+		/**
+		 * @brief Append an LRU promotion to the calling thread's read buffer
+		 * @param entry Entry that was hit
+		 * @return True if recorded, false if the buffer is full
+		 */
+		inline bool recordRead( CacheEntry* entry ) noexcept;
+
+		/**
+		 * @brief Replay all buffered LRU promotions
+		 * @details Must be called with m_mutex held exclusively, before any entry is erased
+		 */
+		inline void drainReadBuffers() noexcept;
+	};
+
+	//=====================================================================
+	// LruCache::LoadAwaiter class
+	//=====================================================================
+
+	/**
+	 * @brief Awaitable lookup of a key, loading it on a miss
+	 * @details Awaited at most once. Nothing happens before it is awaited; a hit then completes
+	 *          without suspension and a miss runs on a CacheTask owned by the awaitable.
+	 */
+	template <typename TKey, typename TValue, typename THash, typename TKeyEqual, typename TStorage, typename TAllocator, template <typename> typename TPolicy>
+	template <typename TLoader, typename TConfigure>
+	class LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>::LoadAwaiter final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Capture a lookup
+		 * @param cache The cache to look up
+		 * @param key The cache key
+		 * @param loader Function starting the load of the value
+		 * @param configure Optional function to configure cache entry
+		 */
+		inline LoadAwaiter( LruCache& cache, const TKey& key, TLoader loader, TConfigure configure );
+
+		//----------------------------------------------
+		// Awaiting
+		//----------------------------------------------
+
+		/**
+		 * @brief Look the key up
+		 * @return True on a hit, which resumes the caller without suspension
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool await_ready();
+
+		/**
+		 * @brief Start or join the load of the missing key
+		 * @param awaiting Coroutine resumed with the cached value
+		 * @return Coroutine resolving the miss, resumed in place of the caller
+		 */
+		inline std::coroutine_handle<> await_suspend( std::coroutine_handle<> awaiting );
+
+		/**
+		 * @brief Get the cached value
+		 * @return Reference to the cached value
+		 * @throws The exception of a failed load
+		 */
+		inline TValue& await_resume();
+
+	private:
+		LruCache& m_cache;
+		const TKey& m_key;
+		TLoader m_loader;
+		TConfigure m_configure;
+
+		/** @brief Outcome of the lookup made by await_ready() */
+		LoadStart m_start;
+
+		/** @brief Coroutine resolving a miss, created by await_suspend() */
+		std::optional<CacheTask<TValue*>> m_task;
 	};
+
+	namespace pmr
+	{
+		/** @brief LruCache allocating its entries from a std::pmr::memory_resource */
+		template <typename TKey, typename TValue, typename THash = std::hash<TKey>, typename TKeyEqual = std::equal_to<TKey>, typename TStorage = NodeStorage,
+			template <typename> typename TPolicy = LruPolicy>
+		using LruCache = nfx::memory::LruCache<TKey, TValue, THash, TKeyEqual, TStorage, std::pmr::polymorphic_allocator<std::pair<const TKey, TValue>>, TPolicy>;
+	} // namespace pmr
 } // namespace nfx::memory
 
 #include "nfx/detail/memory/LruCache.inl"
@@ -0,0 +1,308 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file LruCacheStatistics.h
+ * @brief Lock-free cache statistics with striped counters and load latency histogram
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// LruCacheStatisticsSnapshot struct
+	//=====================================================================
+
+	/**
+	 * @brief Point-in-time copy of cache statistics
+	 * @details Counters are summed over all stripes without a global lock, so a snapshot
+	 *          taken under concurrent load may be off by in-flight operations.
+	 */
+	struct LruCacheStatisticsSnapshot final
+	{
+		/** @brief Number of load latency histogram buckets */
+		static constexpr std::size_t LATENCY_BUCKET_COUNT = 32;
+
+		/** @brief Number of lookups that returned a live entry */
+		std::uint64_t hitCount{ 0 };
+
+		/** @brief Number of lookups that found no live entry */
+		std::uint64_t missCount{ 0 };
+
+		/** @brief Number of factory invocations that produced a value */
+		std::uint64_t loadSuccessCount{ 0 };
+
+		/** @brief Number of factory invocations that threw */
+		std::uint64_t loadFailureCount{ 0 };
+
+		/** @brief Total time spent in factory invocations */
+		std::chrono::nanoseconds totalLoadTime{ 0 };
+
+		/** @brief Number of entries evicted by the size or weight limit */
+		std::uint64_t evictionCount{ 0 };
+
+		/** @brief Number of entries removed because they expired */
+		std::uint64_t expirationCount{ 0 };
+
+		/**
+		 * @brief Factory latency histogram
+		 * @details Bucket i counts loads that took less than 2^i nanoseconds and at least
+		 *          2^(i-1) nanoseconds; the last bucket also counts every slower load.
+		 */
+		std::array<std::uint64_t, LATENCY_BUCKET_COUNT> loadLatencyBuckets{};
+
+		//----------------------------------------------
+		// Derived metrics
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the total number of lookups
+		 * @return Hits plus misses
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::uint64_t requestCount() const noexcept;
+
+		/**
+		 * @brief Get the ratio of lookups that were hits
+		 * @return Hit ratio in [0, 1], 1 when no lookup was made
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline double hitRatio() const noexcept;
+
+		/**
+		 * @brief Get the average time spent per factory invocation
+		 * @return Average load time, zero when no load was made
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::chrono::nanoseconds averageLoadPenalty() const noexcept;
+
+		/**
+		 * @brief Get the exclusive upper bound of a latency bucket
+		 * @param bucket Bucket index
+		 * @return Upper bound in nanoseconds
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] static constexpr std::uint64_t latencyBucketUpperBound( std::size_t bucket ) noexcept;
+
+		//----------------------------------------------
+		// Aggregation
+		//----------------------------------------------
+
+		/**
+		 * @brief Accumulate another snapshot into this one
+		 * @param other Snapshot to add, e.g. from another shard
+		 * @return Reference to this snapshot
+		 */
+		inline LruCacheStatisticsSnapshot& operator+=( const LruCacheStatisticsSnapshot& other ) noexcept;
+
+		//----------------------------------------------
+		// Rendering
+		//----------------------------------------------
+
+		/**
+		 * @brief Render the snapshot as a JSON object
+		 * @return JSON text, latency buckets with zero count are omitted
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::string toJson() const;
+
+		/**
+		 * @brief Render the snapshot in the Prometheus text exposition format
+		 * @param metricPrefix Prefix of every metric name
+		 * @return Counters and a cumulative load duration histogram in seconds
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::string toPrometheus( std::string_view metricPrefix = "nfx_lrucache" ) const;
+	};
+
+	//=====================================================================
+	// LruCacheStatistics class
+	//=====================================================================
+
+	/**
+	 * @brief Concurrent statistics recorder used by LruCache
+	 * @details Every thread increments relaxed atomic counters on its own cache-line
+	 *          aligned stripe, so recording never contends with the cache mutex and
+	 *          rarely with other threads. Stripes are only summed when a snapshot is taken.
+	 */
+	class LruCacheStatistics final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/** @brief Construct with all counters at zero */
+		LruCacheStatistics() = default;
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		LruCacheStatistics( const LruCacheStatistics& ) = delete;
+		LruCacheStatistics( LruCacheStatistics&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		LruCacheStatistics& operator=( const LruCacheStatistics& ) = delete;
+		LruCacheStatistics& operator=( LruCacheStatistics&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		// Default destructor
+		~LruCacheStatistics() = default;
+
+		//----------------------------------------------
+		// Recording
+		//----------------------------------------------
+
+		/**
+		 * @brief Record lookups that returned a live entry
+		 * @param count Number of hits
+		 */
+		inline void recordHits( std::uint64_t count = 1 ) noexcept;
+
+		/**
+		 * @brief Record lookups that found no live entry
+		 * @param count Number of misses
+		 */
+		inline void recordMisses( std::uint64_t count = 1 ) noexcept;
+
+		/**
+		 * @brief Record a successful factory invocation
+		 * @param duration Time spent in the factory
+		 */
+		inline void recordLoadSuccess( std::chrono::nanoseconds duration ) noexcept;
+
+		/**
+		 * @brief Record a factory invocation that threw
+		 * @param duration Time spent in the factory
+		 */
+		inline void recordLoadFailure( std::chrono::nanoseconds duration ) noexcept;
+
+		/**
+		 * @brief Record entries evicted by the size or weight limit
+		 * @param count Number of evictions
+		 */
+		inline void recordEvictions( std::uint64_t count = 1 ) noexcept;
+
+		/**
+		 * @brief Record entries removed because they expired
+		 * @param count Number of expirations
+		 */
+		inline void recordExpirations( std::uint64_t count = 1 ) noexcept;
+
+		//----------------------------------------------
+		// Reporting
+		//----------------------------------------------
+
+		/**
+		 * @brief Sum all stripes into a snapshot
+		 * @return Current statistics
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline LruCacheStatisticsSnapshot snapshot() const noexcept;
+
+		/**
+		 * @brief Reset all counters to zero
+		 */
+		inline void reset() noexcept;
+
+	private:
+		//----------------------------------------------
+		// Internal data structures
+		//----------------------------------------------
+
+		/** @brief Number of independent counter stripes */
+		static constexpr std::size_t STRIPE_COUNT = 8;
+
+		/** @brief Counter slots within a stripe */
+		enum Counter : std::size_t
+		{
+			Hits = 0,
+			Misses,
+			LoadSuccesses,
+			LoadFailures,
+			LoadTimeNanos,
+			Evictions,
+			Expirations,
+			CounterCount
+		};
+
+		/** @brief Counters owned by a subset of threads */
+		struct alignas( 64 ) Stripe
+		{
+			/** @brief Event counters indexed by Counter */
+			std::array<std::atomic<std::uint64_t>, CounterCount> counters{};
+
+			/** @brief Load latency histogram */
+			std::array<std::atomic<std::uint64_t>, LruCacheStatisticsSnapshot::LATENCY_BUCKET_COUNT> latencyBuckets{};
+		};
+
+		std::array<Stripe, STRIPE_COUNT> m_stripes{};
+
+		//----------------------------------------------
+		// Helpers
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the stripe of the calling thread
+		 * @return Reference to the stripe
+		 */
+		inline Stripe& localStripe() noexcept;
+
+		/**
+		 * @brief Add to a counter of the calling thread's stripe
+		 * @param counter Counter to increment
+		 * @param value Amount to add
+		 */
+		inline void add( Counter counter, std::uint64_t value ) noexcept;
+
+		/**
+		 * @brief Record a load duration in the total and the histogram
+		 * @param duration Time spent in the factory
+		 */
+		inline void recordLoadTime( std::chrono::nanoseconds duration ) noexcept;
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/LruCacheStatistics.inl"
@@ -0,0 +1,167 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file MaintenanceThread.h
+ * @brief Background thread running periodic cache maintenance tasks
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// MaintenanceThread class
+	//=====================================================================
+
+	/**
+	 * @brief Thread running registered tasks on a schedule, shared by any number of caches
+	 * @details Tasks run one at a time, each at its own interval. A cache registers its
+	 *          maintenance with add() and unregisters it with remove(), which waits for a run
+	 *          in progress, so the cache can be destroyed right after. The thread is stopped
+	 *          and joined when the last owner releases it.
+	 */
+	class MaintenanceThread final
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Periodic task, exceptions thrown by it are discarded */
+		using Task = std::function<void()>;
+
+		/** @brief Identifier of a registered task */
+		using TaskId = std::uint64_t;
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/** @brief Start a thread with no tasks */
+		inline MaintenanceThread();
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		MaintenanceThread( const MaintenanceThread& ) = delete;
+		MaintenanceThread( MaintenanceThread&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		MaintenanceThread& operator=( const MaintenanceThread& ) = delete;
+		MaintenanceThread& operator=( MaintenanceThread&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Stop and join the thread, tasks still registered do not run again */
+		~MaintenanceThread() = default;
+
+		//----------------------------------------------
+		// Tasks
+		//----------------------------------------------
+
+		/**
+		 * @brief Register a task
+		 * @param task Function to run
+		 * @param interval Time between the end of one run and the start of the next, must be positive
+		 * @return Identifier to pass to remove()
+		 */
+		inline TaskId add( Task task, std::chrono::milliseconds interval );
+
+		/**
+		 * @brief Unregister a task, waiting for a run in progress on another thread to finish
+		 * @param id Identifier returned by add()
+		 */
+		inline void remove( TaskId id );
+
+		/**
+		 * @brief Get the number of registered tasks
+		 * @return Number of tasks
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t taskCount() const;
+
+	private:
+		/** @brief Registered task and its schedule */
+		struct ScheduledTask
+		{
+			/** @brief Task identifier */
+			TaskId id;
+
+			/** @brief Function to run */
+			Task task;
+
+			/** @brief Time between runs */
+			std::chrono::milliseconds interval;
+
+			/** @brief Time of the next run */
+			std::chrono::steady_clock::time_point next;
+		};
+
+		/**
+		 * @brief Thread body, runs due tasks until stop is requested
+		 * @param stopToken Stop token of the thread
+		 */
+		inline void run( std::stop_token stopToken );
+
+		mutable std::mutex m_mutex;
+
+		/** @brief Signalled when a task is added and when a run finishes */
+		std::condition_variable_any m_changed;
+
+		/** @brief Registered tasks */
+		std::vector<ScheduledTask> m_tasks;
+
+		/** @brief Identifier given to the next task */
+		TaskId m_nextId{ 1 };
+
+		/** @brief Incremented whenever a task is added or removed */
+		std::uint64_t m_generation{ 0 };
+
+		/** @brief Identifier of the task running on the thread (0 when idle) */
+		TaskId m_running{ 0 };
+
+		/** @brief Maintenance thread, declared last so it stops before the members it uses go away */
+		std::jthread m_thread;
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/MaintenanceThread.inl"
@@ -0,0 +1,447 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file ShardedLruCache.h
+ * @brief Lock-striped LRU cache built from independent LruCache shards
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "nfx/memory/LruCache.h"
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// ShardedLruCache class
+	//=====================================================================
+
+	/**
+	 * @brief Thread-safe LRU cache partitioned into independently locked shards
+	 * @tparam TKey Key type for cache entries
+	 * @tparam TValue Value type for cached objects
+	 * @tparam THash Hash function type for keys, also used for shard selection
+	 * @tparam TKeyEqual Key equality type, transparent together with THash to enable heterogeneous lookup
+	 * @tparam TStorage Storage engine of every shard, NodeStorage or FlatStorage
+	 * @tparam TAllocator Allocator of every shard, default-constructed per shard unless an
+	 *                    AllocatorFactory is given, so stateful allocators such as SlabAllocator
+	 *                    are never shared across shard locks by default
+	 * @tparam TPolicy Eviction policy of every shard, LruPolicy by default
+	 * @details Keys are hashed onto a power-of-two number of LruCache shards, each owning
+	 *          its own mutex, map, intrusive LRU list and share of the size limit.
+	 *          Operations on different shards never contend, so hit throughput scales
+	 *          with the number of cores. LRU ordering and eviction are per shard.
+	 *
+	 *          The weight limit also holds for the whole cache: shards add their weight to a
+	 *          shared total, and an insertion leaving it above maxWeight evicts from the other
+	 *          shards, so an entry heavier than its shard's share cannot push the cache over
+	 *          the limit. Once getOrCreate(), get() or insertMany() returns, totalWeight() is at
+	 *          most maxWeight, unless a single entry heavier than maxWeight is cached (admitted
+	 *          alone in its shard, as by LruCache). Entries stored by background refreshes or
+	 *          completing getOrLoad() calls are accounted by the next of these calls.
+	 */
+	template <typename TKey, typename TValue, typename THash = std::hash<TKey>, typename TKeyEqual = std::equal_to<TKey>, typename TStorage = NodeStorage,
+		typename TAllocator = std::allocator<std::pair<const TKey, TValue>>, template <typename> typename TPolicy = LruPolicy>
+	class ShardedLruCache final
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		/** @brief Underlying cache type used for each shard */
+		using Shard = LruCache<TKey, TValue, THash, TKeyEqual, TStorage, TAllocator, TPolicy>;
+
+		/** @brief Function type for creating cache values when not found */
+		using FactoryFunction = typename Shard::FactoryFunction;
+
+		/** @brief Function type for configuring cache entry metadata */
+		using ConfigFunction = typename Shard::ConfigFunction;
+
+		/** @brief Function type computing the weight of a newly created entry */
+		using WeigherFunction = typename Shard::WeigherFunction;
+
+		/** @brief Function type loading the value of a key for get(), with refresh after write */
+		using ReloadFunction = typename Shard::ReloadFunction;
+
+		/** @brief Function type notified of every entry leaving the cache */
+		using RemovalListener = typename Shard::RemovalListener;
+
+		/** @brief Function type creating the allocator of a shard from the shard index */
+		using AllocatorFactory = std::function<TAllocator( std::size_t shard )>;
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct sharded cache with specified options
+		 * @param options Configuration options, the size and weight limits are split across shards
+		 * @param shardCount Requested number of shards (0 = derived from hardware concurrency)
+		 * @details The shard count is rounded down to a power of two and never exceeds
+		 *          a non-zero size or weight limit, so every shard receives at least one slot
+		 *          and one unit of weight.
+		 */
+		inline explicit ShardedLruCache( const LruCacheOptions& options = {}, std::size_t shardCount = 0 );
+
+		/**
+		 * @brief Construct sharded cache with specified options and entry weigher
+		 * @param options Configuration options, the size and weight limits are split across shards
+		 * @param shardCount Requested number of shards (0 = derived from hardware concurrency)
+		 * @param weigher Function computing entry weights, shared by all shards
+		 */
+		inline ShardedLruCache( const LruCacheOptions& options, std::size_t shardCount, WeigherFunction weigher );
+
+		/**
+		 * @brief Construct sharded cache with specified options, entry weigher and shard allocators
+		 * @param options Configuration options, the size and weight limits are split across shards
+		 * @param shardCount Requested number of shards (0 = derived from hardware concurrency)
+		 * @param weigher Function computing entry weights, shared by all shards (may be empty)
+		 * @param allocatorFactory Function called once per shard, in shard order, for its allocator
+		 *                         (empty = default-constructed allocators)
+		 * @details Shards allocate under their own locks, concurrently with each other. Returning
+		 *          one SlabAllocator arena per shard keeps arenas unsynchronized; allocators shared
+		 *          across shards need a thread-safe resource such as std::pmr::synchronized_pool_resource.
+		 */
+		inline ShardedLruCache( const LruCacheOptions& options, std::size_t shardCount, WeigherFunction weigher, AllocatorFactory allocatorFactory );
+
+		/**
+		 * @brief Construct refreshing sharded cache with specified options and reload function
+		 * @param options Configuration options with refresh after write enabled, the limits are split across shards
+		 * @param shardCount Requested number of shards (0 = derived from hardware concurrency)
+		 * @param reload Function loading the value of a key, shared by all shards
+		 */
+		inline ShardedLruCache( const LruCacheOptions& options, std::size_t shardCount, ReloadFunction reload )
+			requires RefreshableValue<TValue>;
+
+		/**
+		 * @brief Construct sharded cache with specified options, entry weigher, reload function and shard allocators
+		 * @param options Configuration options, the size and weight limits are split across shards
+		 * @param shardCount Requested number of shards (0 = derived from hardware concurrency)
+		 * @param weigher Function computing entry weights, shared by all shards (may be empty)
+		 * @param reload Function loading the value of a key, shared by all shards (empty without refresh after write)
+		 * @param allocatorFactory Function called once per shard, in shard order, for its allocator
+		 *                         (empty = default-constructed allocators)
+		 */
+		inline ShardedLruCache( const LruCacheOptions& options, std::size_t shardCount, WeigherFunction weigher, ReloadFunction reload, AllocatorFactory allocatorFactory );
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		ShardedLruCache( const ShardedLruCache& ) = delete;
+		ShardedLruCache( ShardedLruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		ShardedLruCache& operator=( const ShardedLruCache& ) = delete;
+		ShardedLruCache& operator=( ShardedLruCache&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		// Default destructor
+		~ShardedLruCache() = default;
+
+		//----------------------------------------------
+		// Cache operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Get or create a cache entry using factory function
+		 * @tparam TFactory Factory callable type, taken by reference and never copied
+		 * @tparam TConfigure Configurator callable type, std::nullptr_t when omitted
+		 * @param key The cache key
+		 * @param factory Function to create the value if not cached
+		 * @param configure Optional function to configure cache entry
+		 * @return Reference to the cached value
+		 */
+		template <CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure = std::nullptr_t>
+		inline TValue& getOrCreate( const TKey& key, TFactory&& factory, TConfigure&& configure = nullptr );
+
+		/**
+		 * @brief Get or create a cache entry by a key-like value, constructing a key only on insertion
+		 * @tparam TLookup Heterogeneous key type accepted by the transparent hash and equality
+		 * @tparam TFactory Factory callable type, taken by reference and never copied
+		 * @tparam TConfigure Configurator callable type, std::nullptr_t when omitted
+		 * @param key Value equivalent to the cache key
+		 * @param factory Function to create the value if not cached
+		 * @param configure Optional function to configure cache entry
+		 * @return Reference to the cached value
+		 */
+		template <typename TLookup, CacheFactory<TValue> TFactory, CacheEntryConfigurator TConfigure = std::nullptr_t>
+			requires TransparentLookup<TLookup, TKey, THash, TKeyEqual> && std::constructible_from<TKey, const TLookup&>
+		inline TValue& getOrCreate( const TLookup& key, TFactory&& factory, TConfigure&& configure = nullptr );
+
+		/**
+		 * @brief Get a copy of the value of a key in a refreshing cache, loading it on a miss
+		 * @param key The cache key
+		 * @return The cached value handle
+		 * @throws std::logic_error if refresh after write is not enabled
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline TValue get( const TKey& key )
+			requires RefreshableValue<TValue>;
+
+		//----------------------------------------------
+		// Coroutine operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Get or load a cache entry from a coroutine, as co_await cache.getOrLoad( key, loader )
+		 * @tparam TLoader Loader callable type, returning an awaitable of the value such as CacheTask<TValue>
+		 * @tparam TConfigure Configurator callable type, std::nullptr_t when omitted
+		 * @param key The cache key, which must outlive the returned awaitable
+		 * @param loader Function starting the load of the value, invoked at most once and only on a miss
+		 * @param configure Optional function to configure cache entry
+		 * @return Awaitable resuming the caller with a reference to the cached value
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		template <typename TLoader, CacheEntryConfigurator TConfigure = std::nullptr_t>
+			requires std::invocable<std::decay_t<TLoader>&> && std::move_constructible<std::decay_t<TLoader>>
+		[[nodiscard]] inline typename Shard::template LoadAwaiter<std::decay_t<TLoader>, std::decay_t<TConfigure>> getOrLoad( const TKey& key, TLoader&& loader, TConfigure&& configure = nullptr );
+
+		//----------------------------------------------
+		// Lookup operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Try to get a cached value without creating it
+		 * @param key The cache key
+		 * @return Optional containing the value if found and not expired
+		 */
+		inline std::optional<std::reference_wrapper<TValue>> tryGet( const TKey& key );
+
+		/**
+		 * @brief Try to get a cached value by a key-like value without constructing a key
+		 * @tparam TLookup Heterogeneous key type accepted by the transparent hash and equality
+		 * @param key Value equivalent to the cache key
+		 * @return Optional containing the value if found and not expired
+		 */
+		template <typename TLookup>
+			requires TransparentLookup<TLookup, TKey, THash, TKeyEqual>
+		inline std::optional<std::reference_wrapper<TValue>> tryGet( const TLookup& key );
+
+		//----------------------------------------------
+		// Batch operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Try to get many cached values, locking each shard involved once
+		 * @param keys The cache keys
+		 * @param values Receives at each key's position its value, or nullopt on a miss;
+		 *               must hold at least keys.size() elements
+		 * @return Hit mask, true at the position of every key found and not expired
+		 * @throws std::invalid_argument if values is shorter than keys
+		 * @throws std::logic_error if refresh after write is enabled
+		 */
+		inline std::vector<bool> tryGetMany( std::span<const TKey> keys, std::span<std::optional<std::reference_wrapper<TValue>>> values );
+
+		/**
+		 * @brief Insert many entries, locking each shard involved once
+		 * @tparam TConfigure Configurator callable type, std::nullptr_t when omitted
+		 * @param entries Keys and values to cache; the pairs that are inserted are moved from
+		 * @param configure Optional function to configure each new cache entry
+		 * @return Insertion mask, false at the position of every key already cached
+		 */
+		template <CacheEntryConfigurator TConfigure = std::nullptr_t>
+		inline std::vector<bool> insertMany( std::span<std::pair<TKey, TValue>> entries, TConfigure&& configure = nullptr );
+
+		//----------------------------------------------
+		// Modification operations
+		//----------------------------------------------
+
+		/**
+		 * @brief Remove an entry from the cache
+		 * @param key The cache key to remove
+		 * @return True if entry was removed, false if not found
+		 */
+		inline bool remove( const TKey& key );
+
+		/**
+		 * @brief Remove an entry by a key-like value without constructing a key
+		 * @tparam TLookup Heterogeneous key type accepted by the transparent hash and equality
+		 * @param key Value equivalent to the cache key
+		 * @return True if entry was removed, false if not found
+		 */
+		template <typename TLookup>
+			requires TransparentLookup<TLookup, TKey, THash, TKeyEqual>
+		inline bool remove( const TLookup& key );
+
+		/**
+		 * @brief Clear all entries in every shard
+		 */
+		inline void clear();
+
+		/**
+		 * @brief Get current cache size
+		 * @return Number of entries across all shards
+		 * @note Shards are visited one at a time, so the total is not an atomic snapshot
+		 */
+		inline std::size_t size() const;
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the total weight of all cached entries
+		 * @return Sum of entry weights across all shards, bounded by maxWeight as described above
+		 */
+		inline std::size_t totalWeight() const;
+
+		/**
+		 * @brief Check if cache is empty
+		 * @return True if no shard contains any entry
+		 */
+		inline bool isEmpty() const;
+
+		/**
+		 * @brief Manually trigger cleanup of expired entries in every shard
+		 */
+		inline void cleanupExpired();
+
+		/**
+		 * @brief Get the statistics summed over all shards
+		 * @return Aggregate statistics, all zero when statistics are disabled
+		 */
+		inline LruCacheStatisticsSnapshot stats() const noexcept;
+
+		//----------------------------------------------
+		// Removal notification
+		//----------------------------------------------
+
+		/**
+		 * @brief Set the function notified when entries leave any shard
+		 * @param listener Listener receiving key, moved-out value and cause (nullptr to disable)
+		 * @details Shared by all shards, so it may be invoked concurrently from different shards
+		 */
+		inline void setRemovalListener( RemovalListener listener );
+
+		/**
+		 * @brief Get the number of shards
+		 * @return Shard count (always a power of two)
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t shardCount() const noexcept;
+
+	private:
+		//----------------------------------------------
+		// Internal data structures
+		//----------------------------------------------
+
+		/** @brief Shard storage padded to its own cache lines to avoid false sharing between mutexes */
+		struct alignas( 64 ) PaddedShard
+		{
+			/** @brief The shard cache */
+			Shard cache;
+
+			/** @brief Construct shard with its share of the options and its allocator */
+			PaddedShard( const LruCacheOptions& options, const WeigherFunction& weigher, const ReloadFunction& reload, const TAllocator& allocator );
+		};
+
+		/** @brief Sum of the shard weights, updated by the shards under their own locks */
+		std::atomic<std::size_t> m_totalWeight{ 0 };
+
+		/** @brief Weight limit of the whole cache (0 = unlimited) */
+		std::size_t m_maxWeight{ 0 };
+
+		/** @brief Shard the next over-weight eviction starts from */
+		std::atomic<std::size_t> m_evictionCursor{ 0 };
+
+		std::vector<std::unique_ptr<PaddedShard>> m_shards;
+
+		/** @brief Bit mask selecting a shard from the rotated mixed hash (shard count - 1) */
+		std::size_t m_shardMask;
+
+		/** @brief Number of top mixed hash bits selecting a shard (log2 of the shard count) */
+		int m_shardBits;
+
+		//----------------------------------------------
+		// Shard selection
+		//----------------------------------------------
+
+		/**
+		 * @brief Select the shard owning a key
+		 * @param key The cache key or an equivalent heterogeneous value
+		 * @return Reference to the owning shard
+		 */
+		template <typename TLookup>
+		inline Shard& shardFor( const TLookup& key ) const noexcept;
+
+		/**
+		 * @brief Select the index of the shard owning a key
+		 * @param key The cache key or an equivalent heterogeneous value
+		 * @return Position of the owning shard in m_shards
+		 */
+		template <typename TLookup>
+		inline std::size_t shardIndex( const TLookup& key ) const noexcept;
+
+		/**
+		 * @brief Split a batch by owning shard
+		 * @param count Number of keys in the batch
+		 * @param keyAt Callable returning the key at a position of the batch
+		 * @param visit Callable invoked once per shard involved, with the shard and the positions it owns
+		 */
+		template <typename TKeyAt, typename TVisit>
+		inline void forEachShardBatch( std::size_t count, const TKeyAt& keyAt, const TVisit& visit );
+
+		//----------------------------------------------
+		// Weight limit
+		//----------------------------------------------
+
+		/**
+		 * @brief Evict from the shards while the total weight exceeds the weight limit
+		 * @param origin Shard left untouched so that a reference just returned from it stays
+		 *               valid, or the shard count to evict from every shard
+		 * @details Shards only bound their own share of the limit, which an entry heavier than
+		 *          the share exceeds by being admitted alone
+		 */
+		inline void enforceMaxWeight( std::size_t origin );
+
+		/**
+		 * @brief Finalize a hash so that its top bits select the shard and its low bits drive the shards' own probing
+		 * @param hash Raw hash value (identity hashes for integers are common)
+		 * @return Well-mixed hash value
+		 */
+		static constexpr std::uint64_t mixHash( std::uint64_t hash ) noexcept;
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/ShardedLruCache.inl"
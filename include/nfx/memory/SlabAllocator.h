@@ -0,0 +1,305 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file SlabAllocator.h
+ * @brief Fixed-size slab allocator recycling freed cache nodes
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined( __linux__ )
+#	include <sys/mman.h>
+#endif
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// SlabArena class
+	//=====================================================================
+
+	/**
+	 * @brief Arena carving fixed-size blocks out of large slabs
+	 * @details Each distinct block size gets a pool with an intrusive free list. A freed
+	 *          block is pushed on its pool's free list and handed out by the next allocation
+	 *          of that size, so a cache evicting one node per insertion reuses the same memory
+	 *          instead of going through malloc and free. Slabs are only returned to the system
+	 *          when the arena is destroyed.
+	 *
+	 *          The arena is not synchronized. It must only be used under one lock, which is
+	 *          the case for the allocators of a single LruCache.
+	 */
+	class SlabArena final
+	{
+	public:
+		//----------------------------------------------
+		// Constants
+		//----------------------------------------------
+
+		/** @brief Default slab size */
+		static constexpr std::size_t DEFAULT_SLAB_SIZE = std::size_t{ 256 } * 1024;
+
+		/** @brief Transparent huge page size slabs are rounded to when huge pages are requested */
+		static constexpr std::size_t HUGE_PAGE_SIZE = std::size_t{ 2 } * 1024 * 1024;
+
+		/** @brief Alignment of every slab, and the largest block alignment served from slabs */
+		static constexpr std::size_t SLAB_ALIGNMENT = 4096;
+
+		//----------------------------------------------
+		// Pool
+		//----------------------------------------------
+
+		/** @brief Free list and bump region for blocks of one size */
+		struct Pool
+		{
+			/** @brief Size of every block, a multiple of its alignment and at least a pointer */
+			std::size_t blockSize;
+
+			/** @brief Alignment requested for the blocks */
+			std::size_t alignment;
+
+			/** @brief Most recently freed block, each free block stores the next one */
+			void* freeList{ nullptr };
+
+			/** @brief Next never used block of the current slab */
+			std::byte* cursor{ nullptr };
+
+			/** @brief End of the current slab */
+			std::byte* end{ nullptr };
+		};
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct an empty arena
+		 * @param slabSize Bytes requested from the system at a time
+		 * @param hugePages True to round slabs to 2 MiB, align them on 2 MiB and advise the
+		 *                  kernel to back them with transparent huge pages (Linux only)
+		 */
+		inline explicit SlabArena( std::size_t slabSize = DEFAULT_SLAB_SIZE, bool hugePages = false );
+
+		//----------------------------------------------
+		// Copy and move operations
+		//----------------------------------------------
+
+		SlabArena( const SlabArena& ) = delete;
+		SlabArena( SlabArena&& ) = delete;
+
+		//----------------------------------------------
+		// Assignment operations
+		//----------------------------------------------
+
+		SlabArena& operator=( const SlabArena& ) = delete;
+		SlabArena& operator=( SlabArena&& ) = delete;
+
+		//----------------------------------------------
+		// Destruction
+		//----------------------------------------------
+
+		/** @brief Release every slab */
+		inline ~SlabArena();
+
+		//----------------------------------------------
+		// Pools
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the pool serving blocks of a size, creating it on first use
+		 * @param size Block size
+		 * @param alignment Block alignment
+		 * @return Pool, or nullptr if blocks of this size are not served from slabs
+		 */
+		inline Pool* pool( std::size_t size, std::size_t alignment );
+
+		/**
+		 * @brief Get the pool serving blocks of a size if it exists
+		 * @param size Block size
+		 * @param alignment Block alignment
+		 * @return Pool, or nullptr if no block of this size was allocated from slabs
+		 */
+		[[nodiscard]] inline Pool* findPool( std::size_t size, std::size_t alignment ) const noexcept;
+
+		/**
+		 * @brief Take a block from a pool
+		 * @param pool Pool of this arena
+		 * @return Uninitialized block of pool.blockSize bytes
+		 */
+		inline void* allocate( Pool& pool );
+
+		/**
+		 * @brief Return a block to its pool for reuse
+		 * @param pool Pool the block was allocated from
+		 * @param block Block to recycle
+		 */
+		inline void deallocate( Pool& pool, void* block ) noexcept;
+
+		//----------------------------------------------
+		// State inspection
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the number of slabs obtained from the system
+		 * @return Slab count
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t slabCount() const noexcept;
+
+		/**
+		 * @brief Get the size of every slab
+		 * @return Slab size in bytes
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline std::size_t slabSize() const noexcept;
+
+	private:
+		/**
+		 * @brief Compute the block layout serving objects of a size
+		 * @param size Object size
+		 * @param alignment Object alignment
+		 * @return Block size and alignment, block size 0 if not served from slabs
+		 */
+		[[nodiscard]] inline std::pair<std::size_t, std::size_t> blockLayout( std::size_t size, std::size_t alignment ) const noexcept;
+
+		std::size_t m_slabSize;
+		std::size_t m_slabAlignment;
+		bool m_hugePages;
+
+		std::vector<std::unique_ptr<Pool>> m_pools;
+		std::vector<std::byte*> m_slabs;
+	};
+
+	//=====================================================================
+	// SlabAllocator class
+	//=====================================================================
+
+	/**
+	 * @brief Standard allocator serving single objects from a shared SlabArena
+	 * @tparam T Allocated type
+	 * @details Single-object allocations, such as the nodes of std::unordered_map or the entry
+	 *          chunks of FlatHashMap, come from the arena pool of sizeof( T ). Array allocations
+	 *          such as bucket tables, probe tables and the entry block FlatHashMap reserves for
+	 *          a size-bounded cache go to the global operator new. Copies and rebound copies
+	 *          share the arena and compare equal.
+	 *
+	 *          A default-constructed allocator owns a fresh arena, so every LruCache shard of a
+	 *          ShardedLruCache gets its own and arenas are never shared across locks.
+	 */
+	template <typename T>
+	class SlabAllocator
+	{
+	public:
+		//----------------------------------------------
+		// Type aliases
+		//----------------------------------------------
+
+		using value_type = T;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		using is_always_equal = std::false_type;
+
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/** @brief Construct an allocator owning a new arena with default settings */
+		inline SlabAllocator();
+
+		/**
+		 * @brief Construct an allocator using an existing arena
+		 * @param arena Arena shared with other allocators used under the same lock
+		 */
+		inline explicit SlabAllocator( std::shared_ptr<SlabArena> arena );
+
+		/**
+		 * @brief Construct an allocator for another type sharing the same arena
+		 * @param other Allocator to rebind
+		 */
+		template <typename U>
+		inline SlabAllocator( const SlabAllocator<U>& other ) noexcept;
+
+		/** @brief Copy an allocator, sharing its arena */
+		SlabAllocator( const SlabAllocator& other ) noexcept = default;
+
+		//----------------------------------------------
+		// Allocation
+		//----------------------------------------------
+
+		/**
+		 * @brief Allocate storage for objects
+		 * @param count Number of objects
+		 * @return Uninitialized storage
+		 */
+		[[nodiscard]] inline T* allocate( std::size_t count );
+
+		/**
+		 * @brief Release storage obtained from allocate()
+		 * @param pointer Storage to release
+		 * @param count Number of objects passed to allocate()
+		 */
+		inline void deallocate( T* pointer, std::size_t count ) noexcept;
+
+		//----------------------------------------------
+		// Accessors
+		//----------------------------------------------
+
+		/**
+		 * @brief Get the arena
+		 * @return Shared arena
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline const std::shared_ptr<SlabArena>& arena() const noexcept;
+
+		//----------------------------------------------
+		// Comparison
+		//----------------------------------------------
+
+		/**
+		 * @brief Check whether two allocators can free each other's storage
+		 * @return True if both use the same arena
+		 */
+		template <typename U>
+		inline bool operator==( const SlabAllocator<U>& other ) const noexcept;
+
+	private:
+		template <typename U>
+		friend class SlabAllocator;
+
+		std::shared_ptr<SlabArena> m_arena;
+
+		/** @brief Pool of sizeof( T ) blocks, resolved on first single-object allocation */
+		SlabArena::Pool* m_pool{ nullptr };
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/SlabAllocator.inl"
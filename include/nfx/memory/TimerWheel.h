@@ -0,0 +1,204 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 nfx
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerWheel.h
+ * @brief Hierarchical timing wheel indexing intrusive entries by expiry deadline
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace nfx::memory
+{
+	//=====================================================================
+	// TimerWheel class
+	//=====================================================================
+
+	/**
+	 * @brief Hierarchical timing wheel over intrusively linked entries
+	 * @details Four levels of 64 buckets each, spanning about 17 ms, 1 s, 69 s and 73 min per
+	 *          bucket, plus an overflow bucket for deadlines more than about 3 days ahead. An
+	 *          entry is filed at the finest level whose range covers its deadline, so advancing
+	 *          the wheel visits only the buckets whose time has come: entries from coarse levels
+	 *          are handed back to be re-filed closer to their deadline, entries from the finest
+	 *          level are due. Scheduling and descheduling are O(1). An advance can be given a
+	 *          budget of entries to visit; it then stops part way and the next advance resumes
+	 *          from the same bucket.
+	 * @tparam TEntry Entry type with `TEntry* timerNext` and `TEntry** timerPrevNext` members,
+	 *                both null while the entry is not scheduled
+	 */
+	template <typename TEntry>
+	class TimerWheel final
+	{
+	public:
+		//----------------------------------------------
+		// Construction
+		//----------------------------------------------
+
+		/**
+		 * @brief Construct an empty wheel
+		 * @param now Current time, deadlines are filed relative to it
+		 */
+		inline explicit TimerWheel( std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now() ) noexcept;
+
+		//----------------------------------------------
+		// Scheduling
+		//----------------------------------------------
+
+		/**
+		 * @brief File an entry under its deadline, moving it if it is already scheduled
+		 * @param entry Entry to schedule
+		 * @param deadline Time the entry expires; past deadlines are due on the next advance()
+		 */
+		inline void schedule( TEntry* entry, std::chrono::steady_clock::time_point deadline ) noexcept;
+
+		/**
+		 * @brief Remove an entry from the wheel, if it is scheduled
+		 * @param entry Entry to remove
+		 */
+		inline void deschedule( TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Forget all entries without touching them
+		 * @details Their links are left as they were, for entries about to be destroyed
+		 */
+		inline void clear() noexcept;
+
+		//----------------------------------------------
+		// Expiration
+		//----------------------------------------------
+
+		/**
+		 * @brief Move the wheel to a new time and hand over the entries whose buckets elapsed
+		 * @tparam TOnDue Callable invoked with TEntry*
+		 * @param now Current time
+		 * @param onDue Called with each entry of an elapsed bucket, already descheduled; it must
+		 *              either remove the entry or schedule() it again under its actual deadline.
+		 *              The bucket holding the current time is always visited, so every entry whose
+		 *              deadline has passed is handed over.
+		 * @param budget Maximum number of entries to hand over
+		 * @return True if the wheel caught up with now, false if the budget ran out first
+		 * @details An advance interrupted by its budget is finished by the next call before
+		 *          that call's own time is processed.
+		 */
+		template <typename TOnDue>
+		inline bool advance( std::chrono::steady_clock::time_point now, TOnDue&& onDue, std::size_t budget = SIZE_MAX );
+
+		/**
+		 * @brief Check whether an advance was interrupted by its budget
+		 * @return True if the next advance resumes an unfinished one
+		 * @note This function is marked [[nodiscard]] - the return value should not be ignored
+		 */
+		[[nodiscard]] inline bool isAdvancing() const noexcept;
+
+	private:
+		/** @brief Number of levels, excluding the overflow bucket */
+		static constexpr std::size_t LEVELS = 4;
+
+		/** @brief log2 of the number of buckets per level */
+		static constexpr std::size_t BUCKET_BITS = 6;
+
+		/** @brief Number of buckets per level */
+		static constexpr std::size_t BUCKETS = std::size_t{ 1 } << BUCKET_BITS;
+
+		/** @brief log2 of the finest bucket span in nanoseconds (about 16.8 ms) */
+		static constexpr std::size_t BASE_SHIFT = 24;
+
+		/**
+		 * @brief Get the log2 of the bucket span of a level, in nanoseconds
+		 * @param level Wheel level
+		 * @return Shift converting nanoseconds to ticks of that level
+		 */
+		[[nodiscard]] static constexpr std::size_t shift( std::size_t level ) noexcept;
+
+		/**
+		 * @brief Convert a time point to nanoseconds since the clock epoch
+		 * @param time Time point
+		 * @return Nanoseconds, never negative
+		 */
+		[[nodiscard]] static inline std::int64_t toNanoseconds( std::chrono::steady_clock::time_point time ) noexcept;
+
+		/**
+		 * @brief Find the bucket an entry with the given deadline belongs in
+		 * @param deadline Deadline in nanoseconds
+		 * @return Head pointer of the bucket list
+		 */
+		[[nodiscard]] inline TEntry*& bucketFor( std::int64_t deadline ) noexcept;
+
+		/**
+		 * @brief Step the sweep cursor to the next bucket of the advance in progress
+		 * @return Head pointer of the bucket, null once the advance is complete
+		 */
+		[[nodiscard]] inline TEntry** nextBucket() noexcept;
+
+		/**
+		 * @brief Link an entry at the head of a bucket list
+		 * @param bucket Head pointer of the bucket list
+		 * @param entry Unscheduled entry
+		 */
+		static inline void link( TEntry*& bucket, TEntry* entry ) noexcept;
+
+		/**
+		 * @brief Unlink an entry from whichever list holds it
+		 * @param entry Scheduled entry
+		 */
+		static inline void unlink( TEntry* entry ) noexcept;
+
+		/** @brief Bucket list heads per level */
+		std::array<std::array<TEntry*, BUCKETS>, LEVELS> m_buckets{};
+
+		/** @brief Entries beyond the range of the coarsest level */
+		TEntry* m_overflow{ nullptr };
+
+		/** @brief Time of the last advance, in nanoseconds */
+		std::int64_t m_time;
+
+		/** @brief Sweep cursor of the advance in progress */
+		struct Sweep
+		{
+			/** @brief Time the advance started from, in nanoseconds */
+			std::int64_t from{ 0 };
+
+			/** @brief Level being swept, LEVELS for the overflow bucket, LEVELS + 1 when done */
+			std::size_t level{ LEVELS + 1 };
+
+			/** @brief Number of buckets of the level already detached */
+			std::int64_t offset{ 0 };
+
+			/** @brief Entries detached from the current bucket and not yet handed over */
+			TEntry* pending{ nullptr };
+		};
+
+		Sweep m_sweep;
+	};
+} // namespace nfx::memory
+
+#include "nfx/detail/memory/TimerWheel.inl"
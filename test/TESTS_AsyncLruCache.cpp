@@ -0,0 +1,221 @@
+/**
+ * @file TESTS_AsyncLruCache.cpp
+ * @brief Tests for the AsyncLruCache shared future cache
+ * @details Tests covering executor submission, future sharing across concurrent misses,
+ *          ready hits, failed factories, tasks outliving the cache and rejected options
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nfx/memory/AsyncLruCache.h>
+
+namespace nfx::memory::test
+{
+	//=====================================================================
+	// AsyncLruCache Tests
+	//=====================================================================
+
+	/** @brief Executor queueing tasks until the test runs them */
+	class ManualExecutor
+	{
+	public:
+		void submit( std::function<void()> task )
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			m_tasks.push_back( std::move( task ) );
+		}
+
+		std::size_t runAll()
+		{
+			std::vector<std::function<void()>> tasks;
+			{
+				std::lock_guard<std::mutex> lock{ m_mutex };
+				tasks.swap( m_tasks );
+			}
+
+			for ( auto& task : tasks )
+			{
+				task();
+			}
+
+			return tasks.size();
+		}
+
+		AsyncLruCache<int, std::string>::Executor executor()
+		{
+			return [this]( std::function<void()> task ) { submit( std::move( task ) ); };
+		}
+
+	private:
+		std::mutex m_mutex;
+		std::vector<std::function<void()>> m_tasks;
+	};
+
+	//----------------------------------------------
+	// Loading
+	//----------------------------------------------
+
+	TEST( AsyncLruCacheLoading, FactoryRunsOnExecutor )
+	{
+		ManualExecutor executor;
+		AsyncLruCache<int, std::string> cache{ LruCacheOptions{}.withStatistics( true ), executor.executor() };
+
+		int factoryCalls{ 0 };
+		auto factory = [&factoryCalls]() {
+			++factoryCalls;
+			return std::string{ "value" };
+		};
+
+		auto first{ cache.getOrCreateAsync( 1, factory ) };
+		auto second{ cache.getOrCreateAsync( 1, factory ) };
+		EXPECT_EQ( factoryCalls, 0 );
+		EXPECT_EQ( first.wait_for( std::chrono::seconds{ 0 } ), std::future_status::timeout );
+		EXPECT_EQ( cache.size(), 1 );
+
+		EXPECT_EQ( executor.runAll(), 1 );
+		EXPECT_EQ( factoryCalls, 1 );
+		EXPECT_EQ( first.get(), "value" );
+		EXPECT_EQ( second.get(), "value" );
+
+		// Completed futures stay cached and are handed out ready
+		auto hit{ cache.getOrCreateAsync( 1, factory ) };
+		EXPECT_EQ( hit.wait_for( std::chrono::seconds{ 0 } ), std::future_status::ready );
+		EXPECT_EQ( &hit.get(), &first.get() );
+		EXPECT_EQ( executor.runAll(), 0 );
+
+		ASSERT_TRUE( cache.tryGet( 1 ).has_value() );
+		EXPECT_FALSE( cache.tryGet( 2 ).has_value() );
+		EXPECT_EQ( cache.stats().hitCount, 3 );
+	}
+
+	TEST( AsyncLruCacheLoading, ConcurrentMissesShareOneFuture )
+	{
+		ManualExecutor executor;
+		AsyncLruCache<int, std::string> cache{ LruCacheOptions{}, executor.executor() };
+
+		std::atomic<int> factoryCalls{ 0 };
+		std::vector<std::shared_future<std::string>> futures( 8 );
+		std::vector<std::thread> callers;
+		for ( std::size_t t = 0; t < futures.size(); ++t )
+		{
+			callers.emplace_back( [&cache, &factoryCalls, &futures, t]() {
+				futures[t] = cache.getOrCreateAsync( 7, [&factoryCalls]() {
+					++factoryCalls;
+					return std::string{ "shared" };
+				} );
+			} );
+		}
+		for ( auto& caller : callers )
+		{
+			caller.join();
+		}
+
+		EXPECT_EQ( executor.runAll(), 1 );
+		EXPECT_EQ( factoryCalls.load(), 1 );
+		for ( const auto& future : futures )
+		{
+			EXPECT_EQ( &future.get(), &futures[0].get() );
+		}
+	}
+
+	TEST( AsyncLruCacheLoading, HitsRaceEviction )
+	{
+		// Runs factories inline, so every future is ready when it is cached
+		AsyncLruCache<int, std::string> cache{ LruCacheOptions{ 2 }, []( std::function<void()> task ) { task(); } };
+
+		std::atomic<bool> failed{ false };
+		std::vector<std::thread> threads;
+		for ( int t = 0; t < 8; ++t )
+		{
+			threads.emplace_back( [&cache, &failed, t]() {
+				for ( int i = 0; i < 2000; ++i )
+				{
+					// Each key evicts another one, while other threads copy the futures out
+					const int key{ ( i + t ) % 5 };
+					auto future{ cache.getOrCreateAsync( key, [key]() { return std::to_string( key ); } ) };
+					if ( future.get() != std::to_string( key ) )
+					{
+						failed = true;
+					}
+
+					if ( auto hit{ cache.tryGet( ( key + 1 ) % 5 ) }; hit && hit->get() != std::to_string( ( key + 1 ) % 5 ) )
+					{
+						failed = true;
+					}
+				}
+			} );
+		}
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_FALSE( failed.load() );
+		EXPECT_LE( cache.size(), 2 );
+	}
+
+	//----------------------------------------------
+	// Failures
+	//----------------------------------------------
+
+	TEST( AsyncLruCacheFailures, FailedFactoryIsRetried )
+	{
+		ManualExecutor executor;
+		AsyncLruCache<int, std::string> cache{ LruCacheOptions{}, executor.executor() };
+
+		auto failed{ cache.getOrCreateAsync( 1, []() -> std::string { throw std::runtime_error{ "backend down" }; } ) };
+		executor.runAll();
+
+		EXPECT_THROW( failed.get(), std::runtime_error );
+		EXPECT_EQ( cache.size(), 0 );
+
+		auto retried{ cache.getOrCreateAsync( 1, []() { return std::string{ "recovered" }; } ) };
+		executor.runAll();
+		EXPECT_EQ( retried.get(), "recovered" );
+	}
+
+	TEST( AsyncLruCacheFailures, ExecutorExceptionFailsFuture )
+	{
+		AsyncLruCache<int, std::string> cache{ LruCacheOptions{}, []( std::function<void()> ) { throw std::runtime_error{ "queue full" }; } };
+
+		EXPECT_THROW( static_cast<void>( cache.getOrCreateAsync( 1, []() { return std::string{ "value" }; } ) ), std::runtime_error );
+		EXPECT_EQ( cache.size(), 0 );
+
+		EXPECT_THROW( ( AsyncLruCache<int, std::string>{ LruCacheOptions{}, nullptr } ), std::invalid_argument );
+	}
+
+	TEST( AsyncLruCacheFailures, RejectsRefreshAfterWrite )
+	{
+		using Cache = AsyncLruCache<int, std::string>;
+
+		// Cached futures have no reload, getOrCreateAsync() factories are per call
+		LruCacheOptions options;
+		options.withRefreshAfterWrite( std::chrono::seconds( 1 ), []( std::function<void()> task ) { task(); } );
+
+		EXPECT_THROW( ( Cache{ options, []( std::function<void()> task ) { task(); } } ), std::invalid_argument );
+	}
+
+	TEST( AsyncLruCacheFailures, TasksOutliveCache )
+	{
+		ManualExecutor executor;
+		std::shared_future<std::string> future;
+		{
+			AsyncLruCache<int, std::string> cache{ LruCacheOptions{}, executor.executor() };
+			future = cache.getOrCreateAsync( 1, []() -> std::string { throw std::runtime_error{ "late failure" }; } );
+		}
+
+		// The failing task finds its cache gone and only completes the future
+		EXPECT_EQ( executor.runAll(), 1 );
+		EXPECT_THROW( future.get(), std::runtime_error );
+	}
+} // namespace nfx::memory::test
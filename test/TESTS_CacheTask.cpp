@@ -0,0 +1,233 @@
+/**
+ * @file TESTS_CacheTask.cpp
+ * @brief Tests for CacheTask and coroutine lookups through LruCache::getOrLoad()
+ * @details Tests covering task results and exceptions, hits without suspension, concurrent
+ *          coroutine misses sharing one load and failed loads reaching every waiter
+ */
+
+#include <gtest/gtest.h>
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <nfx/memory/CacheTask.h>
+#include <nfx/memory/LruCache.h>
+
+namespace nfx::memory::test
+{
+	//=====================================================================
+	// CacheTask Tests
+	//=====================================================================
+
+	/** @brief Coroutine started eagerly and never awaited, used to drive the tests */
+	struct Detached
+	{
+		struct promise_type
+		{
+			Detached get_return_object() noexcept { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept { std::terminate(); }
+		};
+	};
+
+	/** @brief Event suspending one coroutine until the test sets it */
+	class ManualEvent
+	{
+	public:
+		bool await_ready() const noexcept { return m_set; }
+		void await_suspend( std::coroutine_handle<> awaiting ) noexcept { m_waiter = awaiting; }
+		void await_resume() const noexcept {}
+
+		void set()
+		{
+			m_set = true;
+			if ( auto waiter{ std::exchange( m_waiter, nullptr ) } )
+			{
+				waiter.resume();
+			}
+		}
+
+	private:
+		bool m_set{ false };
+		std::coroutine_handle<> m_waiter;
+	};
+
+	/** @brief What a driving coroutine observed */
+	struct Outcome
+	{
+		bool done{ false };
+		std::string value;
+		std::string error;
+		std::thread::id thread;
+	};
+
+	using Cache = LruCache<int, std::string>;
+
+	CacheTask<std::string> loadAfter( ManualEvent& event, int& calls, bool fail )
+	{
+		++calls;
+		co_await event;
+
+		if ( fail )
+		{
+			throw std::runtime_error{ "load failed" };
+		}
+
+		co_return "loaded";
+	}
+
+	Detached awaitValue( Cache& cache, int key, std::function<CacheTask<std::string>()> loader, Outcome& outcome )
+	{
+		try
+		{
+			outcome.value = co_await cache.getOrLoad( key, std::move( loader ) );
+		}
+		catch ( const std::exception& e )
+		{
+			outcome.error = e.what();
+		}
+
+		outcome.thread = std::this_thread::get_id();
+		outcome.done = true;
+	}
+
+	//----------------------------------------------
+	// Task
+	//----------------------------------------------
+
+	CacheTask<int> answer()
+	{
+		co_return 42;
+	}
+
+	CacheTask<int> failing()
+	{
+		throw std::runtime_error{ "task failed" };
+		co_return 0;
+	}
+
+	Detached sumTasks( Outcome& outcome )
+	{
+		const int value{ co_await answer() };
+		outcome.value = std::to_string( value );
+
+		try
+		{
+			static_cast<void>( co_await failing() );
+		}
+		catch ( const std::exception& e )
+		{
+			outcome.error = e.what();
+		}
+
+		outcome.done = true;
+	}
+
+	TEST( CacheTask, ResultAndExceptionReachAwaiter )
+	{
+		Outcome outcome;
+		sumTasks( outcome );
+
+		EXPECT_TRUE( outcome.done );
+		EXPECT_EQ( outcome.value, "42" );
+		EXPECT_EQ( outcome.error, "task failed" );
+	}
+
+	//----------------------------------------------
+	// Coroutine lookups
+	//----------------------------------------------
+
+	TEST( LruCacheCoroutine, HitCompletesWithoutSuspension )
+	{
+		Cache cache{ LruCacheOptions{}.withStatistics( true ) };
+		cache.getOrCreate( 1, []() { return std::string{ "cached" }; } );
+
+		ManualEvent never;
+		int calls{ 0 };
+		Outcome outcome;
+		awaitValue( cache, 1, [&]() { return loadAfter( never, calls, false ); }, outcome );
+
+		EXPECT_TRUE( outcome.done );
+		EXPECT_EQ( outcome.value, "cached" );
+		EXPECT_EQ( calls, 0 );
+		EXPECT_EQ( cache.stats().hitCount, 1 );
+	}
+
+	TEST( LruCacheCoroutine, ConcurrentMissesShareOneLoad )
+	{
+		Cache cache{ LruCacheOptions{}.withStatistics( true ) };
+
+		ManualEvent loaded;
+		int calls{ 0 };
+		auto loader = [&]() { return loadAfter( loaded, calls, false ); };
+
+		Outcome outcomes[3];
+		for ( auto& outcome : outcomes )
+		{
+			awaitValue( cache, 1, loader, outcome );
+		}
+
+		// Every coroutine is suspended, none holds a thread
+		EXPECT_EQ( calls, 1 );
+		for ( const auto& outcome : outcomes )
+		{
+			EXPECT_FALSE( outcome.done );
+		}
+
+		// Waiters run on the thread completing the load
+		std::thread::id loaderThread;
+		std::thread completer{ [&]() {
+			loaderThread = std::this_thread::get_id();
+			loaded.set();
+		} };
+		completer.join();
+
+		for ( const auto& outcome : outcomes )
+		{
+			EXPECT_TRUE( outcome.done );
+			EXPECT_EQ( outcome.value, "loaded" );
+			EXPECT_EQ( outcome.thread, loaderThread );
+		}
+
+		EXPECT_EQ( calls, 1 );
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_EQ( cache.stats().missCount, 1 );
+		EXPECT_EQ( cache.stats().loadSuccessCount, 1 );
+	}
+
+	TEST( LruCacheCoroutine, FailedLoadReachesEveryWaiter )
+	{
+		Cache cache;
+
+		ManualEvent failed;
+		int calls{ 0 };
+		auto loader = [&]() { return loadAfter( failed, calls, true ); };
+
+		Outcome first;
+		Outcome second;
+		awaitValue( cache, 1, loader, first );
+		awaitValue( cache, 1, loader, second );
+		failed.set();
+
+		EXPECT_EQ( first.error, "load failed" );
+		EXPECT_EQ( second.error, "load failed" );
+		EXPECT_EQ( calls, 1 );
+		EXPECT_EQ( cache.size(), 0 );
+
+		// Nothing was cached, the next lookup loads again
+		ManualEvent retried;
+		Outcome third;
+		awaitValue( cache, 1, [&]() { return loadAfter( retried, calls, false ); }, third );
+		retried.set();
+
+		EXPECT_EQ( third.value, "loaded" );
+		EXPECT_EQ( calls, 2 );
+	}
+} // namespace nfx::memory::test
@@ -0,0 +1,101 @@
+/**
+ * @file TESTS_CoarseClock.cpp
+ * @brief Tests for the CoarseClock cached time source
+ * @details Tests covering background refresh, explicit update, shared instances per
+ *          resolution and expiration in caches configured with a clock resolution
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <nfx/memory/CoarseClock.h>
+#include <nfx/memory/CompactLruCache.h>
+#include <nfx/memory/LruCache.h>
+
+namespace nfx::memory::test
+{
+	using namespace std::chrono_literals;
+
+	//=====================================================================
+	// CoarseClock Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Time
+	//----------------------------------------------
+
+	TEST( CoarseClock, ReadingTracksSteadyClock )
+	{
+		CoarseClock clock{ 5ms };
+
+		const auto before{ clock.now() };
+		EXPECT_LE( before, std::chrono::steady_clock::now() );
+
+		std::this_thread::sleep_for( 50ms );
+
+		// Refreshed in the background without any call to update()
+		EXPECT_GT( clock.now(), before );
+		EXPECT_LE( clock.now(), std::chrono::steady_clock::now() );
+	}
+
+	TEST( CoarseClock, UpdateRefreshesImmediately )
+	{
+		CoarseClock clock{ 1h };
+
+		const auto before{ clock.now() };
+		std::this_thread::sleep_for( 5ms );
+		EXPECT_EQ( clock.now(), before );
+
+		clock.update();
+		EXPECT_GE( clock.now() - before, 5ms );
+	}
+
+	TEST( CoarseClock, SharedPerResolution )
+	{
+		auto first{ CoarseClock::shared( 7ms ) };
+		auto second{ CoarseClock::shared( 7ms ) };
+		auto other{ CoarseClock::shared( 9ms ) };
+
+		EXPECT_EQ( first, second );
+		EXPECT_NE( first, other );
+		EXPECT_EQ( first->resolution(), 7ms );
+
+		// Released clocks are not kept alive by the registry
+		std::weak_ptr<CoarseClock> released{ other };
+		other.reset();
+		EXPECT_TRUE( released.expired() );
+	}
+
+	//----------------------------------------------
+	// Cache integration
+	//----------------------------------------------
+
+	TEST( CoarseClock, LruCacheExpiresWithCoarseClock )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ 0, 30ms }.withClockResolution( 5ms ) };
+
+		cache.getOrCreate( 1, []() { return std::string{ "one" }; } );
+		EXPECT_TRUE( cache.tryGet( 1 ).has_value() );
+
+		std::this_thread::sleep_for( 100ms );
+
+		EXPECT_FALSE( cache.tryGet( 1 ).has_value() );
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( CoarseClock, CompactLruCacheExpiresWithCoarseClock )
+	{
+		CompactLruCache<int, std::string> cache{ LruCacheOptions{ 0, 30ms }.withClockResolution( 5ms ) };
+
+		cache.getOrCreate( 1, []() { return std::string{ "one" }; } );
+		EXPECT_TRUE( cache.tryGet( 1 ).has_value() );
+
+		std::this_thread::sleep_for( 100ms );
+
+		EXPECT_FALSE( cache.tryGet( 1 ).has_value() );
+	}
+} // namespace nfx::memory::test
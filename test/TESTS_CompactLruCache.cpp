@@ -0,0 +1,296 @@
+/**
+ * @file TESTS_CompactLruCache.cpp
+ * @brief Tests for CompactLruCache compact-metadata caching
+ * @details Tests covering LRU eviction over index-linked slots, tick-based expiration,
+ *          per-entry expiration overrides, index table deletion and concurrent access
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <nfx/memory/CompactLruCache.h>
+
+namespace nfx::memory::test
+{
+	//=====================================================================
+	// CompactLruCache Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Basic operations
+	//----------------------------------------------
+
+	TEST( CompactLruCacheOperations, GetOrCreateAndTryGet )
+	{
+		CompactLruCache<std::string, int> cache;
+		EXPECT_TRUE( cache.isEmpty() );
+
+		int calls{ 0 };
+		auto& value = cache.getOrCreate( "one", [&calls]() { ++calls; return 1; } );
+		EXPECT_EQ( value, 1 );
+		EXPECT_EQ( cache.getOrCreate( "one", [&calls]() { ++calls; return 2; } ), 1 );
+		EXPECT_EQ( calls, 1 );
+
+		auto found = cache.tryGet( "one" );
+		ASSERT_TRUE( found.has_value() );
+		EXPECT_EQ( &found->get(), &value );
+		EXPECT_FALSE( cache.tryGet( "two" ).has_value() );
+
+		EXPECT_TRUE( cache.remove( "one" ) );
+		EXPECT_FALSE( cache.remove( "one" ) );
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( CompactLruCacheOperations, LruEviction )
+	{
+		CompactLruCache<int, int> cache( LruCacheOptions{ 3 } );
+
+		cache.getOrCreate( 1, []() { return 1; } );
+		cache.getOrCreate( 2, []() { return 2; } );
+		cache.getOrCreate( 3, []() { return 3; } );
+		cache.tryGet( 1 );
+		cache.getOrCreate( 4, []() { return 4; } ); // evicts 2
+
+		EXPECT_EQ( cache.size(), 3 );
+		EXPECT_TRUE( cache.tryGet( 1 ).has_value() );
+		EXPECT_FALSE( cache.tryGet( 2 ).has_value() );
+		EXPECT_TRUE( cache.tryGet( 3 ).has_value() );
+		EXPECT_TRUE( cache.tryGet( 4 ).has_value() );
+	}
+
+	TEST( CompactLruCacheOperations, ClearDestroysValuesAndStaysUsable )
+	{
+		auto tracker{ std::make_shared<int>( 0 ) };
+		{
+			CompactLruCache<int, std::shared_ptr<int>> cache;
+			for ( int i{ 0 }; i < 1000; ++i )
+			{
+				cache.getOrCreate( i, [&tracker]() { return tracker; } );
+			}
+			EXPECT_EQ( tracker.use_count(), 1001 );
+
+			cache.clear();
+			EXPECT_EQ( tracker.use_count(), 1 );
+			EXPECT_TRUE( cache.isEmpty() );
+
+			cache.getOrCreate( 7, [&tracker]() { return tracker; } );
+			EXPECT_TRUE( cache.tryGet( 7 ).has_value() );
+			EXPECT_EQ( tracker.use_count(), 2 );
+		}
+		EXPECT_EQ( tracker.use_count(), 1 );
+	}
+
+	TEST( CompactLruCacheOperations, ReferencesStableAcrossGrowth )
+	{
+		CompactLruCache<int, std::string> cache;
+
+		auto& first = cache.getOrCreate( 0, []() { return std::string{ "first" }; } );
+		for ( int i{ 1 }; i < 5000; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return std::to_string( i ); } );
+		}
+
+		EXPECT_EQ( first, "first" );
+		EXPECT_EQ( &cache.tryGet( 0 )->get(), &first );
+	}
+
+	TEST( CompactLruCacheOperations, FactoryExceptionLeavesCacheUnchanged )
+	{
+		CompactLruCache<int, int> cache;
+		cache.getOrCreate( 1, []() { return 1; } );
+
+		EXPECT_THROW( cache.getOrCreate( 2, []() -> int { throw std::runtime_error{ "load failed" }; } ), std::runtime_error );
+
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_EQ( cache.getOrCreate( 2, []() { return 2; } ), 2 );
+	}
+
+	//----------------------------------------------
+	// Expiration
+	//----------------------------------------------
+
+	TEST( CompactLruCacheExpiration, SlidingExpiration )
+	{
+		CompactLruCache<int, int> cache( LruCacheOptions{ 0, std::chrono::milliseconds{ 30 } } );
+
+		cache.getOrCreate( 1, []() { return 1; } );
+		EXPECT_TRUE( cache.tryGet( 1 ).has_value() );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds{ 60 } );
+
+		EXPECT_FALSE( cache.tryGet( 1 ).has_value() );
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( CompactLruCacheExpiration, PerEntryExpirationOverride )
+	{
+		CompactLruCache<int, int> cache( LruCacheOptions{ 0, std::chrono::milliseconds{ 30 } } );
+
+		cache.getOrCreate( 1, []() { return 1; } );
+		cache.getOrCreate(
+			2, []() { return 2; }, []( CacheEntry& entry ) { entry.slidingExpiration = std::chrono::hours{ 1 }; } );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds{ 60 } );
+		cache.cleanupExpired();
+
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_TRUE( cache.tryGet( 2 ).has_value() );
+	}
+
+	TEST( CompactLruCacheExpiration, CleanupStopsAtFirstLiveEntry )
+	{
+		CompactLruCache<int, int> cache( LruCacheOptions{ 0, std::chrono::milliseconds{ 40 } } );
+
+		for ( int i{ 0 }; i < 10; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		std::this_thread::sleep_for( std::chrono::milliseconds{ 80 } );
+		cache.getOrCreate( 100, []() { return 100; } );
+		cache.cleanupExpired();
+
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_TRUE( cache.tryGet( 100 ).has_value() );
+	}
+
+	TEST( CompactLruCacheExpiration, BackgroundCleanupVisitsBoundedSlotsPerCycle )
+	{
+		CompactLruCache<int, int> cache( LruCacheOptions{ 0, std::chrono::milliseconds{ 40 }, std::chrono::milliseconds{ 10 } } );
+
+		// Long-lived entries at the LRU tail, short-lived ones nearer the head
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; }, []( CacheEntry& entry ) { entry.slidingExpiration = std::chrono::hours{ 1 }; } );
+		}
+		for ( int i{ 100 }; i < 110; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		std::this_thread::sleep_for( std::chrono::milliseconds{ 80 } );
+
+		// One cycle visits only live tail slots instead of walking the whole list
+		cache.getOrCreate( 200, []() { return 200; } );
+		EXPECT_EQ( cache.size(), 111 );
+
+		// Later cycles resume where the previous one stopped
+		for ( int i{ 0 }; i < 40 && cache.size() > 101; ++i )
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds{ 15 } );
+			cache.getOrCreate( 200, []() { return 200; } );
+		}
+
+		EXPECT_EQ( cache.size(), 101 );
+		EXPECT_FALSE( cache.tryGet( 100 ).has_value() );
+		EXPECT_TRUE( cache.tryGet( 0 ).has_value() );
+	}
+
+	TEST( CompactLruCacheExpiration, UnfinishedCleanupResumesOnNextLookup )
+	{
+		CompactLruCache<int, int> cache( LruCacheOptions{ 0, std::chrono::milliseconds{ 20 }, std::chrono::milliseconds{ 50 } } );
+
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; }, []( CacheEntry& entry ) { entry.slidingExpiration = std::chrono::hours{ 1 }; } );
+		}
+		for ( int i{ 100 }; i < 110; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		std::this_thread::sleep_for( std::chrono::milliseconds{ 60 } );
+
+		// Only lookups, well within one interval: each continues the walk the previous one left pending
+		for ( int i{ 0 }; i < 12; ++i )
+		{
+			EXPECT_FALSE( cache.tryGet( -1 ).has_value() );
+		}
+
+		EXPECT_EQ( cache.size(), 100 );
+	}
+
+	TEST( CompactLruCacheExpiration, RejectsUnsupportedOptions )
+	{
+		using Cache = CompactLruCache<int, int>;
+
+		EXPECT_THROW( ( Cache{ LruCacheOptions{ 100 }.withAbsoluteExpiration( std::chrono::minutes( 1 ) ) } ), std::invalid_argument );
+		EXPECT_THROW( ( Cache{ LruCacheOptions{ 100 }.withMaxWeight( 1'000 ) } ), std::invalid_argument );
+		EXPECT_THROW( ( Cache{ LruCacheOptions{ 100 }.withRefreshAfterWrite( std::chrono::minutes( 1 ), []( std::function<void()> task ) { task(); } ) } ), std::invalid_argument );
+	}
+
+	//----------------------------------------------
+	// Index table
+	//----------------------------------------------
+
+	TEST( CompactLruCacheIndex, MatchesUnorderedMapUnderRandomOperations )
+	{
+		// A small key space and a size limit exercise backward-shift deletion and slot reuse
+		CompactLruCache<int, int> cache( LruCacheOptions{ 500 } );
+		std::mt19937 rng{ 4242 };
+
+		for ( int i{ 0 }; i < 50000; ++i )
+		{
+			const int key{ static_cast<int>( rng() % 2000 ) };
+			if ( rng() % 4 == 0 )
+			{
+				cache.remove( key );
+				EXPECT_FALSE( cache.tryGet( key ).has_value() );
+			}
+			else
+			{
+				EXPECT_EQ( cache.getOrCreate( key, [key]() { return key * 3; } ), key * 3 );
+			}
+			ASSERT_LE( cache.size(), 500 );
+		}
+
+		std::size_t found{ 0 };
+		for ( int key{ 0 }; key < 2000; ++key )
+		{
+			if ( auto value = cache.tryGet( key ) )
+			{
+				EXPECT_EQ( value->get(), key * 3 );
+				++found;
+			}
+		}
+		EXPECT_EQ( found, cache.size() );
+	}
+
+	//----------------------------------------------
+	// Thread safety
+	//----------------------------------------------
+
+	TEST( CompactLruCacheThreadSafety, ConcurrentAccess )
+	{
+		CompactLruCache<int, int> cache( LruCacheOptions{ 256 } );
+
+		std::vector<std::thread> threads;
+		for ( int t{ 0 }; t < 4; ++t )
+		{
+			threads.emplace_back( [&cache, t]() {
+				for ( int i{ 0 }; i < 5000; ++i )
+				{
+					const int key{ ( i % 3 == 0 ) ? 1000 + t * 5000 + i : i % 64 };
+					cache.getOrCreate( key, [key]() { return key; } );
+					cache.tryGet( i % 64 );
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_LE( cache.size(), 256 );
+	}
+} // namespace nfx::memory::test
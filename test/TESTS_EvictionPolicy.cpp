@@ -0,0 +1,402 @@
+/**
+ * @file TESTS_EvictionPolicy.cpp
+ * @brief Tests for the eviction policies and their segment and ghost bookkeeping
+ * @details Tests covering victim selection, promotion, ghost feedback and frequency
+ *          admission of the LRU, SLRU, 2Q, ARC, W-TinyLFU, CLOCK, CLOCK-Pro and S3-FIFO policies
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <nfx/memory/EvictionPolicy.h>
+
+namespace nfx::memory::test
+{
+	//=====================================================================
+	// EvictionPolicy Tests
+	//=====================================================================
+
+	/** @brief Minimal intrusively linked entry, keyed by its own hash */
+	struct TestEntry
+	{
+		TestEntry* lruPrev{ nullptr };
+		TestEntry* lruNext{ nullptr };
+		std::size_t size{ 1 };
+		std::uint8_t segment{ 0 };
+		std::uint8_t referenced{ 0 };
+		std::uint64_t key{ 0 };
+	};
+
+	constexpr auto hashOf{ []( const TestEntry* entry ) { return entry->key; } };
+
+	/** @brief Report an insertion like LruCache does */
+	template <typename TPolicy>
+	void insert( TPolicy& policy, TestEntry& entry )
+	{
+		policy.onInsert( &entry, [&entry]() { return entry.key; } );
+	}
+
+	/** @brief Report a hit like LruCache does */
+	template <typename TPolicy>
+	void access( TPolicy& policy, TestEntry& entry )
+	{
+		policy.onAccess( &entry, [&entry]() { return entry.key; } );
+	}
+
+	/** @brief Take the victim out of the policy like LruCache does */
+	template <typename TPolicy>
+	TestEntry* evict( TPolicy& policy )
+	{
+		auto* victim{ policy.victim( hashOf ) };
+		if ( victim != nullptr )
+		{
+			policy.onRemove( victim );
+		}
+
+		return victim;
+	}
+
+	/** @brief Entries keyed 0 to N - 1 */
+	template <std::size_t N>
+	std::array<TestEntry, N> makeEntries()
+	{
+		std::array<TestEntry, N> entries{};
+		for ( std::size_t i{ 0 }; i < N; ++i )
+		{
+			entries[i].key = i;
+		}
+
+		return entries;
+	}
+
+	//----------------------------------------------
+	// Bookkeeping
+	//----------------------------------------------
+
+	TEST( SegmentedList, TracksCountAndWeight )
+	{
+		auto entries{ makeEntries<3>() };
+		entries[2].size = 10;
+
+		SegmentedList<TestEntry, 2> weighted{ true };
+		for ( auto& entry : entries )
+		{
+			weighted.pushFront( &entry, 0 );
+		}
+		weighted.moveToFront( &entries[2], 1 );
+
+		EXPECT_EQ( weighted.count( 0 ), 2 );
+		EXPECT_EQ( weighted.load( 0 ), 2 );
+		EXPECT_EQ( weighted.load( 1 ), 10 );
+		EXPECT_EQ( weighted.back( 0 ), &entries[0] );
+		EXPECT_EQ( entries[2].segment, 1 );
+
+		weighted.remove( &entries[0] );
+		EXPECT_EQ( weighted.back( 0 ), &entries[1] );
+	}
+
+	TEST( GhostList, TrimsOldestAndErases )
+	{
+		GhostList ghosts{ 4 };
+		for ( std::uint64_t hash{ 0 }; hash < 10; ++hash )
+		{
+			ghosts.push( hash );
+		}
+
+		EXPECT_EQ( ghosts.trim( 4 ), 6 );
+		EXPECT_EQ( ghosts.size(), 4 );
+		EXPECT_FALSE( ghosts.erase( 5 ) );
+		EXPECT_TRUE( ghosts.erase( 6 ) );
+		EXPECT_FALSE( ghosts.erase( 6 ) );
+		EXPECT_EQ( ghosts.size(), 3 );
+	}
+
+	TEST( GhostList, RingKeepsOrderThroughCompactionAndGrowth )
+	{
+		// Fixed ring: erasures leave dead slots that compaction reclaims without losing order
+		GhostList bounded{ 8 };
+		for ( std::uint64_t hash{ 0 }; hash < 1000; ++hash )
+		{
+			bounded.push( hash );
+			if ( hash % 2 == 0 )
+			{
+				EXPECT_TRUE( bounded.erase( hash ) );
+			}
+			bounded.trim( 8 );
+		}
+
+		EXPECT_EQ( bounded.size(), 8 );
+		EXPECT_FALSE( bounded.erase( 983 ) );
+		EXPECT_EQ( bounded.trim( 7 ), 1 );
+		EXPECT_FALSE( bounded.erase( 985 ) );
+		EXPECT_TRUE( bounded.erase( 987 ) );
+
+		// Pushing a remembered hash makes it the most recent ghost
+		bounded.push( 989 );
+		EXPECT_EQ( bounded.trim( 1 ), 5 );
+		EXPECT_TRUE( bounded.erase( 989 ) );
+
+		// Without capacity the ring doubles and keeps every ghost
+		GhostList growable{ 0 };
+		for ( std::uint64_t hash{ 0 }; hash < 1000; ++hash )
+		{
+			growable.push( hash * 0x100000000ULL );
+		}
+
+		EXPECT_EQ( growable.size(), 1000 );
+		EXPECT_EQ( growable.trim( 10 ), 990 );
+		EXPECT_FALSE( growable.erase( 989 * 0x100000000ULL ) );
+		EXPECT_TRUE( growable.erase( 990 * 0x100000000ULL ) );
+		EXPECT_TRUE( growable.erase( 999 * 0x100000000ULL ) );
+		EXPECT_EQ( growable.size(), 8 );
+	}
+
+	TEST( ClockRing, HandSkipsRemovedEntries )
+	{
+		auto entries{ makeEntries<3>() };
+		ClockRing<TestEntry> ring{ false };
+		for ( auto& entry : entries )
+		{
+			ring.insert( &entry, 0 );
+		}
+
+		// New entries go behind the hand, which still points at the first one
+		EXPECT_EQ( ring.hand(), &entries[0] );
+		ring.advance();
+		EXPECT_EQ( ring.hand(), &entries[1] );
+
+		ring.remove( &entries[1] );
+		EXPECT_EQ( ring.hand(), &entries[2] );
+		EXPECT_EQ( ring.count(), 2 );
+
+		ClockRing<TestEntry>::reference( &entries[2] );
+		EXPECT_TRUE( ClockRing<TestEntry>::clearReference( &entries[2] ) );
+		EXPECT_FALSE( ClockRing<TestEntry>::clearReference( &entries[2] ) );
+
+		ring.remove( &entries[2] );
+		ring.remove( &entries[0] );
+		EXPECT_EQ( ring.hand(), nullptr );
+	}
+
+	//----------------------------------------------
+	// LRU and SLRU
+	//----------------------------------------------
+
+	TEST( LruPolicy, VictimIsLeastRecentlyUsed )
+	{
+		auto entries{ makeEntries<3>() };
+		LruPolicy<TestEntry> policy{ 3, false };
+		for ( auto& entry : entries )
+		{
+			insert( policy, entry );
+		}
+		access( policy, entries[0] );
+
+		EXPECT_EQ( policy.oldest(), &entries[1] );
+		EXPECT_EQ( evict( policy ), &entries[1] );
+		EXPECT_EQ( evict( policy ), &entries[2] );
+		EXPECT_EQ( evict( policy ), &entries[0] );
+		EXPECT_EQ( evict( policy ), nullptr );
+	}
+
+	TEST( SlruPolicy, HitPromotesAndOverflowDemotes )
+	{
+		auto entries{ makeEntries<10>() };
+		SlruPolicy<TestEntry> policy{ 10, false };
+		for ( auto& entry : entries )
+		{
+			insert( policy, entry );
+		}
+
+		// Protected holds 8, the two least recently hit go back on probation
+		for ( auto& entry : entries )
+		{
+			access( policy, entry );
+		}
+
+		EXPECT_EQ( evict( policy ), &entries[0] );
+		EXPECT_EQ( evict( policy ), &entries[1] );
+		EXPECT_EQ( evict( policy ), &entries[2] );
+	}
+
+	//----------------------------------------------
+	// 2Q
+	//----------------------------------------------
+
+	TEST( TwoQueuePolicy, GhostHitEntersMainQueue )
+	{
+		auto entries{ makeEntries<4>() };
+		TwoQueuePolicy<TestEntry> policy{ 4, false };
+		for ( auto& entry : entries )
+		{
+			insert( policy, entry );
+		}
+
+		// A1in is over its share of one entry, its oldest entry becomes a ghost
+		EXPECT_EQ( evict( policy ), &entries[0] );
+
+		TestEntry reloaded{};
+		reloaded.key = 0;
+		insert( policy, reloaded );
+
+		// A1in supplies victims down to its share, then Am does
+		EXPECT_EQ( evict( policy ), &entries[1] );
+		EXPECT_EQ( evict( policy ), &entries[2] );
+		EXPECT_EQ( evict( policy ), &reloaded );
+		EXPECT_EQ( evict( policy ), &entries[3] );
+	}
+
+	//----------------------------------------------
+	// ARC
+	//----------------------------------------------
+
+	TEST( ArcPolicy, GhostHitsAdaptRecencyTarget )
+	{
+		auto entries{ makeEntries<4>() };
+		ArcPolicy<TestEntry> policy{ 4, false };
+		for ( auto& entry : entries )
+		{
+			insert( policy, entry );
+		}
+		EXPECT_EQ( policy.recencyTarget(), 0 );
+
+		// Evicted from T1, then requested again: T1 was too small
+		EXPECT_EQ( evict( policy ), &entries[0] );
+		TestEntry reloaded{};
+		reloaded.key = 0;
+		insert( policy, reloaded );
+		EXPECT_EQ( policy.recencyTarget(), 1 );
+
+		// T1 still exceeds its target and supplies the victims
+		EXPECT_EQ( evict( policy ), &entries[1] );
+		EXPECT_EQ( evict( policy ), &entries[2] );
+		EXPECT_EQ( evict( policy ), &reloaded );
+
+		// Evicted from T2, then requested again: T2 was too small
+		TestEntry again{};
+		again.key = 0;
+		insert( policy, again );
+		EXPECT_EQ( policy.recencyTarget(), 0 );
+	}
+
+	//----------------------------------------------
+	// W-TinyLFU
+	//----------------------------------------------
+
+	TEST( WTinyLfuPolicy, FrequentCandidateReplacesVictim )
+	{
+		auto entries{ makeEntries<100>() };
+		WTinyLfuPolicy<TestEntry> policy{ 100, false };
+		for ( auto& entry : entries )
+		{
+			insert( policy, entry );
+		}
+
+		// Equally rare candidate and victim: the candidate is rejected
+		EXPECT_EQ( evict( policy ), &entries[99] );
+
+		TestEntry popular{};
+		popular.key = 500;
+		for ( int i = 0; i < 5; ++i )
+		{
+			policy.onMiss( []() { return std::uint64_t{ 500 }; } );
+		}
+		insert( policy, popular );
+
+		EXPECT_EQ( evict( policy ), &entries[0] );
+		EXPECT_EQ( popular.segment, 1 );
+	}
+
+	//----------------------------------------------
+	// CLOCK and CLOCK-Pro
+	//----------------------------------------------
+
+	TEST( ClockPolicy, ReferencedEntriesGetSecondChance )
+	{
+		auto entries{ makeEntries<4>() };
+		ClockPolicy<TestEntry> policy{ 4, false };
+		for ( auto& entry : entries )
+		{
+			insert( policy, entry );
+		}
+		access( policy, entries[0] );
+		policy.onSharedAccess( &entries[2] );
+
+		// The hand clears the bits it passes and stops at the first unreferenced entry
+		EXPECT_EQ( evict( policy ), &entries[1] );
+		EXPECT_EQ( evict( policy ), &entries[3] );
+		EXPECT_EQ( evict( policy ), &entries[0] );
+		EXPECT_EQ( evict( policy ), &entries[2] );
+		EXPECT_EQ( evict( policy ), nullptr );
+	}
+
+	TEST( ClockProPolicy, ReuseInTestPeriodMakesHot )
+	{
+		auto entries{ makeEntries<4>() };
+		ClockProPolicy<TestEntry> policy{ 4, false };
+		for ( auto& entry : entries )
+		{
+			insert( policy, entry );
+		}
+		access( policy, entries[1] );
+		EXPECT_EQ( policy.coldTarget(), 1 );
+
+		// Evicted cold during its test period, then requested again
+		EXPECT_EQ( evict( policy ), &entries[0] );
+		TestEntry reloaded{};
+		reloaded.key = 0;
+		insert( policy, reloaded );
+		EXPECT_EQ( policy.coldTarget(), 2 );
+
+		// The referenced test entry turns hot too; cold entries go first
+		EXPECT_EQ( evict( policy ), &entries[2] );
+		EXPECT_EQ( entries[1].segment, 2 );
+		EXPECT_EQ( reloaded.segment, 2 );
+		EXPECT_EQ( evict( policy ), &entries[3] );
+
+		// With no cold entry left, the hot hand demotes the unreferenced hot entries in turn
+		EXPECT_EQ( evict( policy ), &reloaded );
+		EXPECT_EQ( evict( policy ), &entries[1] );
+		EXPECT_EQ( evict( policy ), nullptr );
+	}
+
+	//----------------------------------------------
+	// S3-FIFO
+	//----------------------------------------------
+
+	TEST( S3FifoPolicy, HitsPromoteAndGhostsSkipProbation )
+	{
+		auto entries{ makeEntries<10>() };
+		S3FifoPolicy<TestEntry> policy{ 10, false };
+		for ( auto& entry : entries )
+		{
+			insert( policy, entry );
+		}
+		access( policy, entries[0] );
+		policy.onSharedAccess( &entries[0] );
+
+		// The small FIFO holds one entry's share; a hit entry moves to the main FIFO instead of leaving
+		EXPECT_EQ( evict( policy ), &entries[1] );
+		EXPECT_EQ( entries[0].segment, 1 );
+		EXPECT_EQ( entries[0].referenced, 0 );
+
+		TestEntry reloaded{};
+		reloaded.key = 1;
+		insert( policy, reloaded );
+		EXPECT_EQ( reloaded.segment, 1 );
+
+		for ( std::size_t i{ 2 }; i < 10; ++i )
+		{
+			EXPECT_EQ( evict( policy ), &entries[i] );
+		}
+
+		// The main FIFO reinserts hit entries once per counted hit
+		access( policy, reloaded );
+		EXPECT_EQ( evict( policy ), &entries[0] );
+		EXPECT_EQ( evict( policy ), &reloaded );
+		EXPECT_EQ( evict( policy ), nullptr );
+	}
+} // namespace nfx::memory::test
@@ -0,0 +1,261 @@
+/**
+ * @file TESTS_FlatHashMap.cpp
+ * @brief Tests for the FlatHashMap storage engine
+ * @details Tests covering group matching, insertion, erasure with tombstones, growth,
+ *          address stability, reuse of reserved entries and agreement with std::unordered_map under random operations
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <nfx/memory/FlatHashMap.h>
+
+namespace nfx::memory::test
+{
+	//=====================================================================
+	// FlatHashMap Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Group matching
+	//----------------------------------------------
+
+	TEST( FlatHashMapGroupMatching, PortableMatchAgreesWithPlatformMatch )
+	{
+		using Map = FlatHashMap<int, int>;
+
+		std::array<std::uint8_t, Map::GROUP_WIDTH> ctrl{};
+		for ( std::size_t i{ 0 }; i < ctrl.size(); ++i )
+		{
+			ctrl[i] = static_cast<std::uint8_t>( i * 37 );
+		}
+		ctrl[3] = 0x80;
+		ctrl[9] = 0x80;
+		ctrl[12] = 0xFE;
+
+		for ( int value{ 0 }; value < 256; ++value )
+		{
+			const auto byte{ static_cast<std::uint8_t>( value ) };
+			EXPECT_EQ( Map::matchByte( ctrl, byte ), Map::matchBytePortable( ctrl, byte ) ) << "value " << value;
+		}
+
+		EXPECT_EQ( Map::matchBytePortable( ctrl, 0x80 ), ( 1u << 3 ) | ( 1u << 9 ) );
+		EXPECT_EQ( Map::matchFree( ctrl ) & ( ( 1u << 3 ) | ( 1u << 9 ) | ( 1u << 12 ) ), ( 1u << 3 ) | ( 1u << 9 ) | ( 1u << 12 ) );
+	}
+
+	//----------------------------------------------
+	// Basic operations
+	//----------------------------------------------
+
+	TEST( FlatHashMapOperations, InsertFindErase )
+	{
+		FlatHashMap<std::string, int> map;
+		EXPECT_TRUE( map.empty() );
+		EXPECT_EQ( map.find( std::string{ "missing" } ), map.end() );
+
+		auto [it, inserted] = map.try_emplace( std::string{ "one" }, 1 );
+		EXPECT_TRUE( inserted );
+		EXPECT_EQ( it->first, "one" );
+		EXPECT_EQ( it->second, 1 );
+
+		auto [again, insertedAgain] = map.try_emplace( std::string{ "one" }, 2 );
+		EXPECT_FALSE( insertedAgain );
+		EXPECT_EQ( again->second, 1 );
+		EXPECT_EQ( map.size(), 1 );
+
+		auto node = map.extract( map.find( std::string{ "one" } ) );
+		EXPECT_EQ( node.key(), "one" );
+		EXPECT_EQ( node.mapped(), 1 );
+		EXPECT_TRUE( map.empty() );
+	}
+
+	TEST( FlatHashMapOperations, AddressesStableAcrossGrowth )
+	{
+		FlatHashMap<int, int> map;
+
+		auto [first, inserted] = map.try_emplace( 0, 100 );
+		ASSERT_TRUE( inserted );
+		const int* firstValue{ &first->second };
+		const int* firstKey{ &first->first };
+
+		for ( int i{ 1 }; i < 10000; ++i )
+		{
+			map.try_emplace( int{ i }, i );
+		}
+
+		auto found = map.find( 0 );
+		ASSERT_NE( found, map.end() );
+		EXPECT_EQ( &found->second, firstValue );
+		EXPECT_EQ( &found->first, firstKey );
+		EXPECT_EQ( *firstValue, 100 );
+	}
+
+	TEST( FlatHashMapOperations, ReservedEntriesAreReused )
+	{
+		FlatHashMap<int, int> map;
+		map.reserve( 64 );
+
+		std::set<const int*> reserved;
+		for ( int i{ 0 }; i < 64; ++i )
+		{
+			reserved.insert( &map.try_emplace( int{ i }, i ).first->second );
+		}
+
+		// A bounded cache erases before every insertion, new entries take the freed storage
+		for ( int i{ 64 }; i < 10000; ++i )
+		{
+			map.erase( map.find( i - 64 ) );
+			auto [it, inserted] = map.try_emplace( int{ i }, i );
+			ASSERT_TRUE( inserted );
+			EXPECT_TRUE( reserved.contains( &it->second ) );
+		}
+
+		EXPECT_EQ( map.size(), 64 );
+		for ( int i{ 10000 - 64 }; i < 10000; ++i )
+		{
+			auto found = map.find( i );
+			ASSERT_NE( found, map.end() );
+			EXPECT_EQ( found->second, i );
+		}
+	}
+
+	TEST( FlatHashMapOperations, EraseWhileIterating )
+	{
+		FlatHashMap<int, int> map;
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			map.try_emplace( int{ i }, i );
+		}
+
+		for ( auto it = map.begin(); it != map.end(); )
+		{
+			it = ( it->first % 2 == 0 ) ? map.erase( it ) : std::next( it );
+		}
+
+		EXPECT_EQ( map.size(), 500 );
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			EXPECT_EQ( map.find( i ) != map.end(), i % 2 == 1 );
+		}
+	}
+
+	TEST( FlatHashMapOperations, HeterogeneousFind )
+	{
+		struct StringHash
+		{
+			std::size_t operator()( std::string_view key ) const noexcept
+			{
+				return std::hash<std::string_view>{}( key );
+			}
+		};
+
+		FlatHashMap<std::string, int, StringHash, std::equal_to<>> map;
+		map.try_emplace( std::string{ "alpha" }, 1 );
+
+		EXPECT_NE( map.find( std::string_view{ "alpha" } ), map.end() );
+		EXPECT_EQ( map.find( std::string_view{ "beta" } ), map.end() );
+	}
+
+	TEST( FlatHashMapOperations, FindWithPrecomputedHash )
+	{
+		FlatHashMap<int, int> map;
+
+		// Prefetching an empty map touches no memory
+		map.prefetchGroup( map.hash( 1 ) );
+		map.prefetchEntries( map.hash( 1 ) );
+		EXPECT_EQ( map.find( 1, map.hash( 1 ) ), map.end() );
+
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			map.try_emplace( int{ i }, i * 2 );
+		}
+
+		for ( int i{ 0 }; i < 2000; ++i )
+		{
+			const auto hash{ map.hash( i ) };
+			map.prefetchGroup( hash );
+			map.prefetchEntries( hash );
+
+			EXPECT_EQ( map.find( i, hash ), map.find( i ) );
+		}
+		EXPECT_EQ( map.find( 500, map.hash( 500 ) )->second, 1000 );
+	}
+
+	TEST( FlatHashMapOperations, ClearKeepsMapUsable )
+	{
+		FlatHashMap<int, std::string> map;
+		for ( int i{ 0 }; i < 300; ++i )
+		{
+			map.try_emplace( int{ i }, std::to_string( i ) );
+		}
+
+		map.clear();
+		EXPECT_TRUE( map.empty() );
+		EXPECT_EQ( map.begin(), map.end() );
+
+		map.try_emplace( 7, "seven" );
+		EXPECT_EQ( map.find( 7 )->second, "seven" );
+		EXPECT_EQ( map.size(), 1 );
+	}
+
+	//----------------------------------------------
+	// Randomized agreement
+	//----------------------------------------------
+
+	TEST( FlatHashMapRandomized, MatchesUnorderedMap )
+	{
+		FlatHashMap<int, std::string> map;
+		std::unordered_map<int, std::string> reference;
+		std::mt19937 rng{ 12345 };
+
+		// A small key space with many erasures exercises tombstone reuse and in-place rehashing
+		for ( int i{ 0 }; i < 100000; ++i )
+		{
+			const int key{ static_cast<int>( rng() % 2000 ) };
+
+			switch ( rng() % 3 )
+			{
+				case 0:
+				{
+					auto [it, inserted] = map.try_emplace( int{ key }, std::to_string( key ) );
+					EXPECT_EQ( inserted, reference.try_emplace( key, std::to_string( key ) ).second );
+					EXPECT_EQ( it->second, std::to_string( key ) );
+					break;
+				}
+				case 1:
+				{
+					EXPECT_EQ( map.find( key ) == map.end(), reference.find( key ) == reference.end() );
+					break;
+				}
+				default:
+				{
+					auto it = map.find( key );
+					if ( it != map.end() )
+					{
+						map.erase( it );
+						reference.erase( key );
+					}
+					break;
+				}
+			}
+
+			ASSERT_EQ( map.size(), reference.size() );
+		}
+
+		std::size_t visited{ 0 };
+		for ( auto it = map.begin(); it != map.end(); ++it )
+		{
+			ASSERT_TRUE( reference.contains( it->first ) );
+			EXPECT_EQ( it->second, reference.at( it->first ) );
+			++visited;
+		}
+		EXPECT_EQ( visited, reference.size() );
+	}
+} // namespace nfx::memory::test
@@ -0,0 +1,113 @@
+/**
+ * @file TESTS_FrequencySketch.cpp
+ * @brief Tests for the FrequencySketch count-min sketch
+ * @details Tests covering counting, saturation, aging and growth
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <nfx/memory/FrequencySketch.h>
+
+namespace nfx::memory::test
+{
+	//=====================================================================
+	// FrequencySketch Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Counting
+	//----------------------------------------------
+
+	TEST( FrequencySketch, CountsAccesses )
+	{
+		FrequencySketch sketch{ 1024 };
+		EXPECT_EQ( sketch.frequency( 42 ), 0 );
+
+		for ( int i = 0; i < 5; ++i )
+		{
+			sketch.increment( 42 );
+		}
+		sketch.increment( 7 );
+
+		EXPECT_EQ( sketch.frequency( 42 ), 5 );
+		EXPECT_EQ( sketch.frequency( 7 ), 1 );
+		EXPECT_EQ( sketch.frequency( 1000 ), 0 );
+	}
+
+	TEST( FrequencySketch, SaturatesAtMaximum )
+	{
+		FrequencySketch sketch{ 1024 };
+		for ( int i = 0; i < 100; ++i )
+		{
+			sketch.increment( 3 );
+		}
+
+		EXPECT_EQ( sketch.frequency( 3 ), FrequencySketch::MAX_FREQUENCY );
+	}
+
+	TEST( FrequencySketch, FewCollisionsAtCapacity )
+	{
+		FrequencySketch sketch{ 1000 };
+		for ( std::uint64_t key = 0; key < 1000; ++key )
+		{
+			sketch.increment( key );
+		}
+
+		// Every key was seen once, overestimates need all four counters to collide
+		int overestimated = 0;
+		for ( std::uint64_t key = 0; key < 1000; ++key )
+		{
+			overestimated += sketch.frequency( key ) > 1 ? 1 : 0;
+		}
+		EXPECT_LT( overestimated, 10 );
+	}
+
+	//----------------------------------------------
+	// Aging
+	//----------------------------------------------
+
+	TEST( FrequencySketch, AgeHalvesCounters )
+	{
+		FrequencySketch sketch{ 1024 };
+		for ( int i = 0; i < 9; ++i )
+		{
+			sketch.increment( 11 );
+		}
+
+		sketch.age();
+		EXPECT_EQ( sketch.frequency( 11 ), 4 );
+
+		sketch.clear();
+		EXPECT_EQ( sketch.frequency( 11 ), 0 );
+	}
+
+	TEST( FrequencySketch, AgesAfterSamplePeriod )
+	{
+		FrequencySketch sketch{ 16 };
+		for ( int i = 0; i < 12; ++i )
+		{
+			sketch.increment( 5 );
+		}
+
+		// A sample of distinct keys makes the old popularity fade
+		for ( std::uint64_t key = 100; key < 100 + FrequencySketch::SAMPLE_FACTOR * 16; ++key )
+		{
+			sketch.increment( key );
+		}
+		EXPECT_LT( sketch.frequency( 5 ), 12 );
+	}
+
+	TEST( FrequencySketch, GrowthResetsCounts )
+	{
+		FrequencySketch sketch{ 16 };
+		sketch.increment( 9 );
+
+		sketch.ensureCapacity( 8 );
+		EXPECT_EQ( sketch.frequency( 9 ), 1 );
+
+		sketch.ensureCapacity( 4096 );
+		EXPECT_EQ( sketch.frequency( 9 ), 0 );
+	}
+} // namespace nfx::memory::test
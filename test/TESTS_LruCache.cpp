@@ -7,12 +7,23 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <nfx/memory/LruCache.h>
+#include <nfx/memory/ShardedLruCache.h>
+#include <nfx/memory/SlabAllocator.h>
 
 namespace nfx::memory::test
 {
@@ -97,6 +108,19 @@ namespace nfx::memory::test
 		EXPECT_FALSE( result.has_value() );
 	}
 
+	TEST( LruCacheOperations, RemoveIfChecksValue )
+	{
+		LruCache<std::string, int> cache;
+		cache.getOrCreate( "key", []() { return 42; } );
+
+		EXPECT_FALSE( cache.removeIf( "missing_key", []( int ) { return true; } ) );
+		EXPECT_FALSE( cache.removeIf( "key", []( int value ) { return value < 0; } ) );
+		EXPECT_EQ( cache.size(), 1 );
+
+		EXPECT_TRUE( cache.removeIf( "key", []( int value ) { return value == 42; } ) );
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
 	TEST( LruCacheOperations, ClearOperations )
 	{
 		LruCache<std::string, int> cache;
@@ -118,6 +142,97 @@ namespace nfx::memory::test
 		EXPECT_FALSE( cache.tryGet( "key3" ).has_value() );
 	}
 
+	//----------------------------------------------
+	// Batch operations
+	//----------------------------------------------
+
+	TEST( LruCacheBatch, TryGetManyReportsHitsAndMisses )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{}.withStatistics( true ) };
+		for ( int key = 0; key < 10; key += 2 )
+		{
+			cache.getOrCreate( key, [key]() { return key * 10; } );
+		}
+
+		const std::vector<int> keys{ 4, 5, 0, 9, 8 };
+		std::vector<std::optional<std::reference_wrapper<int>>> values( keys.size() );
+		const auto hits{ cache.tryGetMany( keys, values ) };
+
+		EXPECT_EQ( hits, ( std::vector<bool>{ true, false, true, false, true } ) );
+		ASSERT_TRUE( values[0].has_value() );
+		EXPECT_EQ( values[0]->get(), 40 );
+		EXPECT_FALSE( values[1].has_value() );
+		EXPECT_EQ( values[4]->get(), 80 );
+
+		const auto stats{ cache.stats() };
+		EXPECT_EQ( stats.hitCount, 3 );
+		EXPECT_EQ( stats.missCount, 5 + 2 );
+
+		std::vector<std::optional<std::reference_wrapper<int>>> tooFew( 2 );
+		EXPECT_THROW( static_cast<void>( cache.tryGetMany( keys, tooFew ) ), std::invalid_argument );
+	}
+
+	TEST( LruCacheBatch, TryGetManySkipsExpiredEntries )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 20 ) }.withReadBuffering( true ) };
+		cache.getOrCreate( 1, []() { return 1; } );
+		cache.getOrCreate( 2, []() { return 2; }, []( CacheEntry& entry ) { entry.slidingExpiration = std::chrono::hours( 1 ); } );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+
+		const std::vector<int> keys{ 1, 2 };
+		std::vector<std::optional<std::reference_wrapper<int>>> values( keys.size() );
+		EXPECT_EQ( cache.tryGetMany( keys, values ), ( std::vector<bool>{ false, true } ) );
+		EXPECT_EQ( cache.size(), 1 );
+	}
+
+	TEST( LruCacheBatch, TryGetManyPrefetchedWindows )
+	{
+		using FlatCache = LruCache<int, int, std::hash<int>, std::equal_to<int>, FlatStorage>;
+
+		FlatCache cache{ LruCacheOptions{}.withStatistics( true ) };
+		for ( int key = 0; key < 100; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return key + 1; } );
+		}
+
+		// Several prefetch windows, the last one partial, with hits and misses interleaved
+		std::vector<int> keys;
+		for ( int key = 0; key < 75; ++key )
+		{
+			keys.push_back( key * 3 );
+		}
+		std::vector<std::optional<std::reference_wrapper<int>>> values( keys.size() );
+		const auto hits{ cache.tryGetMany( keys, values ) };
+
+		for ( std::size_t i = 0; i < keys.size(); ++i )
+		{
+			ASSERT_EQ( hits[i], keys[i] < 100 );
+			if ( hits[i] )
+			{
+				EXPECT_EQ( values[i]->get(), keys[i] + 1 );
+			}
+		}
+		EXPECT_EQ( cache.stats().hitCount, 34 );
+	}
+
+	TEST( LruCacheBatch, InsertManyKeepsCachedEntries )
+	{
+		LruCache<int, std::string> cache{ LruCacheOptions{ 3 } };
+		cache.getOrCreate( 2, []() { return std::string{ "cached" }; } );
+
+		std::vector<std::pair<int, std::string>> entries{ { 1, "one" }, { 2, "two" }, { 3, "three" }, { 4, "four" } };
+		const auto inserted{ cache.insertMany( entries, []( CacheEntry& entry ) { entry.size = 1; } ) };
+
+		EXPECT_EQ( inserted, ( std::vector<bool>{ true, false, true, true } ) );
+		EXPECT_EQ( entries[1].second, "two" );
+
+		// The size limit applies entry by entry: the oldest entry made room for the last one
+		EXPECT_EQ( cache.size(), 3 );
+		EXPECT_FALSE( cache.tryGet( 2 ).has_value() );
+		EXPECT_EQ( cache.tryGet( 4 )->get(), "four" );
+	}
+
 	//----------------------------------------------
 	// Expiration policies
 	//----------------------------------------------
@@ -210,6 +325,127 @@ namespace nfx::memory::test
 		EXPECT_EQ( cache.size(), 0 );
 	}
 
+	TEST( LruCacheExpiration, CleanupRemovesOnlyDueOverrides )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::hours( 1 ) } };
+		std::vector<int> expired;
+		cache.setRemovalListener( [&expired]( const int& key, int&&, RemovalCause ) { expired.push_back( key ); } );
+
+		// Short overrides interleaved with long-lived entries, so LRU order is not expiry order
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			if ( i % 10 == 0 )
+			{
+				cache.getOrCreate( i, [i]() { return i; }, []( CacheEntry& entry ) { entry.slidingExpiration = std::chrono::milliseconds( 20 ); } );
+			}
+			else
+			{
+				cache.getOrCreate( i, [i]() { return i; } );
+			}
+		}
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.size(), 90 );
+		EXPECT_EQ( expired.size(), 10 );
+
+		for ( int key : expired )
+		{
+			EXPECT_EQ( key % 10, 0 );
+		}
+	}
+
+	TEST( LruCacheExpiration, AccessReschedulesExpiry )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 60 ) } };
+		cache.getOrCreate( 1, []() { return 1; } );
+		cache.getOrCreate( 2, []() { return 2; } );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+		EXPECT_TRUE( cache.tryGet( 1 ).has_value() );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+
+		// Entry 1 was filed again under its new deadline when it was read
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_TRUE( cache.tryGet( 1 ).has_value() );
+	}
+
+	TEST( LruCacheExpiration, AbsoluteExpirationIgnoresAccess )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::hours( 1 ) }.withAbsoluteExpiration( std::chrono::milliseconds( 60 ) ) };
+		cache.getOrCreate( 1, []() { return 1; } );
+
+		// Reads keep resetting the sliding deadline, not the absolute one
+		for ( int i{ 0 }; i < 3; ++i )
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+			EXPECT_TRUE( cache.tryGet( 1 ).has_value() );
+		}
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+		EXPECT_FALSE( cache.tryGet( 1 ).has_value() );
+		EXPECT_EQ( cache.size(), 0 );
+	}
+
+	TEST( LruCacheExpiration, AbsoluteExpirationPerEntry )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::hours( 1 ) } };
+		std::vector<std::pair<int, RemovalCause>> removals;
+		cache.setRemovalListener( [&removals]( const int& key, int&&, RemovalCause cause ) { removals.emplace_back( key, cause ); } );
+
+		cache.getOrCreate( 1, []() { return 1; }, []( CacheEntry& entry ) { entry.absoluteExpiration = std::chrono::milliseconds( 20 ); } );
+		cache.getOrCreate( 2, []() { return 2; } );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+
+		// Found through the expiry index, without reading the entry
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.size(), 1 );
+		ASSERT_EQ( removals.size(), 1 );
+		EXPECT_EQ( removals[0], std::make_pair( 1, RemovalCause::Expired ) );
+		EXPECT_TRUE( cache.tryGet( 2 ).has_value() );
+	}
+
+	TEST( LruCacheExpiration, ExpiresAtEarlierDeadline )
+	{
+		const auto now{ std::chrono::steady_clock::now() };
+		CacheEntry entry{ std::chrono::milliseconds( 100 ), now };
+		EXPECT_EQ( entry.expiresAt(), now + std::chrono::milliseconds( 100 ) );
+
+		entry.absoluteExpiration = std::chrono::milliseconds( 30 );
+		EXPECT_EQ( entry.expiresAt(), now + std::chrono::milliseconds( 30 ) );
+		EXPECT_TRUE( entry.isExpired( now + std::chrono::milliseconds( 31 ) ) );
+
+		entry.absoluteExpiration = std::chrono::hours( 1 );
+		EXPECT_EQ( entry.expiresAt(), now + std::chrono::milliseconds( 100 ) );
+	}
+
+	TEST( LruCacheExpiration, HugeExpirationNeverExpires )
+	{
+		const auto forever{ std::chrono::milliseconds::max() };
+
+		// Checked under the exclusive lock, then under the shared lock of read-buffered hits
+		for ( const bool readBuffering : { false, true } )
+		{
+			LruCache<int, int> absolute{ LruCacheOptions{ 0, std::chrono::hours( 1 ) }.withAbsoluteExpiration( forever ).withReadBuffering( readBuffering ) };
+			absolute.getOrCreate( 1, []() { return 1; } );
+			EXPECT_TRUE( absolute.tryGet( 1 ).has_value() );
+
+			LruCache<int, int> sliding{ LruCacheOptions{ 0, forever }.withReadBuffering( readBuffering ) };
+			sliding.getOrCreate( 1, []() { return 1; } );
+			EXPECT_TRUE( sliding.tryGet( 1 ).has_value() );
+			EXPECT_EQ( sliding.size(), 1 );
+		}
+
+		const auto now{ std::chrono::steady_clock::now() };
+		CacheEntry entry{ forever, now };
+		entry.absoluteExpiration = forever;
+		EXPECT_FALSE( entry.isExpired( now + std::chrono::hours( 24 * 365 ) ) );
+	}
+
 	//----------------------------------------------
 	// Size limits and LRU eviction
 	//----------------------------------------------
@@ -292,132 +528,1270 @@ namespace nfx::memory::test
 	}
 
 	//----------------------------------------------
-	// Factory function and configuration
+	// Weighted capacity
 	//----------------------------------------------
 
-	TEST( LruCacheFactory, FactoryFunctionCalls )
+	TEST( LruCacheWeight, ConfiguredSizeEvictsUntilFit )
 	{
-		LruCache<std::string, std::string> cache;
+		LruCache<std::string, int> cache( LruCacheOptions{}.withMaxWeight( 100 ) );
 
-		int factoryCallCount{ 0 };
-		auto factory = [&factoryCallCount]() {
-			++factoryCallCount;
-			return std::string{ "factory_value" };
+		auto weigh = []( std::size_t weight ) {
+			return [weight]( CacheEntry& entry ) { entry.size = weight; };
 		};
 
-		// First call should invoke factory
-		auto& value1 = cache.getOrCreate( "factory_key", factory );
-		EXPECT_EQ( value1, "factory_value" );
-		EXPECT_EQ( factoryCallCount, 1 );
+		cache.getOrCreate( "a", []() { return 1; }, weigh( 40 ) );
+		cache.getOrCreate( "b", []() { return 2; }, weigh( 40 ) );
+		cache.getOrCreate( "c", []() { return 3; }, weigh( 20 ) );
+		EXPECT_EQ( cache.totalWeight(), 100 );
+		EXPECT_EQ( cache.size(), 3 );
+
+		// Needs 70: evicts "a" then "b" from the LRU tail
+		cache.getOrCreate( "d", []() { return 4; }, weigh( 70 ) );
+		EXPECT_FALSE( cache.tryGet( "a" ).has_value() );
+		EXPECT_FALSE( cache.tryGet( "b" ).has_value() );
+		EXPECT_TRUE( cache.tryGet( "c" ).has_value() );
+		EXPECT_TRUE( cache.tryGet( "d" ).has_value() );
+		EXPECT_EQ( cache.totalWeight(), 90 );
+	}
+
+	TEST( LruCacheWeight, WeigherFunction )
+	{
+		LruCache<int, std::string> cache(
+			LruCacheOptions{}.withMaxWeight( 1000 ),
+			[]( const int&, const std::string& value ) { return value.size(); } );
+
+		for ( int i{ 0 }; i < 10; ++i )
+		{
+			cache.getOrCreate( i, []() { return std::string( 300, 'x' ); } );
+		}
+
+		EXPECT_EQ( cache.size(), 3 );
+		EXPECT_EQ( cache.totalWeight(), 900 );
+		EXPECT_TRUE( cache.tryGet( 9 ).has_value() );
+		EXPECT_FALSE( cache.tryGet( 6 ).has_value() );
+	}
+
+	TEST( LruCacheWeight, OversizedEntryAdmittedAlone )
+	{
+		LruCache<int, int> cache( LruCacheOptions{}.withMaxWeight( 10 ) );
+
+		cache.getOrCreate( 1, []() { return 1; }, []( CacheEntry& entry ) { entry.size = 5; } );
+		cache.getOrCreate( 2, []() { return 2; }, []( CacheEntry& entry ) { entry.size = 50; } );
+
+		EXPECT_EQ( cache.size(), 1 );
+		EXPECT_TRUE( cache.tryGet( 2 ).has_value() );
+		EXPECT_EQ( cache.totalWeight(), 50 );
+	}
+
+	TEST( LruCacheWeight, WeightReleasedOnRemoval )
+	{
+		LruCache<int, int> cache( LruCacheOptions{ 0, std::chrono::milliseconds( 20 ) }.withMaxWeight( 1000 ) );
+
+		for ( int i{ 0 }; i < 5; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; }, []( CacheEntry& entry ) { entry.size = 10; } );
+		}
+		EXPECT_EQ( cache.totalWeight(), 50 );
+
+		cache.remove( 0 );
+		EXPECT_EQ( cache.totalWeight(), 40 );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
+		cache.cleanupExpired();
+		EXPECT_EQ( cache.totalWeight(), 0 );
+
+		cache.getOrCreate( 7, []() { return 7; } );
+		cache.clear();
+		EXPECT_EQ( cache.totalWeight(), 0 );
+	}
+
+	//----------------------------------------------
+	// Eviction policies
+	//----------------------------------------------
+
+	/** @brief Cache of int keys using a given eviction policy */
+	template <template <typename> typename TPolicy, typename TValue = int>
+	using PolicyCache = LruCache<int, TValue, std::hash<int>, std::equal_to<int>, NodeStorage, std::allocator<std::pair<const int, TValue>>, TPolicy>;
+
+	/**
+	 * @brief Access a hot set repeatedly, then scan one-off keys through a cache of 100 entries
+	 * @return Number of the 50 hot keys still cached after the scan
+	 */
+	template <template <typename> typename TPolicy>
+	int hotKeysRetainedAfterScan()
+	{
+		PolicyCache<TPolicy> cache{ LruCacheOptions{ 100 } };
+
+		for ( int round = 0; round < 5; ++round )
+		{
+			for ( int key = 0; key < 50; ++key )
+			{
+				cache.getOrCreate( key, [key]() { return key; } );
+			}
+		}
+
+		for ( int key = 1000; key < 3000; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return key; } );
+			EXPECT_LE( cache.size(), 100 );
+		}
+
+		int retained = 0;
+		for ( int key = 0; key < 50; ++key )
+		{
+			retained += cache.tryGet( key ).has_value() ? 1 : 0;
+		}
+
+		return retained;
+	}
+
+	TEST( LruCachePolicy, ScanResistance )
+	{
+		// Plain LRU keeps only the tail of the scan
+		EXPECT_EQ( hotKeysRetainedAfterScan<LruPolicy>(), 0 );
+		EXPECT_EQ( hotKeysRetainedAfterScan<SlruPolicy>(), 50 );
+		EXPECT_EQ( hotKeysRetainedAfterScan<ArcPolicy>(), 50 );
+
+		// The hot key still in the window when the scan starts may lose a tie against another hot key
+		EXPECT_GE( hotKeysRetainedAfterScan<WTinyLfuPolicy>(), 49 );
+
+		// Plain CLOCK gives each entry one extra lap only
+		EXPECT_EQ( hotKeysRetainedAfterScan<ClockPolicy>(), 0 );
+		EXPECT_EQ( hotKeysRetainedAfterScan<ClockProPolicy>(), 50 );
+		EXPECT_EQ( hotKeysRetainedAfterScan<S3FifoPolicy>(), 50 );
+	}
+
+	TEST( LruCachePolicy, TwoQueueRemembersEvictedKeys )
+	{
+		PolicyCache<TwoQueuePolicy> cache{ LruCacheOptions{ 100 } };
+		for ( int key = 0; key < 125; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return key; } );
+		}
+
+		// Keys 0 to 24 left A1in as ghosts; loaded again, they enter Am and outlive a scan
+		for ( int key = 0; key < 25; ++key )
+		{
+			EXPECT_FALSE( cache.tryGet( key ).has_value() );
+			cache.getOrCreate( key, [key]() { return key; } );
+		}
+		for ( int key = 1000; key < 3000; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return key; } );
+		}
+
+		for ( int key = 0; key < 25; ++key )
+		{
+			EXPECT_TRUE( cache.tryGet( key ).has_value() );
+		}
+	}
+
+	/** @brief LRU policy whose onInsert() throws on demand, before linking the entry */
+	template <typename TEntry>
+	class FailingInsertPolicy final
+	{
+	public:
+		static constexpr bool RECENCY_ORDERED = true;
+		static constexpr bool CONCURRENT_ACCESS = false;
+		static constexpr bool RECORDS_MISSES = false;
+
+		static inline bool failInsert{ false };
+
+		FailingInsertPolicy( std::size_t capacity, bool weighted )
+			: m_lru{ capacity, weighted }
+		{
+		}
+
+		template <typename THashFn>
+		void onInsert( TEntry* entry, const THashFn& hash )
+		{
+			if ( failInsert )
+			{
+				throw std::bad_alloc{};
+			}
+			m_lru.onInsert( entry, hash );
+		}
+
+		template <typename THashFn>
+		void onAccess( TEntry* entry, const THashFn& hash )
+		{
+			m_lru.onAccess( entry, hash );
+		}
+
+		template <typename THashFn>
+		void onMiss( const THashFn& hash )
+		{
+			m_lru.onMiss( hash );
+		}
+
+		void onRemove( TEntry* entry )
+		{
+			m_lru.onRemove( entry );
+		}
+
+		template <typename THashOf>
+		TEntry* victim( const THashOf& hashOf )
+		{
+			return m_lru.victim( hashOf );
+		}
+
+		TEntry* oldest() const
+		{
+			return m_lru.oldest();
+		}
+
+		void clear()
+		{
+			m_lru.clear();
+		}
+
+	private:
+		LruPolicy<TEntry> m_lru;
+	};
+
+	TEST( LruCachePolicy, FailedPolicyInsertLeavesNoEntry )
+	{
+		PolicyCache<FailingInsertPolicy> cache{ LruCacheOptions{ 3 } };
+		cache.getOrCreate( 1, []() { return 1; } );
+		cache.getOrCreate( 2, []() { return 2; } );
+
+		FailingInsertPolicy<CacheEntry>::failInsert = true;
+		EXPECT_THROW( cache.getOrCreate( 3, []() { return 3; } ), std::bad_alloc );
+		FailingInsertPolicy<CacheEntry>::failInsert = false;
+
+		EXPECT_EQ( cache.size(), 2 );
+		EXPECT_FALSE( cache.tryGet( 3 ).has_value() );
+
+		// Eviction and removal still see a consistent policy
+		for ( int key = 3; key < 10; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return key; } );
+		}
+		EXPECT_EQ( cache.size(), 3 );
+		EXPECT_TRUE( cache.remove( 9 ) );
+		EXPECT_EQ( cache.tryGet( 8 )->get(), 8 );
+	}
+
+	TEST( LruCachePolicy, TinyLfuAdmitsFrequentNewcomer )
+	{
+		PolicyCache<WTinyLfuPolicy> cache{ LruCacheOptions{ 10 } };
+		for ( int key = 0; key < 10; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return key; } );
+		}
+
+		// Misses count, so a key requested repeatedly wins admission over cold residents
+		for ( int i = 0; i < 5; ++i )
+		{
+			EXPECT_FALSE( cache.tryGet( 100 ).has_value() );
+		}
+		cache.getOrCreate( 100, []() { return 100; } );
+		cache.getOrCreate( 101, []() { return 101; } );
+
+		EXPECT_TRUE( cache.tryGet( 100 ).has_value() );
+		EXPECT_EQ( cache.size(), 10 );
+	}
+
+	TEST( LruCachePolicy, TinyLfuAdmitsFrequentNewcomerWithReadBuffering )
+	{
+		PolicyCache<WTinyLfuPolicy> cache{ LruCacheOptions{ 10 }.withReadBuffering( true ) };
+		for ( int key = 0; key < 10; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return key; } );
+		}
+
+		// Misses still reach the frequency sketch when hits are served under the shared lock
+		for ( int i = 0; i < 4; ++i )
+		{
+			EXPECT_FALSE( cache.tryGet( 100 ).has_value() );
+		}
+		const std::vector<int> missing{ 100 };
+		std::vector<std::optional<std::reference_wrapper<int>>> values( missing.size() );
+		EXPECT_EQ( cache.tryGetMany( missing, values ), ( std::vector<bool>{ false } ) );
+		cache.getOrCreate( 100, []() { return 100; } );
+		cache.getOrCreate( 101, []() { return 101; } );
+
+		EXPECT_TRUE( cache.tryGet( 100 ).has_value() );
+		EXPECT_EQ( cache.size(), 10 );
+	}
+
+	/** @brief Mixed operations against a weight-limited cache, checked after every insertion */
+	template <template <typename> typename TPolicy>
+	void checkWeightLimit()
+	{
+		PolicyCache<TPolicy, std::string> cache{ LruCacheOptions{}.withMaxWeight( 1000 ),
+			[]( const int&, const std::string& value ) { return value.size(); } };
+
+		for ( int key = 0; key < 500; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return std::string( static_cast<std::size_t>( 10 + key % 40 ), 'x' ); } );
+			cache.tryGet( key % 7 );
+			cache.tryGet( key / 2 );
+			EXPECT_LE( cache.totalWeight(), 1000 );
+		}
+		EXPECT_GT( cache.size(), 0 );
+	}
+
+	TEST( LruCachePolicy, WeightLimitRespected )
+	{
+		checkWeightLimit<SlruPolicy>();
+		checkWeightLimit<TwoQueuePolicy>();
+		checkWeightLimit<ArcPolicy>();
+		checkWeightLimit<WTinyLfuPolicy>();
+		checkWeightLimit<ClockPolicy>();
+		checkWeightLimit<ClockProPolicy>();
+		checkWeightLimit<S3FifoPolicy>();
+	}
+
+	/** @brief Entries spread over every segment of a policy all expire */
+	template <template <typename> typename TPolicy>
+	void checkExpiration()
+	{
+		PolicyCache<TPolicy> cache{ LruCacheOptions{ 100, std::chrono::milliseconds( 20 ) } };
+		for ( int key = 0; key < 150; ++key )
+		{
+			cache.getOrCreate( key % 120, [key]() { return key; } );
+		}
+		for ( int key = 0; key < 120; key += 3 )
+		{
+			cache.tryGet( key );
+		}
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+		cache.cleanupExpired();
+
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( LruCachePolicy, ExpirationAcrossSegments )
+	{
+		checkExpiration<SlruPolicy>();
+		checkExpiration<TwoQueuePolicy>();
+		checkExpiration<ArcPolicy>();
+		checkExpiration<WTinyLfuPolicy>();
+		checkExpiration<ClockPolicy>();
+		checkExpiration<ClockProPolicy>();
+		checkExpiration<S3FifoPolicy>();
+	}
+
+	TEST( LruCachePolicy, ReadBufferedHitsReachPolicy )
+	{
+		PolicyCache<SlruPolicy> cache{ LruCacheOptions{ 100 }.withReadBuffering( true ) };
+		for ( int key = 0; key < 50; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return key; } );
+			cache.tryGet( key );
+		}
+
+		// Buffered hits are replayed as promotions before the scan evicts anything
+		for ( int key = 1000; key < 2000; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return key; } );
+		}
+
+		for ( int key = 0; key < 50; ++key )
+		{
+			EXPECT_TRUE( cache.tryGet( key ).has_value() );
+		}
+	}
+
+	TEST( LruCachePolicy, ClockHitsUnderSharedLock )
+	{
+		PolicyCache<ClockPolicy> cache{ LruCacheOptions{ 100 } };
+		for ( int key = 0; key < 50; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return key; } );
+		}
+
+		// Readers only set reference bits while the writer sweeps the clock; a fixed amount of
+		// reads, as continuous readers may starve the writer of a reader-preferring shared mutex.
+		// Values are not read back: the writer may evict an entry as soon as tryGet() returns
+		std::vector<std::thread> readers;
+		for ( int t = 0; t < 4; ++t )
+		{
+			readers.emplace_back( [&cache]() {
+				for ( int round = 0; round < 200; ++round )
+				{
+					for ( int key = 0; key < 50; ++key )
+					{
+						static_cast<void>( cache.tryGet( key ) );
+					}
+				}
+			} );
+		}
+
+		for ( int key = 1000; key < 6000; ++key )
+		{
+			cache.getOrCreate( key, [key]() { return key; } );
+		}
+		for ( auto& reader : readers )
+		{
+			reader.join();
+		}
+
+		for ( int key = 0; key < 6000; ++key )
+		{
+			if ( auto value{ cache.tryGet( key ) } )
+			{
+				EXPECT_EQ( value->get(), key );
+			}
+		}
+		EXPECT_LE( cache.size(), 100 );
+	}
+
+	//----------------------------------------------
+	// Factory function and configuration
+	//----------------------------------------------
+
+	TEST( LruCacheFactory, FactoryFunctionCalls )
+	{
+		LruCache<std::string, std::string> cache;
+
+		int factoryCallCount{ 0 };
+		auto factory = [&factoryCallCount]() {
+			++factoryCallCount;
+			return std::string{ "factory_value" };
+		};
+
+		// First call should invoke factory
+		auto& value1 = cache.getOrCreate( "factory_key", factory );
+		EXPECT_EQ( value1, "factory_value" );
+		EXPECT_EQ( factoryCallCount, 1 );
+
+		// Second call should not invoke factory
+		auto& value2 = cache.getOrCreate( "factory_key", factory );
+		EXPECT_EQ( value2, "factory_value" );
+		EXPECT_EQ( factoryCallCount, 1 );
+	}
+
+	TEST( LruCacheFactory, ConfigurationFunction )
+	{
+		LruCache<std::string, std::string> cache;
+
+		bool configCalled{ false };
+		auto configFunc = [&configCalled]( CacheEntry& entry ) {
+			configCalled = true;
+			entry.slidingExpiration = { std::chrono::minutes( 5 ) };
+			entry.size = { 100 };
+		};
+
+		cache.getOrCreate( "config_key", []() { return std::string{ "config_value" }; }, configFunc );
+
+		EXPECT_TRUE( configCalled );
+	}
+
+	TEST( LruCacheFactory, TypeErasedCallables )
+	{
+		LruCache<int, int> cache( LruCacheOptions{ 0, std::chrono::minutes( 1 ) } );
+
+		LruCache<int, int>::FactoryFunction factory{ []() { return 5; } };
+		LruCache<int, int>::ConfigFunction emptyConfig;
+		LruCache<int, int>::ConfigFunction config{ []( CacheEntry& entry ) { entry.size = 3; } };
+
+		EXPECT_EQ( cache.getOrCreate( 1, factory, emptyConfig ), 5 );
+		EXPECT_EQ( cache.getOrCreate( 2, factory, config ), 5 );
+		EXPECT_EQ( cache.getOrCreate( 3, factory, nullptr ), 5 );
+		EXPECT_EQ( cache.totalWeight(), 5 );
+	}
+
+	TEST( LruCacheFactory, MoveOnlyFactory )
+	{
+		LruCache<int, int> cache;
+
+		auto payload = std::make_unique<int>( 9 );
+		EXPECT_EQ( cache.getOrCreate( 1, [payload = std::move( payload )]() { return *payload; } ), 9 );
+	}
+
+	TEST( LruCacheFactory, FactoryNotCopiedOnHit )
+	{
+		struct CountingFactory
+		{
+			int* copies;
+
+			CountingFactory( int* counter )
+				: copies{ counter }
+			{
+			}
+
+			CountingFactory( const CountingFactory& other )
+				: copies{ other.copies }
+			{
+				++*copies;
+			}
+
+			int operator()() const
+			{
+				return 1;
+			}
+		};
+
+		LruCache<int, int> cache;
+		int copies{ 0 };
+		CountingFactory factory{ &copies };
+
+		cache.getOrCreate( 1, factory );
+		cache.getOrCreate( 1, factory );
+
+		EXPECT_EQ( copies, 0 );
+	}
+
+	//----------------------------------------------
+	// Heterogeneous lookup
+	//----------------------------------------------
+
+	/** @brief Transparent string hash accepting any string-like key */
+	struct TransparentStringHash
+	{
+		using is_transparent = void;
+
+		std::size_t operator()( std::string_view key ) const noexcept
+		{
+			return std::hash<std::string_view>{}( key );
+		}
+	};
+
+	using TransparentCache = LruCache<std::string, int, TransparentStringHash, std::equal_to<>>;
+
+	static_assert( TransparentLookup<std::string_view, std::string, TransparentStringHash, std::equal_to<>> );
+	static_assert( !TransparentLookup<std::string_view, std::string, std::hash<std::string>, std::equal_to<std::string>> );
+
+	TEST( LruCacheHeterogeneousLookup, StringViewLookups )
+	{
+		TransparentCache cache;
+
+		const std::string_view key{ "a key long enough to defeat the small string optimization" };
+
+		EXPECT_EQ( cache.getOrCreate( key, []() { return 1; } ), 1 );
+		EXPECT_EQ( cache.getOrCreate( key, []() { return 2; } ), 1 );
+
+		auto result = cache.tryGet( key );
+		ASSERT_TRUE( result.has_value() );
+		EXPECT_EQ( result->get(), 1 );
+
+		// Owning keys and string literals resolve to the same entry
+		EXPECT_TRUE( cache.tryGet( std::string{ key } ).has_value() );
+		EXPECT_FALSE( cache.tryGet( "missing" ).has_value() );
+
+		EXPECT_TRUE( cache.remove( key ) );
+		EXPECT_FALSE( cache.remove( key ) );
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( LruCacheHeterogeneousLookup, KeyConstructedOnInsertion )
+	{
+		TransparentCache cache;
+
+		std::string removedKey;
+		cache.setRemovalListener( [&removedKey]( const std::string& key, int&&, RemovalCause ) { removedKey = key; } );
+
+		char buffer[]{ "buffer_key" };
+		cache.getOrCreate( std::string_view{ buffer }, []() { return 7; } );
+
+		// The cache owns a copy, independent of the caller's buffer
+		buffer[0] = 'X';
+		EXPECT_TRUE( cache.tryGet( std::string_view{ "buffer_key" } ).has_value() );
+
+		cache.clear();
+		EXPECT_EQ( removedKey, "buffer_key" );
+	}
+
+	//----------------------------------------------
+	// Flat storage
+	//----------------------------------------------
+
+	using FlatCache = LruCache<int, std::string, std::hash<int>, std::equal_to<int>, FlatStorage>;
+
+	TEST( LruCacheFlatStorage, OperationsAndLruEviction )
+	{
+		FlatCache cache( LruCacheOptions{ 3 } );
+
+		cache.getOrCreate( 1, []() { return std::string{ "one" }; } );
+		cache.getOrCreate( 2, []() { return std::string{ "two" }; } );
+		cache.getOrCreate( 3, []() { return std::string{ "three" }; } );
+		cache.tryGet( 1 );
+		cache.getOrCreate( 4, []() { return std::string{ "four" }; } ); // evicts 2
+
+		EXPECT_EQ( cache.size(), 3 );
+		EXPECT_TRUE( cache.tryGet( 1 ).has_value() );
+		EXPECT_FALSE( cache.tryGet( 2 ).has_value() );
+		EXPECT_EQ( cache.tryGet( 4 )->get(), "four" );
+
+		EXPECT_TRUE( cache.remove( 3 ) );
+		EXPECT_EQ( cache.size(), 2 );
+
+		cache.clear();
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( LruCacheFlatStorage, ReferencesStableAcrossGrowth )
+	{
+		FlatCache cache;
+
+		auto& first = cache.getOrCreate( 0, []() { return std::string{ "first" }; } );
+		for ( int i{ 1 }; i < 5000; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return std::to_string( i ); } );
+		}
+
+		EXPECT_EQ( first, "first" );
+		EXPECT_EQ( &cache.tryGet( 0 )->get(), &first );
+	}
+
+	TEST( LruCacheFlatStorage, ExpirationAndRemovalListener )
+	{
+		FlatCache cache( LruCacheOptions{ 100, std::chrono::milliseconds{ 20 } } );
+
+		int expired{ 0 };
+		cache.setRemovalListener( [&expired]( const int&, std::string&&, RemovalCause cause ) {
+			if ( cause == RemovalCause::Expired )
+			{
+				++expired;
+			}
+		} );
+
+		for ( int i{ 0 }; i < 50; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return std::to_string( i ); } );
+		}
+
+		std::this_thread::sleep_for( std::chrono::milliseconds{ 30 } );
+		cache.cleanupExpired();
+
+		EXPECT_TRUE( cache.isEmpty() );
+		EXPECT_EQ( expired, 50 );
+	}
+
+	TEST( LruCacheFlatStorage, ClearWithRemovalListenerIsLinear )
+	{
+		FlatCache cache( LruCacheOptions{} );
+
+		std::size_t cleared{ 0 };
+		cache.setRemovalListener( [&cleared]( const int&, std::string&&, RemovalCause cause ) {
+			if ( cause == RemovalCause::Cleared )
+			{
+				++cleared;
+			}
+		} );
+
+		for ( int i{ 0 }; i < 200'000; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return std::to_string( i ); } );
+		}
+
+		// Restarting from begin() for each entry would take minutes at this size
+		const auto start{ std::chrono::steady_clock::now() };
+		cache.clear();
+		const auto elapsed{ std::chrono::steady_clock::now() - start };
+
+		EXPECT_TRUE( cache.isEmpty() );
+		EXPECT_EQ( cleared, 200'000 );
+		EXPECT_LT( elapsed, std::chrono::seconds{ 5 } );
+	}
+
+	TEST( LruCacheFlatStorage, ConcurrentReadBufferedAccess )
+	{
+		FlatCache cache( LruCacheOptions{ 256 }.withReadBuffering( true ) );
+
+		std::vector<std::thread> threads;
+		for ( int t{ 0 }; t < 4; ++t )
+		{
+			threads.emplace_back( [&cache, t]() {
+				for ( int i{ 0 }; i < 5000; ++i )
+				{
+					int key{ ( i % 3 == 0 ) ? 1000 + t * 5000 + i : i % 64 };
+					cache.getOrCreate( key, [key]() { return std::to_string( key ); } );
+					cache.tryGet( i % 64 );
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_LE( cache.size(), 256 );
+		for ( int key{ 0 }; key < 64; ++key )
+		{
+			EXPECT_EQ( cache.getOrCreate( key, [key]() { return std::to_string( key ); } ), std::to_string( key ) );
+		}
+	}
+
+	//----------------------------------------------
+	// Allocators
+	//----------------------------------------------
+
+	TEST( LruCacheAllocator, SlabAllocatorRecyclesEvictedNodes )
+	{
+		using Allocator = SlabAllocator<std::pair<const int, std::string>>;
+
+		Allocator allocator;
+		LruCache<int, std::string, std::hash<int>, std::equal_to<int>, NodeStorage, Allocator> cache( LruCacheOptions{ 100 }, allocator );
+
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return std::to_string( i ); } );
+		}
+		const auto slabs{ allocator.arena()->slabCount() };
+
+		// Each insertion now reuses the node freed by the eviction it triggers
+		for ( int i{ 100 }; i < 100000; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return std::to_string( i ); } );
+		}
+
+		EXPECT_EQ( cache.size(), 100 );
+		EXPECT_EQ( allocator.arena()->slabCount(), slabs );
+		EXPECT_EQ( cache.tryGet( 99999 )->get(), "99999" );
+	}
+
+	TEST( LruCacheAllocator, SlabAllocatorWithFlatStorage )
+	{
+		using Allocator = SlabAllocator<std::pair<const int, int>>;
+
+		Allocator allocator;
+
+		// Unbounded, so entries go to chunks instead of a block reserved up front
+		LruCache<int, int, std::hash<int>, std::equal_to<int>, FlatStorage, Allocator> cache( LruCacheOptions{}, allocator );
+
+		for ( int i{ 0 }; i < 10000; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+		for ( int i{ 0 }; i < 10000; i += 2 )
+		{
+			EXPECT_TRUE( cache.remove( i ) );
+		}
+
+		EXPECT_EQ( cache.size(), 5000 );
+		EXPECT_GT( allocator.arena()->slabCount(), 0 );
+		EXPECT_EQ( cache.tryGet( 9999 )->get(), 9999 );
+	}
+
+	TEST( LruCacheAllocator, PmrCacheAllocatesFromResource )
+	{
+		/** @brief Resource counting the bytes it hands out */
+		class CountingResource final : public std::pmr::memory_resource
+		{
+		public:
+			std::size_t allocated{ 0 };
+
+		private:
+			void* do_allocate( std::size_t bytes, std::size_t alignment ) override
+			{
+				allocated += bytes;
+				return std::pmr::new_delete_resource()->allocate( bytes, alignment );
+			}
+
+			void do_deallocate( void* pointer, std::size_t bytes, std::size_t alignment ) override
+			{
+				std::pmr::new_delete_resource()->deallocate( pointer, bytes, alignment );
+			}
+
+			bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override
+			{
+				return this == &other;
+			}
+		};
+
+		CountingResource resource;
+		{
+			pmr::LruCache<int, std::string> cache( LruCacheOptions{ 10 }, &resource );
+
+			for ( int i{ 0 }; i < 50; ++i )
+			{
+				cache.getOrCreate( i, [i]() { return std::to_string( i ); } );
+			}
+
+			EXPECT_EQ( cache.size(), 10 );
+			EXPECT_TRUE( cache.tryGet( 49 ).has_value() );
+		}
+
+		EXPECT_GT( resource.allocated, 0 );
+	}
+
+	//----------------------------------------------
+	// Value type tests
+	//----------------------------------------------
+
+	TEST( LruCacheValueTypes, ComplexValues )
+	{
+		struct ComplexValue
+		{
+			std::string name;
+			std::vector<int> data;
+			double weight;
+
+			ComplexValue( std::string n, std::vector<int> d, double w )
+				: name{ std::move( n ) }, data{ std::move( d ) }, weight{ w } {}
+		};
+
+		LruCache<std::string, ComplexValue> cache;
+
+		auto factory = []() {
+			return ComplexValue{ "test", { 1, 2, 3, 4, 5 }, 3.14 };
+		};
+
+		auto& value = cache.getOrCreate( "complex_key", factory );
+		EXPECT_EQ( value.name, "test" );
+		EXPECT_EQ( value.data.size(), 5 );
+		EXPECT_DOUBLE_EQ( value.weight, 3.14 );
+	}
+
+	TEST( LruCacheValueTypes, MoveSemantics )
+	{
+		LruCache<std::string, std::unique_ptr<std::string>> cache;
+
+		auto factory = []() {
+			return std::make_unique<std::string>( "unique_value" );
+		};
+
+		auto& ptr = cache.getOrCreate( "unique_key", factory );
+		ASSERT_NE( ptr, nullptr );
+		EXPECT_EQ( *ptr, "unique_value" );
+	}
+
+	//----------------------------------------------
+	// Thread safety
+	//----------------------------------------------
+
+	TEST( LruCacheThreadSafety, ConcurrentAccess )
+	{
+		LruCache<int, std::string> cache;
+
+		const int numThreads{ 10 };
+		const int itemsPerThread{ 100 };
+		std::vector<std::thread> threads;
+
+		// Concurrent insertions
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			threads.emplace_back( [&cache, t]() {
+				for ( int i{ 0 }; i < itemsPerThread; ++i )
+				{
+					int key{ t * itemsPerThread + i };
+					cache.getOrCreate( key, [key]() {
+						return std::string{ "value_" + std::to_string( key ) };
+					} );
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		// Verify all entries were created
+		EXPECT_EQ( cache.size(), numThreads * itemsPerThread );
+
+		// Verify all values are accessible
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			for ( int i{ 0 }; i < itemsPerThread; ++i )
+			{
+				int key{ t * itemsPerThread + i };
+				auto result = cache.tryGet( key );
+				ASSERT_TRUE( result.has_value() );
+				EXPECT_EQ( result->get(), "value_" + std::to_string( key ) );
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Single-flight loading
+	//----------------------------------------------
+
+	TEST( LruCacheSingleFlight, ConcurrentMissesShareOneFactoryCall )
+	{
+		LruCache<std::string, int> cache;
+
+		std::atomic<int> factoryCalls{ 0 };
+		const int numThreads{ 8 };
+		std::vector<int> results( numThreads, 0 );
+		std::vector<std::thread> threads;
+
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			threads.emplace_back( [&cache, &factoryCalls, &results, t]() {
+				results[t] = cache.getOrCreate( "shared", [&factoryCalls]() {
+					++factoryCalls;
+					std::this_thread::sleep_for( std::chrono::milliseconds{ 50 } );
+					return 42;
+				} );
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_EQ( factoryCalls.load(), 1 );
+		for ( int result : results )
+		{
+			EXPECT_EQ( result, 42 );
+		}
+	}
+
+	TEST( LruCacheSingleFlight, SlowFactoryDoesNotBlockOtherKeys )
+	{
+		LruCache<int, int> cache;
+		cache.getOrCreate( 0, []() { return 0; } );
+
+		std::atomic<bool> factoryStarted{ false };
+		std::atomic<bool> releaseFactory{ false };
+
+		std::thread loader( [&]() {
+			cache.getOrCreate( 1, [&]() {
+				factoryStarted = true;
+				while ( !releaseFactory )
+				{
+					std::this_thread::sleep_for( std::chrono::milliseconds{ 1 } );
+				}
+				return 1;
+			} );
+		} );
+
+		while ( !factoryStarted )
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds{ 1 } );
+		}
+
+		// Runs while the factory for key 1 is still blocked
+		EXPECT_TRUE( cache.tryGet( 0 ).has_value() );
+		EXPECT_EQ( cache.getOrCreate( 2, []() { return 2; } ), 2 );
+		EXPECT_FALSE( cache.tryGet( 1 ).has_value() );
+
+		releaseFactory = true;
+		loader.join();
+
+		auto result = cache.tryGet( 1 );
+		ASSERT_TRUE( result.has_value() );
+		EXPECT_EQ( result->get(), 1 );
+	}
+
+	TEST( LruCacheSingleFlight, FactoryExceptionPropagatesToWaiters )
+	{
+		LruCache<int, int> cache;
+
+		std::atomic<int> failures{ 0 };
+		const int numThreads{ 4 };
+		std::vector<std::thread> threads;
+
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			threads.emplace_back( [&cache, &failures]() {
+				try
+				{
+					cache.getOrCreate( 7, []() -> int {
+						std::this_thread::sleep_for( std::chrono::milliseconds{ 30 } );
+						throw std::runtime_error{ "load failed" };
+					} );
+				}
+				catch ( const std::runtime_error& )
+				{
+					++failures;
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_EQ( failures.load(), numThreads );
+		EXPECT_TRUE( cache.isEmpty() );
+
+		// Nothing was cached, so the next call loads again
+		EXPECT_EQ( cache.getOrCreate( 7, []() { return 7; } ), 7 );
+	}
+
+	//----------------------------------------------
+	// Read buffering
+	//----------------------------------------------
+
+	TEST( LruCacheReadBuffering, BufferedHitsPreserveLruOrder )
+	{
+		LruCache<std::string, int> cache( LruCacheOptions{ 3, std::chrono::hours{ 1 } }.withReadBuffering( true ) );
+
+		cache.getOrCreate( "oldest", []() { return 1; } );
+		cache.getOrCreate( "middle", []() { return 2; } );
+		cache.getOrCreate( "newest", []() { return 3; } );
+
+		// Hit is served under the shared lock and only buffered
+		ASSERT_TRUE( cache.tryGet( "oldest" ).has_value() );
+
+		// Insertion drains the buffer first, so "middle" is now the LRU entry
+		cache.getOrCreate( "fourth", []() { return 4; } );
+
+		EXPECT_TRUE( cache.tryGet( "oldest" ).has_value() );
+		EXPECT_FALSE( cache.tryGet( "middle" ).has_value() );
+		EXPECT_TRUE( cache.tryGet( "newest" ).has_value() );
+		EXPECT_TRUE( cache.tryGet( "fourth" ).has_value() );
+	}
+
+	TEST( LruCacheReadBuffering, BufferOverflowFallsBackToExclusivePath )
+	{
+		LruCache<int, int> cache( LruCacheOptions{ 2, std::chrono::hours{ 1 } }.withReadBuffering( true ) );
+
+		cache.getOrCreate( 1, []() { return 1; } );
+		cache.getOrCreate( 2, []() { return 2; } );
+
+		// Far more hits than a single read buffer holds
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			ASSERT_TRUE( cache.tryGet( 1 ).has_value() );
+			ASSERT_EQ( cache.getOrCreate( 1, []() { return -1; } ), 1 );
+		}
+
+		cache.getOrCreate( 3, []() { return 3; } );
+
+		EXPECT_TRUE( cache.tryGet( 1 ).has_value() );
+		EXPECT_FALSE( cache.tryGet( 2 ).has_value() );
+		EXPECT_EQ( cache.size(), 2 );
+	}
+
+	TEST( LruCacheReadBuffering, SharedHitsRefreshSlidingExpiration )
+	{
+		LruCache<std::string, int> cache( LruCacheOptions{ 0, std::chrono::milliseconds( 100 ) }.withReadBuffering( true ) );
+
+		cache.getOrCreate( "key", []() { return 1; } );
+
+		for ( int i{ 0 }; i < 4; ++i )
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+			EXPECT_TRUE( cache.tryGet( "key" ).has_value() );
+		}
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 120 ) );
+		EXPECT_FALSE( cache.tryGet( "key" ).has_value() );
+		EXPECT_EQ( cache.size(), 0 );
+	}
+
+	TEST( LruCacheReadBuffering, ConcurrentHitsAndEvictions )
+	{
+		LruCache<int, int> cache( LruCacheOptions{ 64, std::chrono::hours{ 1 } }.withReadBuffering( true ) );
+
+		const int numThreads{ 8 };
+		std::vector<std::thread> threads;
+
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			threads.emplace_back( [&cache, t]() {
+				for ( int i{ 0 }; i < 5000; ++i )
+				{
+					// Hot keys shared by all threads plus a cold stream forcing evictions.
+					// References may be invalidated by concurrent evictions, so they are not read here.
+					int key{ ( i % 4 == 0 ) ? 1000 + t * 5000 + i : i % 32 };
+					cache.getOrCreate( key, [key]() { return key; } );
+					cache.tryGet( i % 32 );
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_LE( cache.size(), 64 );
+
+		for ( int key{ 0 }; key < 32; ++key )
+		{
+			EXPECT_EQ( cache.getOrCreate( key, [key]() { return key; } ), key );
+		}
+	}
+
+	//----------------------------------------------
+	// Statistics
+	//----------------------------------------------
+
+	TEST( LruCacheStatistics, DisabledByDefault )
+	{
+		LruCache<std::string, int> cache;
+
+		cache.getOrCreate( "key", []() { return 1; } );
+		cache.tryGet( "key" );
+
+		auto stats = cache.stats();
+		EXPECT_EQ( stats.requestCount(), 0 );
+		EXPECT_EQ( stats.loadSuccessCount, 0 );
+	}
+
+	TEST( LruCacheStatistics, CountsHitsMissesAndLoads )
+	{
+		LruCache<std::string, int> cache( LruCacheOptions{}.withStatistics( true ) );
+
+		cache.getOrCreate( "key1", []() { return 1; } ); // miss + load
+		cache.getOrCreate( "key1", []() { return 2; } ); // hit
+		cache.tryGet( "key1" );							 // hit
+		cache.tryGet( "missing" );						 // miss
+
+		auto stats = cache.stats();
+		EXPECT_EQ( stats.hitCount, 2 );
+		EXPECT_EQ( stats.missCount, 2 );
+		EXPECT_EQ( stats.loadSuccessCount, 1 );
+		EXPECT_EQ( stats.loadFailureCount, 0 );
+		EXPECT_DOUBLE_EQ( stats.hitRatio(), 0.5 );
+
+		std::uint64_t histogramTotal{ 0 };
+		for ( auto count : stats.loadLatencyBuckets )
+		{
+			histogramTotal += count;
+		}
+		EXPECT_EQ( histogramTotal, 1 );
+	}
+
+	TEST( LruCacheStatistics, CountsLoadFailures )
+	{
+		LruCache<int, int> cache( LruCacheOptions{}.withStatistics( true ) );
+
+		EXPECT_THROW( cache.getOrCreate( 1, []() -> int { throw std::runtime_error{ "load failed" }; } ), std::runtime_error );
+		EXPECT_TRUE( cache.isEmpty() );
+
+		auto stats = cache.stats();
+		EXPECT_EQ( stats.missCount, 1 );
+		EXPECT_EQ( stats.loadSuccessCount, 0 );
+		EXPECT_EQ( stats.loadFailureCount, 1 );
+	}
+
+	TEST( LruCacheStatistics, CountsEvictionsAndExpirations )
+	{
+		LruCache<int, int> cache( LruCacheOptions{ 2, std::chrono::milliseconds{ 20 } }.withStatistics( true ) );
+
+		cache.getOrCreate( 1, []() { return 1; } );
+		cache.getOrCreate( 2, []() { return 2; } );
+		cache.getOrCreate( 3, []() { return 3; } ); // evicts 1
+
+		std::this_thread::sleep_for( std::chrono::milliseconds{ 30 } );
+		cache.cleanupExpired();
+
+		auto stats = cache.stats();
+		EXPECT_EQ( stats.evictionCount, 1 );
+		EXPECT_EQ( stats.expirationCount, 2 );
+	}
+
+	TEST( LruCacheStatistics, ReadBufferedHitsCounted )
+	{
+		LruCache<int, int> cache( LruCacheOptions{}.withReadBuffering( true ).withStatistics( true ) );
 
-		// Second call should not invoke factory
-		auto& value2 = cache.getOrCreate( "factory_key", factory );
-		EXPECT_EQ( value2, "factory_value" );
-		EXPECT_EQ( factoryCallCount, 1 );
+		cache.getOrCreate( 1, []() { return 1; } );
+		for ( int i{ 0 }; i < 10; ++i )
+		{
+			cache.tryGet( 1 );
+		}
+		cache.tryGet( 2 );
+
+		auto stats = cache.stats();
+		EXPECT_EQ( stats.hitCount, 10 );
+		EXPECT_EQ( stats.missCount, 2 );
 	}
 
-	TEST( LruCacheFactory, ConfigurationFunction )
+	TEST( LruCacheStatistics, ExportFormats )
 	{
-		LruCache<std::string, std::string> cache;
+		LruCache<int, int> cache( LruCacheOptions{}.withStatistics( true ) );
 
-		bool configCalled{ false };
-		auto configFunc = [&configCalled]( CacheEntry& entry ) {
-			configCalled = true;
-			entry.slidingExpiration = { std::chrono::minutes( 5 ) };
-			entry.size = { 100 };
-		};
+		cache.getOrCreate( 1, []() { return 1; } );
+		cache.tryGet( 1 );
 
-		cache.getOrCreate( "config_key", []() { return std::string{ "config_value" }; }, configFunc );
+		auto stats = cache.stats();
 
-		EXPECT_TRUE( configCalled );
+		auto json = stats.toJson();
+		EXPECT_NE( json.find( "\"hits\":1" ), std::string::npos );
+		EXPECT_NE( json.find( "\"misses\":1" ), std::string::npos );
+		EXPECT_NE( json.find( "\"loadSuccesses\":1" ), std::string::npos );
+
+		auto prometheus = stats.toPrometheus( "app_cache" );
+		EXPECT_NE( prometheus.find( "# TYPE app_cache_hits_total counter" ), std::string::npos );
+		EXPECT_NE( prometheus.find( "app_cache_hits_total 1\n" ), std::string::npos );
+		EXPECT_NE( prometheus.find( "app_cache_load_duration_seconds_bucket{le=\"+Inf\"} 1\n" ), std::string::npos );
+		EXPECT_NE( prometheus.find( "app_cache_load_duration_seconds_count 1\n" ), std::string::npos );
 	}
 
 	//----------------------------------------------
-	// Value type tests
+	// Removal listener
 	//----------------------------------------------
 
-	TEST( LruCacheValueTypes, ComplexValues )
+	TEST( LruCacheRemovalListener, ReportsEveryCause )
 	{
-		struct ComplexValue
-		{
-			std::string name;
-			std::vector<int> data;
-			double weight;
+		LruCache<int, int> cache( LruCacheOptions{ 2, std::chrono::milliseconds{ 50 } } );
 
-			ComplexValue( std::string n, std::vector<int> d, double w )
-				: name{ std::move( n ) }, data{ std::move( d ) }, weight{ w } {}
-		};
+		std::vector<std::pair<int, RemovalCause>> removals;
+		cache.setRemovalListener( [&removals]( const int& key, int&&, RemovalCause cause ) { removals.emplace_back( key, cause ); } );
 
-		LruCache<std::string, ComplexValue> cache;
+		cache.getOrCreate( 1, []() { return 1; } );
+		cache.getOrCreate( 2, []() { return 2; } );
+		cache.getOrCreate( 3, []() { return 3; } ); // evicts 1
+		ASSERT_EQ( removals.size(), 1 );
+		EXPECT_EQ( removals[0], std::make_pair( 1, RemovalCause::Size ) );
 
-		auto factory = []() {
-			return ComplexValue{ "test", { 1, 2, 3, 4, 5 }, 3.14 };
-		};
+		EXPECT_TRUE( cache.remove( 2 ) );
+		ASSERT_EQ( removals.size(), 2 );
+		EXPECT_EQ( removals[1], std::make_pair( 2, RemovalCause::Explicit ) );
 
-		auto& value = cache.getOrCreate( "complex_key", factory );
-		EXPECT_EQ( value.name, "test" );
-		EXPECT_EQ( value.data.size(), 5 );
-		EXPECT_DOUBLE_EQ( value.weight, 3.14 );
+		std::this_thread::sleep_for( std::chrono::milliseconds{ 60 } );
+		cache.cleanupExpired();
+		ASSERT_EQ( removals.size(), 3 );
+		EXPECT_EQ( removals[2], std::make_pair( 3, RemovalCause::Expired ) );
+
+		cache.getOrCreate( 4, []() { return 4; } );
+		cache.getOrCreate( 5, []() { return 5; } );
+		cache.clear();
+		ASSERT_EQ( removals.size(), 5 );
+		EXPECT_EQ( removals[3].second, RemovalCause::Cleared );
+		EXPECT_EQ( removals[4].second, RemovalCause::Cleared );
 	}
 
-	TEST( LruCacheValueTypes, MoveSemantics )
+	TEST( LruCacheRemovalListener, ValueOwnershipTransferred )
 	{
-		LruCache<std::string, std::unique_ptr<std::string>> cache;
+		LruCache<int, std::unique_ptr<std::string>> cache( LruCacheOptions{ 1 } );
 
-		auto factory = []() {
-			return std::make_unique<std::string>( "unique_value" );
-		};
+		std::vector<std::unique_ptr<std::string>> released;
+		cache.setRemovalListener( [&released]( const int&, std::unique_ptr<std::string>&& value, RemovalCause ) { released.push_back( std::move( value ) ); } );
 
-		auto& ptr = cache.getOrCreate( "unique_key", factory );
-		ASSERT_NE( ptr, nullptr );
-		EXPECT_EQ( *ptr, "unique_value" );
-	}
+		cache.getOrCreate( 1, []() { return std::make_unique<std::string>( "first" ); } );
+		cache.getOrCreate( 2, []() { return std::make_unique<std::string>( "second" ); } );
 
-	//----------------------------------------------
-	// Thread safety
-	//----------------------------------------------
+		ASSERT_EQ( released.size(), 1 );
+		ASSERT_NE( released[0], nullptr );
+		EXPECT_EQ( *released[0], "first" );
+	}
 
-	TEST( LruCacheThreadSafety, ConcurrentAccess )
+	TEST( LruCacheRemovalListener, DeliveredOutsideLock )
 	{
-		LruCache<int, std::string> cache;
+		LruCache<int, int> cache( LruCacheOptions{ 1 } );
 
-		const int numThreads{ 10 };
-		const int itemsPerThread{ 100 };
-		std::vector<std::thread> threads;
+		// Re-entering the cache would deadlock if the listener ran under the mutex
+		std::size_t observedSize{ 0 };
+		cache.setRemovalListener( [&cache, &observedSize]( const int&, int&&, RemovalCause ) {
+			observedSize = cache.size();
+			cache.tryGet( 0 );
+		} );
 
-		// Concurrent insertions
-		for ( int t{ 0 }; t < numThreads; ++t )
-		{
-			threads.emplace_back( [&cache, t]() {
-				for ( int i{ 0 }; i < itemsPerThread; ++i )
-				{
-					int key{ t * itemsPerThread + i };
-					cache.getOrCreate( key, [key]() {
-						return std::string{ "value_" + std::to_string( key ) };
-					} );
-				}
-			} );
-		}
+		cache.getOrCreate( 1, []() { return 1; } );
+		cache.getOrCreate( 2, []() { return 2; } );
 
-		for ( auto& thread : threads )
-		{
-			thread.join();
-		}
+		EXPECT_EQ( observedSize, 1 );
+	}
 
-		// Verify all entries were created
-		EXPECT_EQ( cache.size(), numThreads * itemsPerThread );
+	TEST( LruCacheRemovalListener, ThrowingListenerDoesNotLoseNotifications )
+	{
+		LruCache<int, int> cache;
 
-		// Verify all values are accessible
-		for ( int t{ 0 }; t < numThreads; ++t )
-		{
-			for ( int i{ 0 }; i < itemsPerThread; ++i )
-			{
-				int key{ t * itemsPerThread + i };
-				auto result = cache.tryGet( key );
-				ASSERT_TRUE( result.has_value() );
-				EXPECT_EQ( result->get(), "value_" + std::to_string( key ) );
-			}
-		}
+		int calls{ 0 };
+		cache.setRemovalListener( [&calls]( const int&, int&&, RemovalCause ) {
+			++calls;
+			throw std::runtime_error{ "listener failed" };
+		} );
+
+		cache.getOrCreate( 1, []() { return 1; } );
+		cache.getOrCreate( 2, []() { return 2; } );
+
+		EXPECT_NO_THROW( cache.clear() );
+		EXPECT_EQ( calls, 2 );
+		EXPECT_TRUE( cache.isEmpty() );
 	}
 
 	//----------------------------------------------
@@ -588,6 +1962,56 @@ namespace nfx::memory::test
 		EXPECT_GT( finalSize, 0 );			// But not necessarily all at once
 	}
 
+	TEST( LruCacheBackgroundCleanup, SweepBoundedPerOperationAndResumes )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 20 ), std::chrono::milliseconds( 1 ) } };
+		for ( int i = 0; i < 100; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+
+		// Each operation visits a bounded number of entries from the LRU tail
+		EXPECT_FALSE( cache.tryGet( -1 ).has_value() );
+		EXPECT_EQ( cache.size(), 90 );
+
+		// The unfinished sweep continues on the next operations without waiting for the interval
+		for ( int i = 0; i < 9; ++i )
+		{
+			EXPECT_FALSE( cache.tryGet( -1 ).has_value() );
+		}
+		EXPECT_EQ( cache.size(), 0 );
+	}
+
+	TEST( LruCacheBackgroundCleanup, SweepWithCustomExpirations )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::hours( 1 ), std::chrono::milliseconds( 1 ) } };
+		for ( int i = 0; i < 100; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; }, [i]( CacheEntry& entry ) {
+				if ( i % 2 == 0 )
+				{
+					entry.slidingExpiration = std::chrono::milliseconds( 20 );
+				}
+			} );
+		}
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+
+		EXPECT_FALSE( cache.tryGet( -1 ).has_value() );
+		EXPECT_GE( cache.size(), 90 );
+
+		for ( int i = 0; i < 20; ++i )
+		{
+			EXPECT_FALSE( cache.tryGet( -1 ).has_value() );
+		}
+
+		// Only the short-lived half expired, the long-lived entries were never visited
+		EXPECT_EQ( cache.size(), 50 );
+		EXPECT_TRUE( cache.tryGet( 1 ).has_value() );
+	}
+
 	TEST( LruCacheBackgroundCleanup, CleanupTimingAccuracy )
 	{
 		// Test that cleanup happens at the right intervals
@@ -719,4 +2143,350 @@ namespace nfx::memory::test
 		// At least some entries should be accessible
 		EXPECT_GT( accessibleCount, 0 ) << "Should have at least some accessible entries after concurrent operations";
 	}
+
+	//----------------------------------------------
+	// Maintenance thread
+	//----------------------------------------------
+
+	TEST( LruCacheMaintenance, IdleCacheShrinks )
+	{
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 20 ) }.withMaintenance( std::chrono::milliseconds( 5 ) ) };
+		for ( int i = 0; i < 1000; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		// No further operations, the maintenance thread removes the expired entries
+		for ( int i = 0; i < 200 && !cache.isEmpty(); ++i )
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+		}
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( LruCacheMaintenance, ErasedValuesDestroyedOnMaintenanceThread )
+	{
+		struct Tracked
+		{
+			std::shared_ptr<std::atomic<std::thread::id>> destroyedOn;
+
+			~Tracked()
+			{
+				if ( destroyedOn )
+				{
+					destroyedOn->store( std::this_thread::get_id() );
+				}
+			}
+		};
+
+		auto destroyedOn{ std::make_shared<std::atomic<std::thread::id>>() };
+		LruCache<int, Tracked> cache{ LruCacheOptions{}.withMaintenance( std::chrono::milliseconds( 5 ) ) };
+		cache.getOrCreate( 1, [&destroyedOn]() { return Tracked{ destroyedOn }; } );
+		destroyedOn->store( std::thread::id{} );
+
+		EXPECT_TRUE( cache.remove( 1 ) );
+		EXPECT_EQ( destroyedOn->load(), std::thread::id{} );
+
+		for ( int i = 0; i < 200 && destroyedOn->load() == std::thread::id{}; ++i )
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+		}
+		EXPECT_NE( destroyedOn->load(), std::thread::id{} );
+		EXPECT_NE( destroyedOn->load(), std::this_thread::get_id() );
+	}
+
+	TEST( LruCacheMaintenance, SlabNodesFreedUnderLock )
+	{
+		struct Tracked
+		{
+			std::shared_ptr<std::atomic<std::thread::id>> destroyedOn;
+
+			Tracked() = default;
+			Tracked( Tracked&& ) noexcept = default;
+			Tracked& operator=( Tracked&& ) noexcept = default;
+
+			~Tracked()
+			{
+				if ( destroyedOn )
+				{
+					destroyedOn->store( std::this_thread::get_id() );
+				}
+			}
+		};
+
+		using Allocator = SlabAllocator<std::pair<const int, Tracked>>;
+		LruCache<int, Tracked, std::hash<int>, std::equal_to<int>, NodeStorage, Allocator> cache{ LruCacheOptions{ 100 }.withMaintenance( std::chrono::milliseconds( 1 ) ) };
+
+		// Maintenance runs concurrently with insertions allocating from the same arena
+		auto destroyedOn{ std::make_shared<std::atomic<std::thread::id>>() };
+		for ( int i = 0; i < 5000; ++i )
+		{
+			cache.getOrCreate( i, [&destroyedOn, i]() {
+				Tracked tracked;
+				if ( i == 0 )
+				{
+					tracked.destroyedOn = destroyedOn;
+				}
+				return tracked;
+			} );
+		}
+
+		// The value of the first evicted entry moved out of its node, and was destroyed off this thread
+		for ( int i = 0; i < 200 && destroyedOn->load() == std::thread::id{}; ++i )
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+		}
+		EXPECT_NE( destroyedOn->load(), std::thread::id{} );
+		EXPECT_NE( destroyedOn->load(), std::this_thread::get_id() );
+		EXPECT_EQ( cache.size(), 100 );
+	}
+
+	TEST( LruCacheMaintenance, DeferredDestructionIsBounded )
+	{
+		// No maintenance run during the test, values beyond the cap are released right away
+		LruCache<int, std::shared_ptr<int>> cache{ LruCacheOptions{ 10 }.withMaintenance( std::chrono::hours( 1 ) ) };
+
+		std::vector<std::weak_ptr<int>> values;
+		for ( int i = 0; i < 1000; ++i )
+		{
+			auto value{ std::make_shared<int>( i ) };
+			values.push_back( value );
+			cache.getOrCreate( i, [&value]() { return std::move( value ); } );
+		}
+
+		std::size_t released{ 0 };
+		for ( const auto& value : values )
+		{
+			released += value.expired() ? 1 : 0;
+		}
+		EXPECT_GE( released, 1000 - 10 - 256 );
+		EXPECT_LT( released, 1000 - 10 );
+	}
+
+	TEST( LruCacheMaintenance, SharedThreadReleasedByDestructors )
+	{
+		auto thread{ std::make_shared<MaintenanceThread>() };
+		const auto options{ LruCacheOptions{ 0, std::chrono::milliseconds( 1 ) }.withMaintenance( std::chrono::milliseconds( 1 ), thread ) };
+
+		for ( int round = 0; round < 20; ++round )
+		{
+			std::vector<std::unique_ptr<LruCache<int, std::string>>> caches;
+			for ( int i = 0; i < 4; ++i )
+			{
+				caches.push_back( std::make_unique<LruCache<int, std::string>>( options ) );
+				caches.back()->getOrCreate( i, [i]() { return std::to_string( i ); } );
+			}
+			EXPECT_EQ( thread->taskCount(), 4 );
+
+			// Destroyed while maintenance may be running on them
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		}
+
+		EXPECT_EQ( thread->taskCount(), 0 );
+	}
+
+	TEST( LruCacheMaintenance, OperationsSkipInlineCleanup )
+	{
+		// Interval far beyond the test, inline cleanup would otherwise run on every operation
+		LruCache<int, int> cache{ LruCacheOptions{ 0, std::chrono::milliseconds( 10 ), std::chrono::milliseconds( 1 ) }.withMaintenance( std::chrono::hours( 1 ) ) };
+		cache.getOrCreate( 1, []() { return 1; } );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+		cache.getOrCreate( 2, []() { return 2; } );
+
+		EXPECT_EQ( cache.size(), 2 );
+	}
+
+	//----------------------------------------------
+	// Refresh after write
+	//----------------------------------------------
+
+	TEST( LruCacheRefresh, StaleHitServesValueAndReloadsOnce )
+	{
+		using Cache = LruCache<int, std::shared_ptr<const int>>;
+
+		int loads{ 0 };
+		std::vector<std::function<void()>> tasks;
+		Cache cache{ LruCacheOptions{}.withRefreshAfterWrite( std::chrono::milliseconds( 20 ), [&tasks]( std::function<void()> task ) { tasks.push_back( std::move( task ) ); } ),
+			[&loads]( const int& ) { return std::make_shared<const int>( ++loads ); } };
+
+		std::vector<std::pair<int, RemovalCause>> removals;
+		cache.setRemovalListener( [&removals]( const int&, std::shared_ptr<const int>&& value, RemovalCause cause ) { removals.emplace_back( *value, cause ); } );
+
+		// Misses load on the calling thread
+		EXPECT_EQ( *cache.get( 1 ), 1 );
+		EXPECT_EQ( *cache.get( 1 ), 1 );
+		EXPECT_TRUE( tasks.empty() );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
+
+		// Stale hits return the current value, only the first submits a reload
+		const auto stale{ cache.get( 1 ) };
+		EXPECT_EQ( *stale, 1 );
+		EXPECT_EQ( *cache.get( 1 ), 1 );
+		ASSERT_EQ( tasks.size(), 1 );
+		EXPECT_EQ( loads, 1 );
+
+		tasks[0]();
+		EXPECT_EQ( loads, 2 );
+		EXPECT_EQ( *cache.get( 1 ), 2 );
+		ASSERT_EQ( removals.size(), 1 );
+		EXPECT_EQ( removals[0], std::make_pair( 1, RemovalCause::Replaced ) );
+
+		// The copy handed out before the refresh is untouched
+		EXPECT_EQ( *stale, 1 );
+
+		// The refreshed value is fresh again
+		EXPECT_EQ( *cache.get( 1 ), 2 );
+		EXPECT_EQ( tasks.size(), 1 );
+	}
+
+	TEST( LruCacheRefresh, FailedReloadKeepsValue )
+	{
+		using Cache = LruCache<int, std::shared_ptr<const int>>;
+
+		bool fail{ false };
+		std::vector<std::function<void()>> tasks;
+		Cache cache{ LruCacheOptions{}.withStatistics( true ).withRefreshAfterWrite( std::chrono::milliseconds( 20 ), [&tasks]( std::function<void()> task ) { tasks.push_back( std::move( task ) ); } ),
+			[&fail]( const int& ) {
+				if ( fail )
+				{
+					throw std::runtime_error{ "reload failed" };
+				}
+				return std::make_shared<const int>( 7 );
+			} };
+
+		static_cast<void>( cache.get( 1 ) );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
+
+		fail = true;
+		EXPECT_EQ( *cache.get( 1 ), 7 );
+		ASSERT_EQ( tasks.size(), 1 );
+		EXPECT_NO_THROW( tasks[0]() );
+		EXPECT_EQ( cache.stats().loadFailureCount, 1 );
+
+		// Still stale, the next hit tries again
+		EXPECT_EQ( *cache.get( 1 ), 7 );
+		EXPECT_EQ( tasks.size(), 2 );
+	}
+
+	TEST( LruCacheRefresh, FailedMissLoadCachesNothing )
+	{
+		using Cache = LruCache<int, std::shared_ptr<const int>>;
+
+		Cache cache{ LruCacheOptions{}.withRefreshAfterWrite( std::chrono::seconds( 1 ), []( std::function<void()> task ) { task(); } ),
+			[]( const int& ) -> std::shared_ptr<const int> { throw std::runtime_error{ "load failed" }; } };
+
+		EXPECT_THROW( static_cast<void>( cache.get( 1 ) ), std::runtime_error );
+		EXPECT_EQ( cache.size(), 0 );
+	}
+
+	TEST( LruCacheRefresh, ReadersRaceRefreshes )
+	{
+		using Cache = LruCache<int, std::shared_ptr<const int>>;
+
+		// Refreshes run inline on the reading thread, concurrently with the other readers
+		std::atomic<int> loads{ 0 };
+		Cache cache{ LruCacheOptions{}.withRefreshAfterWrite( std::chrono::milliseconds( 1 ), []( std::function<void()> task ) { task(); } ),
+			[&loads]( const int& ) { return std::make_shared<const int>( ++loads ); } };
+
+		std::vector<std::thread> readers;
+		std::atomic<bool> failed{ false };
+		for ( int t = 0; t < 4; ++t )
+		{
+			readers.emplace_back( [&cache, &failed]() {
+				const auto deadline{ std::chrono::steady_clock::now() + std::chrono::milliseconds( 50 ) };
+				while ( std::chrono::steady_clock::now() < deadline )
+				{
+					const auto value{ cache.get( 1 ) };
+					if ( !value || *value < 1 )
+					{
+						failed = true;
+					}
+				}
+			} );
+		}
+
+		for ( auto& reader : readers )
+		{
+			reader.join();
+		}
+
+		EXPECT_FALSE( failed );
+		EXPECT_GT( loads.load(), 1 );
+	}
+
+	TEST( LruCacheRefresh, QueuedReloadOutlivingCacheDoesNothing )
+	{
+		using Cache = LruCache<int, std::shared_ptr<const int>>;
+
+		int loads{ 0 };
+		std::vector<std::function<void()>> tasks;
+		{
+			Cache cache{ LruCacheOptions{}.withRefreshAfterWrite( std::chrono::milliseconds( 1 ), [&tasks]( std::function<void()> task ) { tasks.push_back( std::move( task ) ); } ),
+				[&loads]( const int& ) { return std::make_shared<const int>( ++loads ); } };
+			static_cast<void>( cache.get( 1 ) );
+			std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+			static_cast<void>( cache.get( 1 ) );
+		}
+
+		ASSERT_EQ( tasks.size(), 1 );
+		tasks[0]();
+		EXPECT_EQ( loads, 1 );
+	}
+
+	TEST( LruCacheRefresh, ReferenceLookupsThrow )
+	{
+		using Cache = LruCache<int, std::shared_ptr<const int>>;
+
+		Cache cache{ LruCacheOptions{}.withRefreshAfterWrite( std::chrono::seconds( 1 ), []( std::function<void()> task ) { task(); } ),
+			[]( const int& key ) { return std::make_shared<const int>( key ); } };
+		static_cast<void>( cache.get( 1 ) );
+
+		// References to the handle would race with its replacement
+		EXPECT_THROW( cache.getOrCreate( 1, []() { return std::make_shared<const int>( 0 ); } ), std::logic_error );
+		EXPECT_THROW( static_cast<void>( cache.tryGet( 1 ) ), std::logic_error );
+		EXPECT_THROW( static_cast<void>( cache.getOrLoad( 1, []() -> CacheTask<std::shared_ptr<const int>> { co_return nullptr; } ) ), std::logic_error );
+
+		// Without refresh after write there is no reload function to load with
+		LruCache<int, std::shared_ptr<const int>> plain;
+		EXPECT_THROW( static_cast<void>( plain.get( 1 ) ), std::logic_error );
+	}
+
+	TEST( LruCacheRefresh, ShardedReferenceLookupsThrow )
+	{
+		using Cache = ShardedLruCache<int, std::shared_ptr<const int>>;
+
+		Cache cache{ LruCacheOptions{}.withRefreshAfterWrite( std::chrono::seconds( 1 ), []( std::function<void()> task ) { task(); } ), 4,
+			[]( const int& key ) { return std::make_shared<const int>( key ); } };
+		EXPECT_EQ( *cache.get( 1 ), 1 );
+
+		// Batches are split across shards without going through their tryGetMany()
+		const std::vector<int> keys{ 1, 2 };
+		std::vector<std::optional<std::reference_wrapper<std::shared_ptr<const int>>>> values( keys.size() );
+		EXPECT_THROW( static_cast<void>( cache.tryGetMany( keys, values ) ), std::logic_error );
+		EXPECT_THROW( static_cast<void>( cache.tryGet( 1 ) ), std::logic_error );
+	}
+
+	TEST( LruCacheRefresh, RejectsInvalidOptions )
+	{
+		using Cache = LruCache<int, std::shared_ptr<const int>>;
+
+		const Cache::ReloadFunction reload{ []( const int& key ) { return std::make_shared<const int>( key ); } };
+		const CacheExecutor executor{ []( std::function<void()> task ) { task(); } };
+
+		// No executor
+		EXPECT_THROW( ( Cache{ LruCacheOptions{}.withRefreshAfterWrite( std::chrono::seconds( 1 ), nullptr ), reload } ), std::invalid_argument );
+
+		// No reload function
+		EXPECT_THROW( ( Cache{ LruCacheOptions{}.withRefreshAfterWrite( std::chrono::seconds( 1 ), executor ) } ), std::invalid_argument );
+		EXPECT_THROW( ( Cache{ LruCacheOptions{}.withRefreshAfterWrite( std::chrono::seconds( 1 ), executor ), Cache::ReloadFunction{} } ), std::invalid_argument );
+
+		// Reload function without refresh after write
+		EXPECT_THROW( ( Cache{ LruCacheOptions{}, reload } ), std::invalid_argument );
+
+		// Values that are not handles
+		EXPECT_THROW( ( LruCache<int, int>{ LruCacheOptions{}.withRefreshAfterWrite( std::chrono::seconds( 1 ), executor ), nullptr, []( const int& key ) { return key; } } ),
+			std::invalid_argument );
+	}
 } // namespace nfx::memory::test
@@ -0,0 +1,117 @@
+/**
+ * @file TESTS_MaintenanceThread.cpp
+ * @brief Tests for the MaintenanceThread periodic task runner
+ * @details Tests covering periodic runs, removal waiting for a run in progress,
+ *          self-removal and failing tasks
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <nfx/memory/MaintenanceThread.h>
+
+namespace nfx::memory::test
+{
+	using namespace std::chrono_literals;
+
+	/** @brief Sleep in small steps until a condition holds or a second has passed */
+	template <typename TCondition>
+	static bool waitFor( TCondition condition )
+	{
+		for ( int i{ 0 }; i < 200 && !condition(); ++i )
+		{
+			std::this_thread::sleep_for( 5ms );
+		}
+
+		return condition();
+	}
+
+	//=====================================================================
+	// MaintenanceThread Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Tasks
+	//----------------------------------------------
+
+	TEST( MaintenanceThread, RunsTasksPeriodically )
+	{
+		MaintenanceThread thread;
+		std::atomic<int> fast{ 0 };
+		std::atomic<int> slow{ 0 };
+
+		thread.add( [&fast]() { ++fast; }, 1ms );
+		thread.add( [&slow]() { ++slow; }, 1h );
+		EXPECT_EQ( thread.taskCount(), 2 );
+
+		EXPECT_TRUE( waitFor( [&fast]() { return fast.load() >= 5; } ) );
+		EXPECT_EQ( slow.load(), 0 );
+	}
+
+	TEST( MaintenanceThread, RemoveWaitsForRunInProgress )
+	{
+		MaintenanceThread thread;
+		std::atomic<bool> started{ false };
+		std::atomic<bool> finished{ false };
+
+		const auto id{ thread.add(
+			[&]() {
+				started = true;
+				std::this_thread::sleep_for( 50ms );
+				finished = true;
+			},
+			1ms ) };
+
+		ASSERT_TRUE( waitFor( [&started]() { return started.load(); } ) );
+		thread.remove( id );
+		EXPECT_TRUE( finished.load() );
+
+		// Never runs again
+		finished = false;
+		std::this_thread::sleep_for( 20ms );
+		EXPECT_FALSE( finished.load() );
+		EXPECT_EQ( thread.taskCount(), 0 );
+	}
+
+	TEST( MaintenanceThread, TaskMayRemoveItself )
+	{
+		MaintenanceThread thread;
+		std::atomic<int> runs{ 0 };
+		MaintenanceThread::TaskId id{ 0 };
+		std::atomic<bool> registered{ false };
+
+		id = thread.add(
+			[&]() {
+				if ( registered )
+				{
+					++runs;
+					thread.remove( id );
+				}
+			},
+			1ms );
+		registered = true;
+
+		EXPECT_TRUE( waitFor( [&thread]() { return thread.taskCount() == 0; } ) );
+		std::this_thread::sleep_for( 10ms );
+		EXPECT_EQ( runs.load(), 1 );
+	}
+
+	TEST( MaintenanceThread, FailingTaskKeepsRunning )
+	{
+		MaintenanceThread thread;
+		std::atomic<int> runs{ 0 };
+
+		thread.add(
+			[&runs]() {
+				++runs;
+				throw std::runtime_error{ "maintenance failed" };
+			},
+			1ms );
+
+		EXPECT_TRUE( waitFor( [&runs]() { return runs.load() >= 3; } ) );
+	}
+} // namespace nfx::memory::test
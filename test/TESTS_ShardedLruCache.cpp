@@ -0,0 +1,364 @@
+/**
+ * @file TESTS_ShardedLruCache.cpp
+ * @brief Tests for ShardedLruCache lock-striped caching
+ * @details Tests covering shard count derivation, size limit distribution,
+ *          aggregate operations and concurrent access across shards
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <nfx/memory/ShardedLruCache.h>
+#include <nfx/memory/SlabAllocator.h>
+
+namespace nfx::memory::test
+{
+	//=====================================================================
+	// ShardedLruCache Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Construction
+	//----------------------------------------------
+
+	TEST( ShardedLruCacheConstruction, DefaultConstruction )
+	{
+		ShardedLruCache<std::string, int> cache;
+
+		EXPECT_TRUE( cache.isEmpty() );
+		EXPECT_EQ( cache.size(), 0 );
+		EXPECT_GE( cache.shardCount(), 1 );
+	}
+
+	TEST( ShardedLruCacheConstruction, ShardCountRoundedToPowerOfTwo )
+	{
+		ShardedLruCache<int, int> cache( LruCacheOptions{}, 12 );
+
+		EXPECT_EQ( cache.shardCount(), 8 );
+	}
+
+	TEST( ShardedLruCacheConstruction, ShardCountBoundedBySizeLimit )
+	{
+		ShardedLruCache<int, int> cache( LruCacheOptions{ 3 }, 64 );
+
+		EXPECT_EQ( cache.shardCount(), 2 );
+	}
+
+	TEST( ShardedLruCacheConstruction, ShardCountBoundedByMaxWeight )
+	{
+		ShardedLruCache<int, int> cache( LruCacheOptions{}.withMaxWeight( 5 ), 64 );
+
+		EXPECT_EQ( cache.shardCount(), 4 );
+	}
+
+	//----------------------------------------------
+	// Basic operations
+	//----------------------------------------------
+
+	TEST( ShardedLruCacheOperations, GetOrCreateAndTryGet )
+	{
+		ShardedLruCache<std::string, std::string> cache( LruCacheOptions{}, 4 );
+
+		auto& value = cache.getOrCreate( "key1", []() { return std::string{ "value1" }; } );
+		EXPECT_EQ( value, "value1" );
+
+		auto& value2 = cache.getOrCreate( "key1", []() { return std::string{ "should_not_create" }; } );
+		EXPECT_EQ( value2, "value1" );
+
+		auto result = cache.tryGet( "key1" );
+		ASSERT_TRUE( result.has_value() );
+		EXPECT_EQ( result->get(), "value1" );
+		EXPECT_FALSE( cache.tryGet( "missing" ).has_value() );
+		EXPECT_EQ( cache.size(), 1 );
+	}
+
+	TEST( ShardedLruCacheOperations, AggregateOperations )
+	{
+		ShardedLruCache<int, int> cache( LruCacheOptions{}, 8 );
+
+		for ( int i{ 0 }; i < 256; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i * 2; } );
+		}
+		EXPECT_EQ( cache.size(), 256 );
+
+		EXPECT_TRUE( cache.remove( 10 ) );
+		EXPECT_FALSE( cache.remove( 10 ) );
+		EXPECT_EQ( cache.size(), 255 );
+
+		cache.clear();
+		EXPECT_TRUE( cache.isEmpty() );
+		EXPECT_EQ( cache.size(), 0 );
+	}
+
+	TEST( ShardedLruCacheOperations, HeterogeneousLookup )
+	{
+		struct StringHash
+		{
+			using is_transparent = void;
+
+			std::size_t operator()( std::string_view key ) const noexcept
+			{
+				return std::hash<std::string_view>{}( key );
+			}
+		};
+
+		ShardedLruCache<std::string, int, StringHash, std::equal_to<>> cache( LruCacheOptions{}, 8 );
+
+		for ( int i{ 0 }; i < 64; ++i )
+		{
+			const std::string key{ "key_" + std::to_string( i ) };
+			cache.getOrCreate( std::string_view{ key }, [i]() { return i; } );
+		}
+
+		// Heterogeneous and owning keys must select the same shard
+		for ( int i{ 0 }; i < 64; ++i )
+		{
+			const std::string key{ "key_" + std::to_string( i ) };
+			auto result = cache.tryGet( std::string_view{ key } );
+			ASSERT_TRUE( result.has_value() );
+			EXPECT_EQ( result->get(), i );
+			EXPECT_TRUE( cache.tryGet( key ).has_value() );
+		}
+
+		EXPECT_TRUE( cache.remove( std::string_view{ "key_3" } ) );
+		EXPECT_EQ( cache.size(), 63 );
+	}
+
+	TEST( ShardedLruCacheOperations, BatchesSpanShards )
+	{
+		ShardedLruCache<int, int> cache( LruCacheOptions{}, 8 );
+
+		std::vector<std::pair<int, int>> entries;
+		for ( int i{ 0 }; i < 100; i += 2 )
+		{
+			entries.emplace_back( i, i * 3 );
+		}
+		EXPECT_EQ( cache.insertMany( entries ), std::vector<bool>( entries.size(), true ) );
+		EXPECT_EQ( cache.size(), 50 );
+
+		std::vector<int> keys;
+		for ( int i{ 99 }; i >= 0; --i )
+		{
+			keys.push_back( i );
+		}
+		std::vector<std::optional<std::reference_wrapper<int>>> values( keys.size() );
+		const auto hits{ cache.tryGetMany( keys, values ) };
+
+		// Results come back at the position of their key, whatever its shard
+		for ( std::size_t i{ 0 }; i < keys.size(); ++i )
+		{
+			EXPECT_EQ( hits[i], keys[i] % 2 == 0 );
+			if ( hits[i] )
+			{
+				EXPECT_EQ( values[i]->get(), keys[i] * 3 );
+			}
+		}
+	}
+
+	//----------------------------------------------
+	// Size limits and expiration
+	//----------------------------------------------
+
+	TEST( ShardedLruCacheLimits, TotalSizeLimitEnforced )
+	{
+		ShardedLruCache<int, int> cache( LruCacheOptions{ 100 }, 8 );
+
+		for ( int i{ 0 }; i < 10000; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		EXPECT_LE( cache.size(), 100 );
+		EXPECT_GT( cache.size(), 0 );
+	}
+
+	TEST( ShardedLruCacheLimits, TotalWeightLimitEnforced )
+	{
+		ShardedLruCache<int, std::string> cache(
+			LruCacheOptions{}.withMaxWeight( 4000 ),
+			4,
+			[]( const int&, const std::string& value ) { return value.size(); } );
+
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			cache.getOrCreate( i, []() { return std::string( 100, 'x' ); } );
+		}
+
+		EXPECT_LE( cache.totalWeight(), 4000 );
+		EXPECT_EQ( cache.totalWeight(), cache.size() * 100 );
+	}
+
+	TEST( ShardedLruCacheLimits, EntriesHeavierThanShardShareStayWithinTotalWeight )
+	{
+		// 50 units per shard, each entry weighs 16 shard shares and is admitted alone in its shard
+		ShardedLruCache<int, std::string> cache(
+			LruCacheOptions{}.withMaxWeight( 6400 ),
+			128,
+			[]( const int&, const std::string& value ) { return value.size(); } );
+		ASSERT_EQ( cache.shardCount(), 128 );
+
+		for ( int i{ 0 }; i < 1000; ++i )
+		{
+			cache.getOrCreate( i, []() { return std::string( 800, 'x' ); } );
+			ASSERT_LE( cache.totalWeight(), 6400 );
+		}
+
+		std::vector<std::pair<int, std::string>> batch;
+		for ( int i{ 1000 }; i < 1100; ++i )
+		{
+			batch.emplace_back( i, std::string( 800, 'y' ) );
+		}
+		cache.insertMany( std::span{ batch } );
+
+		EXPECT_LE( cache.totalWeight(), 6400 );
+		EXPECT_EQ( cache.totalWeight(), cache.size() * 800 );
+		EXPECT_GT( cache.size(), 0 );
+	}
+
+	TEST( ShardedLruCacheLimits, CleanupExpiredAllShards )
+	{
+		ShardedLruCache<int, int> cache( LruCacheOptions{ 0, std::chrono::milliseconds( 20 ) }, 4 );
+
+		for ( int i{ 0 }; i < 64; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+		EXPECT_EQ( cache.size(), 64 );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
+
+		cache.cleanupExpired();
+		EXPECT_TRUE( cache.isEmpty() );
+	}
+
+	TEST( ShardedLruCacheLimits, StatisticsAggregatedOverShards )
+	{
+		ShardedLruCache<int, int> cache( LruCacheOptions{}.withStatistics( true ), 4 );
+
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+			cache.tryGet( i );
+		}
+
+		auto stats = cache.stats();
+		EXPECT_EQ( stats.hitCount, 100 );
+		EXPECT_EQ( stats.missCount, 100 );
+		EXPECT_EQ( stats.loadSuccessCount, 100 );
+	}
+
+	TEST( ShardedLruCacheLimits, RemovalListenerSharedByShards )
+	{
+		ShardedLruCache<int, int> cache( LruCacheOptions{ 8 }, 4 );
+
+		std::atomic<int> evicted{ 0 };
+		cache.setRemovalListener( [&evicted]( const int&, int&&, RemovalCause cause ) {
+			if ( cause == RemovalCause::Size )
+			{
+				++evicted;
+			}
+		} );
+
+		for ( int i{ 0 }; i < 100; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		EXPECT_EQ( evicted.load(), 100 - static_cast<int>( cache.size() ) );
+	}
+
+	//----------------------------------------------
+	// Allocators
+	//----------------------------------------------
+
+	TEST( ShardedLruCacheAllocator, AllocatorFactoryFeedsEveryShard )
+	{
+		using Allocator = SlabAllocator<std::pair<const int, int>>;
+
+		std::vector<std::shared_ptr<SlabArena>> arenas;
+		ShardedLruCache<int, int, std::hash<int>, std::equal_to<int>, NodeStorage, Allocator> cache{ LruCacheOptions{ 1000 }, 4, nullptr,
+			[&arenas]( std::size_t shard ) {
+				EXPECT_EQ( shard, arenas.size() );
+				arenas.push_back( std::make_shared<SlabArena>( 4096 ) );
+				return Allocator{ arenas.back() };
+			} };
+
+		ASSERT_EQ( arenas.size(), cache.shardCount() );
+		for ( int i{ 0 }; i < 400; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return i; } );
+		}
+
+		for ( const auto& arena : arenas )
+		{
+			EXPECT_GT( arena->slabCount(), 0 );
+		}
+	}
+
+	TEST( ShardedLruCacheAllocator, PmrShardsShareResource )
+	{
+		std::pmr::synchronized_pool_resource resource;
+		ShardedLruCache<int, std::string, std::hash<int>, std::equal_to<int>, NodeStorage, std::pmr::polymorphic_allocator<std::pair<const int, std::string>>> cache{
+			LruCacheOptions{ 100 }, 4, nullptr, [&resource]( std::size_t ) { return std::pmr::polymorphic_allocator<std::pair<const int, std::string>>{ &resource }; } };
+
+		for ( int i{ 0 }; i < 200; ++i )
+		{
+			cache.getOrCreate( i, [i]() { return std::to_string( i ); } );
+		}
+
+		EXPECT_LE( cache.size(), 100 );
+		EXPECT_EQ( cache.tryGet( 199 )->get(), "199" );
+	}
+
+	//----------------------------------------------
+	// Thread safety
+	//----------------------------------------------
+
+	TEST( ShardedLruCacheThreadSafety, ConcurrentAccess )
+	{
+		ShardedLruCache<int, std::string> cache( LruCacheOptions{}, 16 );
+
+		const int numThreads{ 8 };
+		const int itemsPerThread{ 500 };
+		std::vector<std::thread> threads;
+
+		for ( int t{ 0 }; t < numThreads; ++t )
+		{
+			threads.emplace_back( [&cache, t]() {
+				for ( int i{ 0 }; i < itemsPerThread; ++i )
+				{
+					int key{ t * itemsPerThread + i };
+					cache.getOrCreate( key, [key]() { return "value_" + std::to_string( key ); } );
+					cache.tryGet( ( key * 7 ) % ( numThreads * itemsPerThread ) );
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		EXPECT_EQ( cache.size(), numThreads * itemsPerThread );
+
+		for ( int key{ 0 }; key < numThreads * itemsPerThread; ++key )
+		{
+			auto result = cache.tryGet( key );
+			ASSERT_TRUE( result.has_value() );
+			EXPECT_EQ( result->get(), "value_" + std::to_string( key ) );
+		}
+	}
+} // namespace nfx::memory::test
@@ -0,0 +1,133 @@
+/**
+ * @file TESTS_SlabAllocator.cpp
+ * @brief Tests for the SlabArena and SlabAllocator node allocator
+ * @details Tests covering block recycling, pool sharing across rebinds, array fallback,
+ *          slab growth and huge page slab sizing
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nfx/memory/SlabAllocator.h>
+
+namespace nfx::memory::test
+{
+	//=====================================================================
+	// SlabAllocator Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Arena
+	//----------------------------------------------
+
+	TEST( SlabArena, FreedBlockIsReusedFirst )
+	{
+		SlabArena arena;
+		auto* pool{ arena.pool( 40, 8 ) };
+		ASSERT_NE( pool, nullptr );
+		EXPECT_EQ( pool->blockSize, 40 );
+
+		auto* first{ arena.allocate( *pool ) };
+		auto* second{ arena.allocate( *pool ) };
+		EXPECT_NE( first, second );
+
+		arena.deallocate( *pool, first );
+		EXPECT_EQ( arena.allocate( *pool ), first );
+		EXPECT_EQ( arena.slabCount(), 1 );
+	}
+
+	TEST( SlabArena, PoolsSharedBySize )
+	{
+		SlabArena arena;
+
+		EXPECT_EQ( arena.pool( 24, 8 ), arena.pool( 24, 8 ) );
+		EXPECT_NE( arena.pool( 24, 8 ), arena.pool( 32, 8 ) );
+		EXPECT_EQ( arena.findPool( 48, 8 ), nullptr );
+
+		// Blocks too large for a slab are not pooled
+		EXPECT_EQ( arena.pool( arena.slabSize(), 8 ), nullptr );
+	}
+
+	TEST( SlabArena, GrowsBySlabs )
+	{
+		SlabArena arena{ 4096 };
+		auto* pool{ arena.pool( 64, 8 ) };
+		ASSERT_NE( pool, nullptr );
+
+		std::set<void*> blocks;
+		for ( int i{ 0 }; i < 200; ++i )
+		{
+			blocks.insert( arena.allocate( *pool ) );
+		}
+
+		EXPECT_EQ( blocks.size(), 200 );
+		EXPECT_EQ( arena.slabCount(), 4 ); // 64 blocks of 64 bytes per 4 KiB slab
+	}
+
+	TEST( SlabArena, HugePageSlabsRoundedToHugePageSize )
+	{
+		SlabArena arena{ 4096, true };
+		EXPECT_EQ( arena.slabSize(), SlabArena::HUGE_PAGE_SIZE );
+
+		auto* pool{ arena.pool( 32, 8 ) };
+		ASSERT_NE( pool, nullptr );
+		auto* block{ arena.allocate( *pool ) };
+		EXPECT_EQ( reinterpret_cast<std::uintptr_t>( block ) % SlabArena::HUGE_PAGE_SIZE, 0 );
+	}
+
+	//----------------------------------------------
+	// Allocator
+	//----------------------------------------------
+
+	TEST( SlabAllocator, RebindSharesArena )
+	{
+		SlabAllocator<int> ints;
+		SlabAllocator<double> doubles{ ints };
+
+		EXPECT_EQ( ints.arena(), doubles.arena() );
+		EXPECT_TRUE( ints == doubles );
+		EXPECT_FALSE( ints == SlabAllocator<int>{} );
+	}
+
+	TEST( SlabAllocator, SingleObjectsRecycledAcrossCopies )
+	{
+		SlabAllocator<std::uint64_t> allocator;
+		auto copy{ allocator };
+
+		auto* value{ allocator.allocate( 1 ) };
+		copy.deallocate( value, 1 );
+		EXPECT_EQ( copy.allocate( 1 ), value );
+
+		// Arrays bypass the arena
+		auto* array{ allocator.allocate( 16 ) };
+		allocator.deallocate( array, 16 );
+		EXPECT_EQ( allocator.arena()->slabCount(), 1 );
+	}
+
+	TEST( SlabAllocator, WorksWithStandardContainers )
+	{
+		std::unordered_map<int, std::string, std::hash<int>, std::equal_to<int>, SlabAllocator<std::pair<const int, std::string>>> map;
+		std::list<int, SlabAllocator<int>> list;
+
+		for ( int i{ 0 }; i < 10000; ++i )
+		{
+			map.emplace( i, std::to_string( i ) );
+			list.push_back( i );
+		}
+		for ( int i{ 0 }; i < 10000; i += 2 )
+		{
+			map.erase( i );
+		}
+
+		EXPECT_EQ( map.size(), 5000 );
+		EXPECT_EQ( map.at( 9999 ), "9999" );
+		EXPECT_EQ( list.size(), 10000 );
+	}
+} // namespace nfx::memory::test
@@ -0,0 +1,172 @@
+/**
+ * @file TESTS_TimerWheel.cpp
+ * @brief Tests for the TimerWheel hierarchical expiry index
+ * @details Tests covering due buckets, cascading from coarse levels, overflow deadlines,
+ *          descheduling and rescheduling
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <set>
+#include <vector>
+
+#include <nfx/memory/TimerWheel.h>
+
+namespace nfx::memory::test
+{
+	using namespace std::chrono_literals;
+
+	/** @brief Minimal intrusive entry carrying its own deadline */
+	struct TimerEntry
+	{
+		int id{ 0 };
+		std::chrono::steady_clock::time_point deadline;
+		TimerEntry* timerNext{ nullptr };
+		TimerEntry** timerPrevNext{ nullptr };
+	};
+
+	/** @brief Advance a wheel and collect the entries whose deadline passed, re-filing the others */
+	static std::set<int> advanceAndCollect( TimerWheel<TimerEntry>& wheel, std::chrono::steady_clock::time_point now )
+	{
+		std::set<int> due;
+		wheel.advance( now, [&]( TimerEntry* entry ) {
+			if ( entry->deadline <= now )
+			{
+				due.insert( entry->id );
+			}
+			else
+			{
+				wheel.schedule( entry, entry->deadline );
+			}
+		} );
+
+		return due;
+	}
+
+	//=====================================================================
+	// TimerWheel Tests
+	//=====================================================================
+
+	//----------------------------------------------
+	// Expiration
+	//----------------------------------------------
+
+	TEST( TimerWheel, HandsOverOnlyDueEntries )
+	{
+		const auto start{ std::chrono::steady_clock::now() };
+		TimerWheel<TimerEntry> wheel{ start };
+
+		std::vector<TimerEntry> entries( 4 );
+		const std::chrono::milliseconds delays[]{ 5ms, 50ms, 2s, 10min };
+		for ( int i{ 0 }; i < 4; ++i )
+		{
+			entries[i].id = i;
+			entries[i].deadline = start + delays[i];
+			wheel.schedule( &entries[i], entries[i].deadline );
+		}
+
+		EXPECT_TRUE( advanceAndCollect( wheel, start + 1ms ).empty() );
+		EXPECT_EQ( advanceAndCollect( wheel, start + 10ms ), std::set<int>{ 0 } );
+		EXPECT_EQ( advanceAndCollect( wheel, start + 60ms ), std::set<int>{ 1 } );
+
+		// Cascades from the 1 s and 69 s levels down to the finest one
+		EXPECT_TRUE( advanceAndCollect( wheel, start + 1900ms ).empty() );
+		EXPECT_EQ( advanceAndCollect( wheel, start + 2100ms ), std::set<int>{ 2 } );
+		EXPECT_TRUE( advanceAndCollect( wheel, start + 9min ).empty() );
+		EXPECT_EQ( advanceAndCollect( wheel, start + 10min + 1ms ), std::set<int>{ 3 } );
+	}
+
+	TEST( TimerWheel, PastDeadlineDueOnNextAdvance )
+	{
+		const auto start{ std::chrono::steady_clock::now() };
+		TimerWheel<TimerEntry> wheel{ start };
+
+		TimerEntry entry{ 7, start - 1s };
+		wheel.schedule( &entry, entry.deadline );
+
+		// Same time as the wheel, the current bucket is still visited
+		EXPECT_EQ( advanceAndCollect( wheel, start ), std::set<int>{ 7 } );
+		EXPECT_EQ( entry.timerPrevNext, nullptr );
+	}
+
+	TEST( TimerWheel, OverflowDeadlines )
+	{
+		const auto start{ std::chrono::steady_clock::now() };
+		TimerWheel<TimerEntry> wheel{ start };
+
+		TimerEntry entry{ 1, start + std::chrono::hours{ 24 * 30 } };
+		wheel.schedule( &entry, entry.deadline );
+
+		EXPECT_TRUE( advanceAndCollect( wheel, start + std::chrono::hours{ 24 * 29 } ).empty() );
+		EXPECT_TRUE( advanceAndCollect( wheel, start + std::chrono::hours{ 24 * 30 } - 1min ).empty() );
+		EXPECT_EQ( advanceAndCollect( wheel, start + std::chrono::hours{ 24 * 30 } + 1ms ), std::set<int>{ 1 } );
+
+		TimerEntry never{ 2, std::chrono::steady_clock::time_point::max() };
+		wheel.schedule( &never, never.deadline );
+		EXPECT_TRUE( advanceAndCollect( wheel, start + std::chrono::hours{ 24 * 365 } ).empty() );
+	}
+
+	TEST( TimerWheel, BudgetedAdvanceResumes )
+	{
+		const auto start{ std::chrono::steady_clock::now() };
+		TimerWheel<TimerEntry> wheel{ start };
+
+		std::vector<TimerEntry> entries( 10 );
+		for ( int i{ 0 }; i < 10; ++i )
+		{
+			entries[i].id = i;
+			entries[i].deadline = start + std::chrono::milliseconds{ 5 + i * 20 };
+			wheel.schedule( &entries[i], entries[i].deadline );
+		}
+
+		const auto now{ start + 1s };
+		int visited{ 0 };
+		auto onDue{ [&]( TimerEntry* ) { ++visited; } };
+
+		EXPECT_FALSE( wheel.advance( now, onDue, 3 ) );
+		EXPECT_EQ( visited, 3 );
+		EXPECT_TRUE( wheel.isAdvancing() );
+
+		// Entries descheduled while the advance is interrupted are not handed over
+		wheel.deschedule( &entries[9] );
+
+		EXPECT_FALSE( wheel.advance( now, onDue, 3 ) );
+		EXPECT_TRUE( wheel.advance( now, onDue, 3 ) );
+		EXPECT_EQ( visited, 9 );
+		EXPECT_FALSE( wheel.isAdvancing() );
+	}
+
+	//----------------------------------------------
+	// Scheduling
+	//----------------------------------------------
+
+	TEST( TimerWheel, DescheduleAndReschedule )
+	{
+		const auto start{ std::chrono::steady_clock::now() };
+		TimerWheel<TimerEntry> wheel{ start };
+
+		std::vector<TimerEntry> entries( 3 );
+		for ( int i{ 0 }; i < 3; ++i )
+		{
+			entries[i].id = i;
+			entries[i].deadline = start + 5ms;
+			wheel.schedule( &entries[i], entries[i].deadline );
+		}
+
+		// Unlinking the middle entry of a bucket keeps its neighbours linked
+		wheel.deschedule( &entries[1] );
+		EXPECT_EQ( entries[1].timerPrevNext, nullptr );
+		wheel.deschedule( &entries[1] );
+
+		entries[2].deadline = start + 5s;
+		wheel.schedule( &entries[2], entries[2].deadline );
+
+		EXPECT_EQ( advanceAndCollect( wheel, start + 10ms ), std::set<int>{ 0 } );
+		EXPECT_EQ( advanceAndCollect( wheel, start + 6s ), std::set<int>{ 2 } );
+
+		wheel.schedule( &entries[0], start + 7s );
+		wheel.clear();
+		EXPECT_TRUE( advanceAndCollect( wheel, start + 8s ).empty() );
+	}
+} // namespace nfx::memory::test